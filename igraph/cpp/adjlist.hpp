@@ -44,6 +44,65 @@ namespace igraph {
 		friend class Graph;
 	};
 	MEMORY_MANAGER_INTERFACE_EX_NO_COPYING(AdjacencyList);
+	
+	/**
+	 \class FlatAdjacencyList
+	 \brief An adjacency list in two arrays.
+	 
+	 AdjacencyList allocates one vector per vertex. A FlatAdjacencyList keeps
+	 the neighbors of all vertices in one array, with the neighbors of v at
+	 positions offsets[v] to offsets[v+1]-1, so building it takes two
+	 allocations however many vertices there are.
+	 
+	 The rows have the same contents as those of AdjacencyList, and are sorted.
+	 If the arrays cannot be allocated and exceptions are disabled, the list
+	 is left with no vertices.
+	 */
+	class FlatAdjacencyList {
+		Integer vertex_count;
+		long* offset_array;
+		Vertex* neighbor_array;
+		
+		FlatAdjacencyList(const Integer size, const long neighbor_count) MAY_THROW_EXCEPTION;
+		int allocate(const Integer size, const long neighbor_count) throw();
+		
+	public:
+		MEMORY_MANAGER_INTERFACE_NO_COPYING(FlatAdjacencyList);
+		
+		/**
+		 \brief The neighbors of every vertex of the graph.
+		 
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		explicit FlatAdjacencyList(const Graph& g, NeighboringMode mode = OutNeighbors) MAY_THROW_EXCEPTION;
+		/**
+		 \brief The vertices not adjacent to each vertex of the graph.
+		 
+		 - \b Complexity: O(|V|^2)
+		 */
+		static ::tempobj::temporary_class<FlatAdjacencyList>::type complementer(const Graph& g, NeighboringMode mode = OutNeighbors, SelfLoops loop = NoSelfLoops) MAY_THROW_EXCEPTION;
+		
+		/// The neighbors of v, as a vector viewing the list. It must not outlive the list.
+		::tempobj::temporary_class<Vector>::type operator[] (const Vertex v) const throw();
+		const Vertex* begin(const Vertex v) const throw() { return neighbor_array + offset_array[static_cast<long>(v)]; }
+		const Vertex* end(const Vertex v) const throw() { return neighbor_array + offset_array[static_cast<long>(v)+1]; }
+		long degree(const Vertex v) const throw() { return offset_array[static_cast<long>(v)+1] - offset_array[static_cast<long>(v)]; }
+		
+		Integer size() const throw() { return vertex_count; }
+		/// Total number of neighbors in all rows.
+		long neighbor_count() const throw() { return offset_array == NULL ? 0 : offset_array[static_cast<long>(vertex_count)]; }
+		const long* offsets() const throw() { return offset_array; }
+		const Vertex* neighbors() const throw() { return neighbor_array; }
+		
+		FlatAdjacencyList& sort() throw();
+		/**
+		 \brief Remove self-loops and repeated neighbors, in place.
+		 
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		FlatAdjacencyList& simplify();
+	};
+	MEMORY_MANAGER_INTERFACE_EX_NO_COPYING(FlatAdjacencyList);
 }
 
 #endif
@@ -44,7 +44,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 #include <igraph/igraph.h>
+#include <cctype>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
 
 namespace igraph {
 	
@@ -128,27 +132,127 @@ template<> struct XX_ERROR___##templname##_can_only_store_Real__long__Boolean_or
 	template<> void XXINTRNL_fprintf<char>(::std::FILE* f, const char input) throw() { ::std::fprintf(f, "%d", input); }	// this is for compatibility of igraph.
 	template<> void XXINTRNL_fprintf<Boolean>(::std::FILE* f, const Boolean input) throw() { ::std::fprintf(f, "%d", input); }
 	
-#define XXINTRNL_DEFINE_SSCANF(type, intem_type, format) \
-template<> bool XXINTRNL_sscanf(const char*& str_io, type& res) throw() { \
-	int n; \
-	intem_type r; \
-	if(::std::sscanf(str_io, format " %n", &r, &n)) { \
-		res = static_cast<type>(r); \
-		str_io += n; \
-		return true; \
-	} else { \
-		str_io += 1; \
-		return false; \
-	} \
-}
+	/// Whether a number of type T may start with the character c.
+	template<typename T> bool XXINTRNL_may_start_number(const char c) throw() {
+		return (c >= '0' && c <= '9') || c == '-' || c == '+';
+	}
+	template<> bool XXINTRNL_may_start_number<Real>(const char c) throw() {
+		return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'i' || c == 'I' || c == 'n' || c == 'N';
+	}
+	
+	/// Parse a number at str, with the same syntax as sscanf(). Return the end of the number, or str if there is none.
+	template<typename T> const char* XXINTRNL_parse_number(const char* str, T& res) throw() {
+		char* end;
+		res = static_cast<T>(static_cast<int>(::std::strtol(str, &end, 10)));	// sscanf("%d") for char and Boolean.
+		return end;
+	}
+	template<> const char* XXINTRNL_parse_number<long>(const char* str, long& res) throw() {
+		char* end;
+		res = ::std::strtol(str, &end, 10);
+		return end;
+	}
+	template<> const char* XXINTRNL_parse_number<Real>(const char* str, Real& res) throw() {
+		char* end;
+		res = ::std::strtod(str, &end);
+		// sscanf() also consumes an incomplete exponent, such as the "e+" of "1e+x".
+		if (*end == 'e' || *end == 'E') {
+			const char* p = str;
+			while (p != end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == '-' || *p == '+'))
+				++ p;
+			if (p == end && end != str) {
+				++ end;
+				if (*end == '+' || *end == '-')
+					++ end;
+			}
+		}
+		return end;
+	}
+	
+	/**
+	 \brief Single-pass scanner for the numbers in a string.
+	 
+	 Anything that is not a number is a separator, so "1 2 3" and
+	 "1 birds 2 geese 3 cats" give the same numbers. Runs of separators are
+	 skipped without trying to parse them, and numbers are parsed with
+	 strtol() and strtod(), which (unlike sscanf()) never scan the rest of the
+	 string. The results are the same as parsing with sscanf("%lg %n") and
+	 skipping one character whenever that fails.
+	 
+	 If a row separator is given, next() also reports each occurrence of it
+	 outside a number.
+	 */
+	template<typename T>
+	class XXINTRNL_NumberScanner {
+		const char* cursor;
+		const char* row_separator;
+		::std::size_t row_separator_length;
+		
+	public:
+		enum Token {
+			Token_End,
+			Token_Number,
+			Token_RowSeparator
+		};
+		
+		explicit XXINTRNL_NumberScanner(const char* str, const char* row_separator_ = NULL) throw()
+			: cursor(str), row_separator(row_separator_), row_separator_length(row_separator_ != NULL ? ::std::strlen(row_separator_) : 0) {}
+		
+		/// An upper bound of the number of numbers (except "inf" and "nan"), for reserving the storage.
+		long count_estimate() const throw() {
+			long count = 0;
+			bool in_digits = false;
+			for (const char* p = cursor; *p != '\0'; ++ p) {
+				bool is_digit = *p >= '0' && *p <= '9';
+				if (is_digit && !in_digits)
+					++ count;
+				in_digits = is_digit;
+			}
+			return count;
+		}
+		
+		Token next(T& res) throw() {
+			while (*cursor != '\0') {
+				// like sscanf(), skip the whitespace before a number.
+				const char* start = cursor;
+				while (::std::isspace(static_cast<unsigned char>(*start)))
+					++ start;
+				if (XXINTRNL_may_start_number<T>(*start)) {
+					const char* end = XXINTRNL_parse_number(start, res);
+					if (end != start) {
+						// like the " " in sscanf("%lg %n").
+						cursor = end;
+						while (::std::isspace(static_cast<unsigned char>(*cursor)))
+							++ cursor;
+						return Token_Number;
+					}
+				}
+				// no number here, so skip up to and including start, looking for the row separator.
+				for (; cursor <= start && *cursor != '\0'; ++ cursor)
+					if (row_separator != NULL && ::std::strncmp(cursor, row_separator, row_separator_length) == 0) {
+						cursor += row_separator_length > 0 ? row_separator_length : 1;
+						return Token_RowSeparator;
+					}
+			}
+			return Token_End;
+		}
+	};
+	
+	static inline bool XXINTRNL_is_little_endian() throw() {
+		const uint16_t x = 1;
+		return *reinterpret_cast<const unsigned char*>(&x) == 1;
+	}
 	
-	template<typename T> bool XXINTRNL_sscanf(const char*& str_io, T& res) throw();
-	XXINTRNL_DEFINE_SSCANF(Real, double, "%lg");
-	XXINTRNL_DEFINE_SSCANF(long, long, "%ld");
-	XXINTRNL_DEFINE_SSCANF(char, int, "%d");
-	XXINTRNL_DEFINE_SSCANF(Boolean, int, "%d");
+	static inline void XXINTRNL_store_le(unsigned char* dest, uint64_t value, const unsigned width) throw() {
+		for (unsigned i = 0; i < width; ++ i)
+			dest[i] = static_cast<unsigned char>(value >> (8*i));
+	}
 	
-#undef XXINTRNL_DEFINE_SSCANF
+	static inline uint64_t XXINTRNL_load_le(const unsigned char* src, const unsigned width) throw() {
+		uint64_t value = 0;
+		for (unsigned i = 0; i < width; ++ i)
+			value |= static_cast<uint64_t>(src[i]) << (8*i);
+		return value;
+	}
 	
 	void XXINTRNL_nop(__attribute__((unused)) const void* x, ...) {};
 	
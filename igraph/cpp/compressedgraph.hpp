@@ -0,0 +1,198 @@
+/*
+
+compressedgraph.hpp ... Read-only graphs with gap-encoded adjacency lists.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_COMPRESSEDGRAPH_HPP
+#define IGRAPH_COMPRESSEDGRAPH_HPP
+
+#include <igraph/igraph.h>
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/exception.hpp>
+#include <igraph/cpp/idvector.hpp>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace igraph {
+	class Graph;
+	class EdgeStream;
+
+	/**
+	 \class CompressedGraph
+	 \brief A read-only graph whose adjacency lists are gap-encoded varints.
+
+	 igraph keeps four doubles per edge (from, to, oi, ii), 32 bytes in all.
+	 A CompressedGraph keeps, for each vertex, its sorted neighbors as a
+	 varint of the degree, the varint of the zigzag-encoded distance from the
+	 vertex to the first neighbor, then the varints of the gaps between
+	 consecutive neighbors. A varint stores 7 bits per byte, so graphs whose
+	 neighbors have nearby IDs (see Graph::reorder_for_locality()) need one
+	 or two bytes per neighbor. There are 8 more bytes per vertex for the
+	 position of its list.
+
+	 Only one list is kept per vertex, chosen by the NeighboringMode, as in
+	 FlatAdjacencyList: the out-neighbors, the in-neighbors, or both. For
+	 undirected graphs the list always has all neighbors, so every edge is
+	 stored twice.
+
+	 Neighbors are decoded while iterating. degree() decodes only the first
+	 varint. bfs_distances() and cluster() run directly on the lists and
+	 return IdVectors, so that the results are as compact as the graph.
+
+	 \code
+	 EdgeStream stream ("huge.edges.gz");
+	 CompressedGraph cg (stream, Undirected);
+	 printf("%.2f bytes per edge\n", cg.bytes_per_edge());
+	 for (long v = 0; v < cg.size(); ++ v) {
+	     CompressedGraph::Range nei = cg.neighbors(v);
+	     for (CompressedGraph::iterator it = nei.begin(); it != nei.end(); ++ it)
+	         visit(v, *it);
+	 }
+	 \endcode
+	 */
+	class CompressedGraph {
+	public:
+		/// Decodes one adjacency list while walking over it.
+		class iterator {
+		private:
+			const unsigned char* position;
+			long remaining;	// including the current neighbor.
+			long current;
+
+		public:
+			typedef ::std::forward_iterator_tag iterator_category;
+			typedef long value_type;
+			typedef long difference_type;
+			typedef const long* pointer;
+			typedef long reference;
+
+			iterator() throw() : position(NULL), remaining(0), current(0) {}
+			iterator(const unsigned char* first_gap, const long count, const long vertex) throw();
+
+			long operator*() const throw() { return current; }
+			iterator& operator++() throw();
+			iterator operator++(int) throw() { iterator res = *this; ++ *this; return res; }
+
+			// only iterators of the same list may be compared.
+			bool operator==(const iterator& other) const throw() { return remaining == other.remaining; }
+			bool operator!=(const iterator& other) const throw() { return remaining != other.remaining; }
+		};
+		typedef iterator const_iterator;
+
+		/// The neighbors of one vertex, in increasing order.
+		class Range {
+		public:
+			typedef CompressedGraph::iterator iterator;
+			typedef CompressedGraph::iterator const_iterator;
+
+		private:
+			iterator first;
+			long count;
+
+		public:
+			Range(const iterator& first_, const long count_) throw() : first(first_), count(count_) {}
+
+			iterator begin() const throw() { return first; }
+			iterator end() const throw() { return iterator(); }
+			long size() const throw() { return count; }
+			bool empty() const throw() { return count == 0; }
+		};
+
+	private:
+		long vertex_count;
+		long edge_count;
+		long entry_count;	// the number of neighbors in all lists.
+		bool directed;
+		NeighboringMode mode;
+		::std::vector<uint64_t> offset_array;	// byte position of each list, plus the end.
+		::std::vector<unsigned char> data;
+
+		CompressedGraph(const long size, const Directedness directedness, const NeighboringMode lists) throw();
+
+		template <typename Source>
+		void encode(Source& source);
+
+	public:
+		/**
+		 \brief Compress the lists of a graph.
+
+		 - \b Complexity: O(|V|+|E|), or O(|V|+|E| log d) for AllNeighbors on a directed graph.
+		 */
+		explicit CompressedGraph(const Graph& g, const NeighboringMode lists = OutNeighbors);
+
+		/**
+		 \brief Compress the edges of a stream, without building a Graph.
+
+		 The edges are read \p chunk_size at a time, and each chunk is sorted
+		 and compressed. The compressed chunks are then merged vertex by
+		 vertex. Besides the result, the memory used is the compressed chunks
+		 plus 16 bytes for every entry of a chunk. Edges with a negative vertex
+		 ID are dropped.
+
+		 - \b Complexity: O(|E| log \p chunk_size + |V| k), where k is the number of chunks.
+		 */
+		CompressedGraph(EdgeStream& stream, const Directedness directedness = Undirected, const NeighboringMode lists = OutNeighbors, const long chunk_size = 1 << 22);
+
+		long size() const throw() { return vertex_count; }
+		long edges() const throw() { return edge_count; }
+		Directedness is_directed() const throw() { return directed ? Directed : Undirected; }
+		/// Which neighbors are listed, always AllNeighbors for undirected graphs.
+		NeighboringMode lists() const throw() { return mode; }
+
+		/// The number of listed neighbors of v, in O(1).
+		long degree(const long v) const throw();
+		/// The listed neighbors of v, decoded while iterating.
+		Range neighbors(const long v) const throw();
+		/// Decode all listed neighbors of v at once.
+		template <typename T>
+		void neighbors(const long v, IdVector<T>& res) const;
+
+		/**
+		 \brief The number of edges on the shortest path from \p source to each vertex, following the lists.
+
+		 Unreachable vertices get -1.
+
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		template <typename T>
+		void bfs_distances(const long source, IdVector<T>& distance) const MAY_THROW_EXCEPTION;
+
+		/**
+		 \brief The weakly connected components, as Graph::cluster().
+
+		 Components are numbered in the order of their smallest vertex ID, as
+		 in igraph. Any NeighboringMode of the lists finds the same components.
+
+		 \return The number of components.
+
+		 - \b Complexity: O((|V|+|E|) a(|V|)), with union-find.
+		 */
+		template <typename T>
+		long cluster(IdVector<T>& membership, IdVector<T>& csize) const;
+		long cluster_count() const;
+
+		/// The memory used by the lists and their positions.
+		::std::size_t bytes() const throw() { return data.size() + offset_array.size() * sizeof(uint64_t); }
+		/// bytes() divided by the number of edges.
+		double bytes_per_edge() const throw() { return edge_count > 0 ? static_cast<double>(bytes()) / edge_count : 0; }
+	};
+}
+
+#endif
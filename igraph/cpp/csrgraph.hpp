@@ -0,0 +1,141 @@
+/*
+
+csrgraph.hpp ... Immutable compressed sparse row snapshot of a graph.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_CSRGRAPH_HPP
+#define IGRAPH_CSRGRAPH_HPP
+
+#include <igraph/igraph.h>
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/exception.hpp>
+
+namespace igraph {
+	class Graph;
+
+	/**
+	 \class CsrGraph
+	 \brief A read-only snapshot of a graph in compressed sparse row form.
+
+	 The neighbors of vertex v are targets[offsets[v]] to
+	 targets[offsets[v+1]-1], and the IDs of the corresponding edges are at
+	 the same positions of the edge array. There is one such set of arrays
+	 for the out-neighbors and one for the in-neighbors. For undirected
+	 graphs the two are the same arrays, listing every neighbor (a self-loop
+	 appears twice).
+
+	 The neighbors of each vertex are in the same order as
+	 Graph::neighbors(), and iterating over them allocates nothing.
+
+	 The snapshot only holds these arrays, not a copy of the graph, so the
+	 original can be modified or destroyed afterwards. Use graph() to rebuild
+	 a Graph from the snapshot for the Graph analytics.
+
+	 \code
+	 CsrGraph csr = g.freeze();
+	 for (long v = 0; v < csr.size(); ++ v) {
+	     CsrGraph::Range nei = csr.out_neighbors(v);
+	     for (const long* p = nei.begin(); p != nei.end(); ++ p)
+	         visit(v, *p);
+	 }
+	 Vector bc = csr.graph().betweenness(VertexSelector::all());
+	 \endcode
+	 */
+	class CsrGraph {
+	public:
+		/// A contiguous range of vertex or edge IDs inside a CsrGraph.
+		class Range {
+			const long* first;
+			const long* last;
+		public:
+			typedef const long* iterator;
+			typedef const long* const_iterator;
+
+			Range(const long* first_, const long* last_) throw() : first(first_), last(last_) {}
+
+			const long* begin() const throw() { return first; }
+			const long* end() const throw() { return last; }
+			long size() const throw() { return last - first; }
+			bool empty() const throw() { return first == last; }
+			long operator[](const long index) const throw() { return first[index]; }
+		};
+
+	private:
+		long vertex_count;
+		long edge_count;
+		bool directed;
+		long* storage;	// all arrays below live in this block.
+		long* out_offset_array;
+		long* out_target_array;
+		long* out_edge_array;
+		long* in_offset_array;
+		long* in_target_array;
+		long* in_edge_array;
+
+		void build_directed(const igraph_t* graph) throw();
+		void build_undirected(const igraph_t* graph) throw();
+
+	public:
+		MEMORY_MANAGER_INTERFACE_NO_COPYING(CsrGraph);
+
+		/**
+		 \brief Take a snapshot of the graph.
+
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		explicit CsrGraph(const Graph& g);
+
+		long size() const throw() { return vertex_count; }
+		long edges() const throw() { return edge_count; }
+		Directedness is_directed() const throw() { return directed ? Directed : Undirected; }
+
+		/// The vertices at the end of the out-edges of v.
+		Range out_neighbors(const long v) const throw() { return Range(out_target_array + out_offset_array[v], out_target_array + out_offset_array[v+1]); }
+		/// The vertices at the start of the in-edges of v.
+		Range in_neighbors(const long v) const throw() { return Range(in_target_array + in_offset_array[v], in_target_array + in_offset_array[v+1]); }
+		/// The IDs of the out-edges of v, in the same order as out_neighbors().
+		Range out_edges(const long v) const throw() { return Range(out_edge_array + out_offset_array[v], out_edge_array + out_offset_array[v+1]); }
+		/// The IDs of the in-edges of v, in the same order as in_neighbors().
+		Range in_edges(const long v) const throw() { return Range(in_edge_array + in_offset_array[v], in_edge_array + in_offset_array[v+1]); }
+
+		long out_degree(const long v) const throw() { return out_offset_array[v+1] - out_offset_array[v]; }
+		long in_degree(const long v) const throw() { return in_offset_array[v+1] - in_offset_array[v]; }
+
+		/// The raw arrays, for loops which walk over all vertices.
+		const long* out_offsets() const throw() { return out_offset_array; }
+		const long* out_targets() const throw() { return out_target_array; }
+		const long* in_offsets() const throw() { return in_offset_array; }
+		const long* in_targets() const throw() { return in_target_array; }
+
+		/**
+		 \brief Rebuild the snapshot as a Graph, to run the Graph analytics on.
+
+		 The edges keep their IDs. The result is a new graph, independent of the
+		 snapshot, so call this once and keep the result rather than calling it
+		 in a loop.
+
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		::tempobj::temporary_class<Graph>::type graph() const MAY_THROW_EXCEPTION;
+	};
+
+	MEMORY_MANAGER_INTERFACE_EX_NO_COPYING(CsrGraph);
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+
+edgeindex.hpp ... Hash table from vertex pairs to edge IDs.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_EDGEINDEX_HPP
+#define IGRAPH_EDGEINDEX_HPP
+
+#include <igraph/igraph.h>
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/exception.hpp>
+#include <igraph/cpp/vector.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace igraph {
+	class Graph;
+
+	/**
+	 \class EdgeIndex
+	 \brief A hash table from (from, to) pairs to edge IDs.
+
+	 Graph::get_eid() and Graph::are_connected() binary-search igraph's index
+	 and report a missing edge as an error. An EdgeIndex answers the same
+	 questions in O(1) expected time with an open-addressing table of 16-byte
+	 slots, and reports a missing edge as -1.
+
+	 For multigraphs the smallest ID of the parallel edges is returned.
+
+	 The index refers to the graph it is built from, which must outlive it.
+	 It does not follow changes of the graph. Call refresh() after adding or
+	 deleting edges or vertices, or rebuild() after changes which keep the
+	 number of edges, like Graph::rewire_edges_simple().
+
+	 \code
+	 EdgeIndex index (g);
+	 for (long i = 0; i < candidates.size(); i += 2)
+	     if (!index.are_connected(candidates[i], candidates[i+1]))
+	         propose(candidates[i], candidates[i+1]);
+	 \endcode
+	 */
+	class EdgeIndex {
+	private:
+		struct Slot {
+			int64_t key;	// -1 if empty.
+			long eid;
+		};
+
+		const igraph_t* graph;
+		long vertex_count;
+		long edge_count;
+		bool directed;
+		::std::vector<Slot> slots;
+		::std::size_t mask;
+
+		long find(const long from, const long to) const throw();
+
+	public:
+		/**
+		 \brief Index all edges of the graph.
+
+		 - \b Complexity: O(|V|+|E|) expected.
+		 */
+		explicit EdgeIndex(const Graph& g);
+
+		/// Index the graph again, from scratch.
+		void rebuild();
+		/// Whether the number of vertices or edges of the graph has changed since the index was built.
+		bool is_stale() const throw();
+		/// Rebuild if is_stale().
+		void refresh() { if (is_stale()) rebuild(); }
+
+		/**
+		 \brief The ID of an edge between two vertices, or -1 if there is none.
+
+		 Same as Graph::get_eid(), including ignoring the direction of the
+		 edges by default.
+
+		 - \b Complexity: O(1) expected.
+		 */
+		Edge get_eid(const Vertex from, const Vertex to, const Directedness arc = Undirected) const throw();
+
+		/// Whether there is an edge from \p from to \p to, as Graph::are_connected().
+		bool are_connected(const Vertex from, const Vertex to) const throw() { return get_eid(from, to, Directed) >= 0; }
+
+		/**
+		 \brief Look up many (from, to) pairs at once.
+
+		 \return The edge ID for each pair, or -1 if the pair is not connected.
+		         An unpaired last ID is ignored.
+		 */
+		::tempobj::force_temporary_class<EdgeVector>::type lookup(const VertexVector& pairs, const Directedness arc = Undirected) const MAY_THROW_EXCEPTION;
+	};
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*
+
+edgestream.hpp ... Streaming, bounded-memory edge ingestion.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_EDGESTREAM_HPP
+#define IGRAPH_EDGESTREAM_HPP
+
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/exception.hpp>
+#include <igraph/cpp/vector.hpp>
+#include <cstdio>
+#include <cstddef>
+
+namespace igraph {
+	class Graph;
+	
+	/**
+	 \class EdgeStream
+	 \brief Read an edge list in fixed-size batches.
+
+	 The file is read through a fixed-size buffer, so memory use does not
+	 depend on the size of the file. The tokens are the same as
+	 GraphReader::edgelist(), including dropping an unpaired last number.
+
+	 \code
+	 EdgeStream stream ("huge.edges.gz");
+	 VertexVector batch;
+	 while (stream.next(batch))
+	     process(batch);	// batch contains (from, to) pairs.
+	 \endcode
+	 */
+	class EdgeStream {
+	private:
+		::std::FILE* fptr;
+		bool owns_file;
+		char* buffer;
+		::std::size_t buffer_size;
+		const char* cursor;
+		const char* filled;
+		bool at_eof;
+		bool negative;
+		long batch_size;
+
+		void init_buffer();
+		void refill(const ::std::size_t keep) throw();
+
+	public:
+		MEMORY_MANAGER_INTERFACE_NO_COPYING(EdgeStream);
+
+		/**
+		 \param[in] batch_size  Maximum number of edges returned by each call to next().
+		 \param[in] buffer_size Size of the read buffer in bytes.
+		 */
+		explicit EdgeStream(::std::FILE* filestream, const long batch_size = 1 << 16, const ::std::size_t buffer_size = 1 << 20);
+		/// Open a file for reading. Compressed files (see identify_file_compression()) are decompressed through the same fixed-size buffers.
+		explicit EdgeStream(const char* filename, const long batch_size = 1 << 16, const ::std::size_t buffer_size = 1 << 20);
+
+		/**
+		 \brief Read the next batch of edges.
+
+		 The batch is resized to hold 2*k vertex IDs for the k edges read,
+		 reusing its storage across calls.
+
+		 \return Whether any edge is read. false means the end of the stream.
+		 */
+		bool next(VertexVector& batch) MAY_THROW_EXCEPTION;
+
+		/// Call callback(const VertexVector&) on every remaining batch.
+		template <typename F>
+		void for_each_batch(F callback) MAY_THROW_EXCEPTION {
+			VertexVector batch;
+			while (next(batch))
+				callback(static_cast<const VertexVector&>(batch));
+		}
+	};
+
+	/**
+	 \class GraphBuilder
+	 \brief Build a graph by appending edges batch by batch.
+
+	 Edges are appended directly into the edge vectors of the graph under
+	 construction, and the index is built once by build(). Unlike collecting
+	 an edge list and calling Graph(const VertexVector&, ...), the edges are
+	 never stored twice.
+
+	 Edges can be filtered while they are appended. Edges with a negative
+	 vertex ID are always dropped.
+
+	 If an attribute handler is attached, build() passes the edges through
+	 igraph_add_edges() so that the handler sees them. This needs one
+	 temporary copy of the edge list.
+
+	 \code
+	 EdgeStream stream ("huge.edges");
+	 Graph g = GraphBuilder(Directed).drop_self_loops().append(stream).build();
+	 \endcode
+	 */
+	class GraphBuilder {
+	private:
+		igraph_t _;
+		Integer min_size;
+		Integer vertex_count;
+		bool built;
+		bool drop_loops;
+		bool has_range;
+		bool relabel_range;
+		Vertex range_first;
+		Vertex range_last;
+
+		int reserve_edges(const long count) throw();
+
+	public:
+		MEMORY_MANAGER_INTERFACE_NO_COPYING(GraphBuilder);
+
+		/// Start building a graph with at least size vertices.
+		explicit GraphBuilder(const Directedness directedness = Undirected, const Integer size = 0) MAY_THROW_EXCEPTION;
+
+		/// Drop edges from a vertex to itself.
+		GraphBuilder& drop_self_loops(const bool drop = true) throw();
+		/**
+		 \brief Keep only edges whose both endpoints are in [first, last].
+
+		 \param[in] relabel Subtract \p first from every vertex ID, so that the
+		                    graph has only the (last - first + 1) vertices in range.
+		 */
+		GraphBuilder& keep_vertex_range(const Vertex first, const Vertex last, const bool relabel = false) throw();
+
+		/// Append (from, to) pairs. An unpaired last ID is ignored.
+		GraphBuilder& append(const VertexVector& pairs) MAY_THROW_EXCEPTION;
+		GraphBuilder& append(const Vertex* pairs, const long edge_count) MAY_THROW_EXCEPTION;
+		/// Append all remaining batches of the stream.
+		GraphBuilder& append(EdgeStream& stream) MAY_THROW_EXCEPTION;
+
+		/// Number of vertices of the graph if it were built now.
+		Integer vcount() const throw();
+		/// Number of edges appended so far (after filtering).
+		Integer ecount() const throw();
+
+		/**
+		 \brief Index the appended edges and return the graph.
+
+		 The builder must not be used after this call.
+
+		 - \b Complexity: O(|V|+|E|), as igraph_add_edges().
+		 */
+		::tempobj::temporary_class<Graph>::type build() MAY_THROW_EXCEPTION;
+	};
+
+	MEMORY_MANAGER_INTERFACE_EX_NO_COPYING(EdgeStream);
+	MEMORY_MANAGER_INTERFACE_EX_NO_COPYING(GraphBuilder);
+}
+
+#endif
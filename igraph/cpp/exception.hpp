@@ -35,10 +35,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <exception>
 
 #if IGRAPH_DEBUG
-#define TRY(func) { int errcode = (func); if (errcode != IGRAPH_SUCCESS) throw Exception(errcode); }
+#define TRY(func) { int XXINTRNL_errcode = (func); if (XXINTRNL_errcode != IGRAPH_SUCCESS) throw Exception(XXINTRNL_errcode); }
 #define MAY_THROW_EXCEPTION throw(Exception)
 #else
-#define TRY(func) func
+#define TRY(func) static_cast<void>(func)
 #define MAY_THROW_EXCEPTION throw()
 #endif
 
@@ -29,6 +29,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <igraph/cpp/graphio.hpp>
 #include <igraph/cpp/vector.hpp>
 #include <igraph/cpp/referencevector.hpp>
+#include <igraph/cpp/neighborview.hpp>
+#include <igraph/cpp/idvector.hpp>
+#include <igraph/cpp/sparsematrix.hpp>
 #include <igraph/cpp/community.hpp>
 #include <igraph/cpp/mincut.hpp>
 #include <igraph/cpp/arpack.hpp>
@@ -40,6 +43,9 @@ namespace gsl {
 
 namespace igraph {
 	class AdjacencyList;
+	class FlatAdjacencyList;
+	class CsrGraph;
+	class GraphBatch;
 	
 	class Graph {
 	private:
@@ -72,8 +78,33 @@ namespace igraph {
 		::tempobj::force_temporary_class<VertexVector>::type neighbors(const Vertex vid, NeighboringMode neimode = OutNeighbors) const MAY_THROW_EXCEPTION;
 		::tempobj::force_temporary_class<EdgeVector>::type adjacent(const Vertex vid, NeighboringMode neimode = OutNeighbors) const MAY_THROW_EXCEPTION;
 		
+		/**
+		 \brief The neighbors of a vertex, without copying them out of the graph.
+		 
+		 The view must not be used after the graph is changed. See NeighborView.
+		 
+		 - \b Complexity: O(1)
+		 */
+		NeighborView neighbor_view(const Vertex vid, NeighboringMode neimode = OutNeighbors) const throw() { return NeighborView(&_, static_cast<long>(vid), neimode); }
+		/// The IDs of the edges at a vertex, in the same order as neighbor_view(). See IncidentEdgeView.
+		IncidentEdgeView incident_edge_view(const Vertex vid, NeighboringMode neimode = OutNeighbors) const throw() { return IncidentEdgeView(&_, static_cast<long>(vid), neimode); }
+		
+		/**
+		 \brief The neighbors of a vertex as integers, in the same order as neighbors().
+		 
+		 \param[out] res Replaced by the neighbors. Its storage is reused.
+		 
+		 - \b Complexity: O(d)
+		 */
+		template <typename T>
+		void neighbors(const Vertex vid, IdVector<T>& res, NeighboringMode neimode = OutNeighbors) const MAY_THROW_EXCEPTION;
+		/// The incident edges of a vertex as integers, in the same order as adjacent().
+		template <typename T>
+		void adjacent(const Vertex vid, IdVector<T>& res, NeighboringMode neimode = OutNeighbors) const MAY_THROW_EXCEPTION;
+		
 		Directedness is_directed() const throw() { return igraph_is_directed(&_) ? Directed : Undirected; }
 		
+		/// The degree of one vertex. Counting self-loops takes O(1); otherwise O(d).
 		Integer degree_of(Vertex i, NeighboringMode neimode = OutNeighbors, SelfLoops countLoops = ContainSelfLoops) const MAY_THROW_EXCEPTION;
 		__attribute__((deprecated,warning("Graph::degree(Vertex) is deprecated. Use Graph::degree_of(Vertex) instead.")))
 		Integer degree(Vertex i, NeighboringMode neimode = OutNeighbors, SelfLoops countLoops = ContainSelfLoops) const MAY_THROW_EXCEPTION { return degree_of(i, neimode, countLoops); }
@@ -92,6 +123,15 @@ namespace igraph {
 		
 		Graph& delete_vertices(const VertexSelector& vids) MAY_THROW_EXCEPTION;
 		
+		/**
+		 \brief Start queuing edge additions and deletions, to be applied at once.
+		 
+		 Prefer this to calling add_edge() or delete_edge() in a loop, which
+		 re-indexes the whole graph on every call. See GraphBatch for the edge
+		 IDs after the commit. The graph must outlive the batch.
+		 */
+		::tempobj::temporary_class<GraphBatch>::type begin_batch();
+		
 		__attribute__((deprecated,warning("Graph::connect is deprecated. Use Graph::add_edge instead.")))
 		Graph& connect(const Vertex from, const Vertex to) MAY_THROW_EXCEPTION { return add_edge(from, to); }
 		__attribute__((deprecated,warning("Graph::disconnect is deprecated. Use Graph::delete_edge instead.")))
@@ -146,9 +186,23 @@ namespace igraph {
 		};
 		
 		static ::tempobj::force_temporary_class<Graph>::type create(const VertexVector& edges, const Integer min_size = 0, const Directedness directedness = Undirected) MAY_THROW_EXCEPTION;
+		/// Create a graph from (from, to) pairs of integer IDs, without converting them to a VertexVector first.
+		template <typename T>
+		static ::tempobj::force_temporary_class<Graph>::type create(const IdVector<T>& edges, const Integer min_size = 0, const Directedness directedness = Undirected) MAY_THROW_EXCEPTION;
 		static ::tempobj::force_temporary_class<Graph>::type adjacency(Matrix& adjmatrix, AdjacencyMode mode) MAY_THROW_EXCEPTION;
 		static ::tempobj::force_temporary_class<Graph>::type weighted_adjacency(Matrix& adjmatrix, AdjacencyMode mode, const char* attr) MAY_THROW_EXCEPTION;
 		static ::tempobj::force_temporary_class<Graph>::type adjlist(const AdjacencyList& lst, const Directedness directedness = Undirected, const ToUndirectedMode duplicate_edges = ToUndirectedMode_Collapse) MAY_THROW_EXCEPTION;
+		/**
+		 \brief Create a graph from a FlatAdjacencyList, writing the edges straight into the new graph.
+		 
+		 Every neighbor u in the row of v is an edge (v, u). For undirected
+		 graphs with \p duplicate_edges = ToUndirectedMode_Each, every edge is
+		 expected in the rows of both its endpoints (and a self-loop twice in
+		 its row), as in FlatAdjacencyList(g), and is added once.
+		 
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		static ::tempobj::force_temporary_class<Graph>::type adjlist(const FlatAdjacencyList& lst, const Directedness directedness = Undirected, const ToUndirectedMode duplicate_edges = ToUndirectedMode_Collapse) MAY_THROW_EXCEPTION;
 		static ::tempobj::force_temporary_class<Graph>::type star(const Integer n, const StarMode mode = StarMode_Undirected, const Vertex center = 0) MAY_THROW_EXCEPTION;
 		static ::tempobj::force_temporary_class<Graph>::type lattice(const Vector& dimensions, const PeriodicLattice periodic = PeriodicLattice_Periodic, const Integer step = 1, const Directedness directedness = Undirected, const MutualConnections mutual = MutualConnections_NotMutual) MAY_THROW_EXCEPTION;
 		static ::tempobj::force_temporary_class<Graph>::type lattice_2d(const Integer width, const Integer length, const PeriodicLattice periodic = PeriodicLattice_Periodic, const Integer step = 1, const Directedness directedness = Undirected, const MutualConnections mutual = MutualConnections_NotMutual) MAY_THROW_EXCEPTION;
@@ -196,7 +250,15 @@ namespace igraph {
 		// TODO: erdos_renyi_Gnm_game_simple
 		
 		Graph& rewire_edges(const Real prob) MAY_THROW_EXCEPTION;
-		/// Randomly rewire edges and produce a simple graph.
+		/**
+		 \brief Randomly rewire edges and produce a simple graph.
+		 
+		 With probability \p prob, each edge (from, to) is replaced by (from, x),
+		 where x is a uniformly chosen vertex that is neither from nor adjacent
+		 to it. The edge IDs do not change.
+		 
+		 - \b Complexity: O(|V|+|E|) expected, for graphs far from complete.
+		 */
 		Graph& rewire_edges_simple(const Real prob) MAY_THROW_EXCEPTION;
 		Graph& rewire_edges_simple(const ::gsl::Random& rangen, const Real prob) MAY_THROW_EXCEPTION;
 		
@@ -254,6 +316,9 @@ namespace igraph {
 		};
 		
 		::tempobj::force_temporary_class<VertexVector>::type subcomponent(const Vertex representative, const NeighboringMode mode = OutNeighbors) const MAY_THROW_EXCEPTION;
+		/// The vertices reachable from \p representative as integers, in the same order as subcomponent().
+		template <typename T>
+		void subcomponent(const Vertex representative, IdVector<T>& res, const NeighboringMode mode = OutNeighbors) const MAY_THROW_EXCEPTION;
 		::tempobj::force_temporary_class<Graph>::type subgraph(const VertexSelector& vids) const MAY_THROW_EXCEPTION;
 		void cluster(Vector& cluster_id_each_vertex_belongs_to, Vector& size_of_each_cluster, Connectedness connectedness = WeaklyConnected) const MAY_THROW_EXCEPTION;
 		Integer cluster_count(const Connectedness connectedness = WeaklyConnected) const MAY_THROW_EXCEPTION;
@@ -303,6 +368,30 @@ namespace igraph {
 		::tempobj::force_temporary_class<Matrix>::type cocitation(const VertexSelector& vids) const MAY_THROW_EXCEPTION;
 		::tempobj::force_temporary_class<Matrix>::type similarity_jaccard(const VertexSelector& vids, NeighboringMode neimode, SelfLoops countloops) const MAY_THROW_EXCEPTION;
 		::tempobj::force_temporary_class<Matrix>::type similarity_dice(const VertexSelector& vids, NeighboringMode neimode, SelfLoops countloops) const MAY_THROW_EXCEPTION;
+		
+		/**
+		 \brief bibcoupling() as a SparseMatrix, with one row for each vertex of \p vids.
+		 
+		 Only the pairs of vertices which cite a common vertex are stored. An ID
+		 of \p vids which is not a vertex, such as NaN, raises IGRAPH_EINVVID,
+		 and without exceptions gives a matrix of zeros.
+		 
+		 - \b Complexity: O(sum of d_out(v) d_in(w) for v in vids, v->w), with O(|V|) extra memory.
+		 */
+		::tempobj::force_temporary_class<SparseMatrix>::type bibcoupling_sparse(const VertexSelector& vids) const MAY_THROW_EXCEPTION;
+		/// cocitation() as a SparseMatrix, with one row for each vertex of \p vids. See bibcoupling_sparse().
+		::tempobj::force_temporary_class<SparseMatrix>::type cocitation_sparse(const VertexSelector& vids) const MAY_THROW_EXCEPTION;
+		/**
+		 \brief similarity_jaccard() as a SparseMatrix, storing only the pairs of vertices with a common neighbor.
+		 
+		 The diagonal is 1, as in the dense result. IDs are checked as in
+		 bibcoupling_sparse().
+		 
+		 - \b Complexity: O(sum of d(w)^2 over the neighbors w of vids), with O(|V|) extra memory.
+		 */
+		::tempobj::force_temporary_class<SparseMatrix>::type similarity_jaccard_sparse(const VertexSelector& vids, NeighboringMode neimode, SelfLoops countloops) const MAY_THROW_EXCEPTION;
+		/// similarity_dice() as a SparseMatrix. See similarity_jaccard_sparse().
+		::tempobj::force_temporary_class<SparseMatrix>::type similarity_dice_sparse(const VertexSelector& vids, NeighboringMode neimode, SelfLoops countloops) const MAY_THROW_EXCEPTION;
 		::tempobj::force_temporary_class<Matrix>::type similarity_inverse_log_weighted(const VertexSelector& vids, NeighboringMode neimode) const MAY_THROW_EXCEPTION;
 
 
@@ -334,6 +423,11 @@ namespace igraph {
 #pragma mark 10.11 Spectral properties
 
 		::tempobj::force_temporary_class<Matrix>::type laplacian(Boolean normalized = false) const MAY_THROW_EXCEPTION;
+		/**
+		 \brief laplacian() as a SparseMatrix.
+		 - \b Complexity: O(|V| + |E| log d)
+		 */
+		::tempobj::force_temporary_class<SparseMatrix>::type laplacian_sparse(Boolean normalized = false) const MAY_THROW_EXCEPTION;
 
 
 #pragma mark -
@@ -398,7 +492,15 @@ namespace igraph {
 		void avg_nearest_neighbor_degree_both(Vector& knn, Vector& knnk, const VertexSelector& vids, const Vector& weights);
 
 		::tempobj::force_temporary_class<Matrix>::type get_adjacency(GetAdjacency type = GetAdjacency_Both) const MAY_THROW_EXCEPTION;
+		/**
+		 \brief get_adjacency() as a SparseMatrix. Entries are the numbers of edges, as in the dense matrix.
+		 - \b Complexity: O(|V| + |E| log d)
+		 */
+		::tempobj::force_temporary_class<SparseMatrix>::type get_adjacency_sparse(GetAdjacency type = GetAdjacency_Both) const MAY_THROW_EXCEPTION;
 		::tempobj::force_temporary_class<Vector>::type get_edgelist(EdgelistSequenceOrdering bycol = EdgelistSequenceOrdering_Default) const MAY_THROW_EXCEPTION;
+		/// The edge list as integers, in the same layout as get_edgelist().
+		template <typename T>
+		void get_edgelist(IdVector<T>& res, EdgelistSequenceOrdering bycol = EdgelistSequenceOrdering_Default) const MAY_THROW_EXCEPTION;
 
 
 #pragma mark -
@@ -420,6 +522,39 @@ namespace igraph {
 #pragma mark 12. Graph Isomorphism
 		
 		::tempobj::force_temporary_class<Graph>::type permute_vertices(const VertexVector& permutation) const MAY_THROW_EXCEPTION;
+		
+		enum LocalityOrdering {
+			/// Reverse Cuthill-McKee: breadth-first from a low-degree vertex, which keeps the bandwidth small.
+			LocalityOrdering_ReverseCuthillMcKee,
+			/// Vertices of higher degree first, which packs the hubs together.
+			LocalityOrdering_DegreeDescending,
+			/// Gorder: greedily place the vertex sharing the most edges and in-neighbors with the last few vertices placed.
+			LocalityOrdering_Gorder,
+		};
+		
+		/**
+		 \brief Find a vertex order which puts vertices that are used together close to each other.
+		 
+		 The direction of the edges is ignored.
+		 
+		 \param[in] window The number of recently placed vertices Gorder compares against.
+		 \return The permutation to pass to permute_vertices(). Element i is the
+		         new ID of vertex i.
+		 
+		 - \b Complexity: O(|V|+|E| log d) for Reverse Cuthill-McKee, and O(|V|+|E|)
+		   for degree order. Gorder takes O(|V|+|E|+P), where P is the number of
+		   paths of length 2 through vertices of degree at most sqrt(|V|); the
+		   common neighbors through larger hubs are not counted.
+		 */
+		::tempobj::force_temporary_class<VertexVector>::type locality_ordering(LocalityOrdering method = LocalityOrdering_ReverseCuthillMcKee, Integer window = 5) const MAY_THROW_EXCEPTION;
+		
+		/**
+		 \brief Renumber the vertices of this graph by locality_ordering().
+		 
+		 \return The inverse permutation. Element i is the old ID of the vertex
+		         which is now i, for mapping results back to the old IDs.
+		 */
+		::tempobj::force_temporary_class<VertexVector>::type reorder_for_locality(LocalityOrdering method = LocalityOrdering_ReverseCuthillMcKee, Integer window = 5) MAY_THROW_EXCEPTION;
 
 
 #pragma mark -
@@ -471,6 +606,10 @@ namespace igraph {
 		   - .dimacs                              => DIMACS
 		   - .edgelist, .edges, .edge, .dat, .txt => Edge list
 		   - .adjlist                             => Adjacency list
+		   - .igb                                 => Native binary format
+		 
+		 A further .gz or .zst extension compresses the output with zlib or libzstd,
+		 when they are enabled (see identify_file_compression()).
 		 
 		 If the type cannot be determined, nothing will be written.
 		 
@@ -774,6 +913,15 @@ namespace igraph {
 		
 #pragma mark -
 #pragma mark Miscellaneous
+		
+		/**
+		 \brief Take a read-only snapshot in compressed sparse row form.
+		 
+		 The snapshot is independent of this graph. See CsrGraph.
+		 
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		::tempobj::temporary_class<CsrGraph>::type freeze() const;
 
 		friend class VertexSelector;
 		friend class EdgeSelector;
@@ -0,0 +1,125 @@
+/*
+
+graphbatch.hpp ... Queue edge additions and deletions and apply them at once.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_GRAPHBATCH_HPP
+#define IGRAPH_GRAPHBATCH_HPP
+
+#include <igraph/igraph.h>
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/exception.hpp>
+#include <igraph/cpp/vector.hpp>
+#include <vector>
+
+namespace igraph {
+	class Graph;
+
+	/**
+	 \class GraphBatch
+	 \brief Queue edge additions and deletions, and apply them to the graph at once.
+
+	 Every call to Graph::add_edge() or Graph::delete_edge() re-indexes the
+	 whole graph, which costs O(|V|+|E|). A batch applies all queued changes
+	 with one igraph_delete_edges() and one igraph_add_edges(), so k changes
+	 cost O(|V|+|E|+k) instead of O(k(|V|+|E|)).
+
+	 The graph is not changed until commit(), and must not be changed in any
+	 other way while a batch is pending. Hence every edge ID passed to the
+	 batch refers to the graph as it was before the commit. After commit():
+
+	 - the edges which are not deleted keep their relative order, and each
+	   edge ID moves down by the number of deleted edges with a smaller ID;
+	 - the added edges come after them, in the order they were queued. The
+	   ID of the first added edge is returned by commit().
+
+	 Deleting the same edge twice deletes it once. An edge cannot be added and
+	 deleted in the same batch.
+
+	 \code
+	 GraphBatch batch = g.begin_batch();
+	 batch.delete_edge(3).delete_edge(0, 1);
+	 batch.add_edge(2, 5).add_edge(4, 4);
+	 Edge first_added = batch.commit();
+	 \endcode
+	 */
+	class GraphBatch {
+	private:
+		igraph_t* _;
+		VertexVector added;
+		EdgeVector deleted;
+		::std::vector<bool> is_deleted;	// by edge ID, allocated on the first deletion.
+		Integer base_vcount;	// the size of the graph the queued IDs refer to.
+		Integer base_ecount;
+		uint64_t base_checksum;	// of its edges, to notice changes which keep the size.
+
+		GraphBatch(igraph_t* graph) MAY_THROW_EXCEPTION;
+
+		bool queue_deletion(const long eid);
+
+	public:
+		MEMORY_MANAGER_INTERFACE_NO_COPYING(GraphBatch);
+
+		/// Queue adding an edge from \p from to \p to.
+		GraphBatch& add_edge(const Vertex from, const Vertex to) MAY_THROW_EXCEPTION;
+		/// Queue adding edges given as (from, to) pairs. An unpaired last ID is ignored. If any ID is invalid, nothing is queued.
+		GraphBatch& add_edges(const VertexVector& pairs) MAY_THROW_EXCEPTION;
+
+		/// Queue deleting an edge by its ID in the graph before the commit.
+		GraphBatch& delete_edge(const Edge eid) MAY_THROW_EXCEPTION;
+		/**
+		 \brief Queue deleting one edge from \p from to \p to.
+
+		 For multigraphs, each call picks a different edge between the two
+		 vertices, so calling it twice deletes two parallel edges.
+
+		 - \b Complexity: O(d), where d is the out-degree of \p from (the degree of the larger ID for undirected graphs).
+		 */
+		GraphBatch& delete_edge(const Vertex from, const Vertex to) MAY_THROW_EXCEPTION;
+
+		long pending_additions() const throw() { return added.size() / 2; }
+		long pending_deletions() const throw() { return deleted.size(); }
+
+		/**
+		 \brief Apply all queued changes to the graph.
+
+		 The batch is then empty, and can be reused with edge IDs of the new graph.
+
+		 Either all changes are applied or none. If the graph changed since the
+		 batch was created or last committed (its size, or the checksum of its
+		 edges), the queued IDs may be stale, and the commit fails with
+		 IGRAPH_EINVAL. On failure the batch keeps its changes.
+
+		 \return The ID of the first added edge, which is also the number of
+		         edges that were kept. -1 on failure without exceptions.
+
+		 - \b Complexity: O(|V|+|E|+k), where k is the number of queued changes.
+		 */
+		Edge commit() MAY_THROW_EXCEPTION;
+
+		/// Drop all queued changes without applying them, and start again from the current graph. O(|E|), for the checksum.
+		GraphBatch& discard() throw();
+
+		friend class Graph;
+	};
+
+	MEMORY_MANAGER_INTERFACE_EX_NO_COPYING(GraphBatch);
+}
+
+#endif
@@ -27,6 +27,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <cstdio>
 
 namespace igraph {
+	class VertexNames;
+	
 	enum GraphFormat {
 		GraphFormat_auto,
 		
@@ -40,10 +42,28 @@ namespace igraph {
 		GraphFormat_dot,
 		GraphFormat_graphdb,
 		GraphFormat_adjlist,
+		GraphFormat_binary,
 	};
 	
+	/// Identify the format from the file extension. For compressed files the extension before the ".gz" or ".zst" is used.
 	GraphFormat identify_file_format(const char* filename, const bool open_file_to_check = false);
 	
+	enum FileCompression {
+		FileCompression_none,
+		FileCompression_gzip,
+		FileCompression_zstd,
+	};
+	
+	/**
+	 \brief Identify the compression from the file extension (.gz, .zst).
+	 
+	 Compressed files are read and written with zlib and libzstd, which are
+	 optional. Define IGRAPH_CPP_WITH_ZLIB (and link with -lz) or
+	 IGRAPH_CPP_WITH_ZSTD (and link with -lzstd) to enable them; without
+	 them, opening a file in that format fails with IGRAPH_UNIMPLEMENTED.
+	 */
+	FileCompression identify_file_compression(const char* filename);
+	
 	class GraphReader {
 	private:
 		std::FILE* fptr;
@@ -63,21 +83,47 @@ namespace igraph {
 		
 		enum EdgelistReadEngine {
 			EdgelistReadEngine_igraph,
-			EdgelistReadEngine_igraphhpp
+			EdgelistReadEngine_igraphhpp,
+			/// Map the file into memory and tokenize it in place. Same results as EdgelistReadEngine_igraphhpp.
+			EdgelistReadEngine_mmap,
+			/// Like EdgelistReadEngine_mmap, but tokenize newline-aligned chunks of the file on several threads.
+			EdgelistReadEngine_parallel
 		};
 		
+		/// Open a file for reading. A compressed file (see identify_file_compression()) is decompressed block by block as it is read; a corrupt or truncated one makes the read raise IGRAPH_EFILE.
 		GraphReader(const char* filename);
 		GraphReader(std::FILE* filestream) throw();
 		
-		::tempobj::temporary_class<Graph>::type edgelist(const Directedness directedness = Undirected, const EdgelistReadEngine engine = EdgelistReadEngine_igraph) MAY_THROW_EXCEPTION;
+		/**
+		 \brief Read an edge list.
+		 
+		 \param[in] thread_count Number of threads used by EdgelistReadEngine_parallel.
+		                         0 means one per hardware thread, but not more than one per MiB of input.
+		 */
+		::tempobj::temporary_class<Graph>::type edgelist(const Directedness directedness = Undirected, const EdgelistReadEngine engine = EdgelistReadEngine_igraph, const unsigned thread_count = 0) MAY_THROW_EXCEPTION;
 		::tempobj::temporary_class<Graph>::type adjlist(const Directedness directedness = Undirected, const EdgeMultiplicity multiplicity = EdgeMultiplicity_Simple, const char* line_separator = "\n") MAY_THROW_EXCEPTION;
-		// TODO: ncol, after StringVector is implemented.
+		/**
+		 \brief Read a symbolic edge list, with one "name1 name2 [weight]" per line.
+		 
+		 The names are interned into \p names, which then maps the vertex IDs
+		 back to names. Names already in \p names keep their IDs, like the
+		 predefined names of igraph_read_graph_ncol().
+		 
+		 A line with a single name, more than three fields or a weight which is
+		 not a number raises IGRAPH_PARSEERROR. The names read before it stay
+		 in \p names.
+		 */
+		::tempobj::temporary_class<Graph>::type ncol(VertexNames& names, const Directedness directedness = Undirected) MAY_THROW_EXCEPTION;
+		/// Read a symbolic edge list with weights. Edges without a weight get 0.
+		::tempobj::temporary_class<Graph>::type ncol(VertexNames& names, Vector& weights, const Directedness directedness = Undirected) MAY_THROW_EXCEPTION;
 		::tempobj::temporary_class<Graph>::type lgl(const lglNames names = lglNames_Ignore, const lglWeights weights = lglWeights_Ignore) MAY_THROW_EXCEPTION;
 		// TODO: dimacs, after StringVector is implemented.
 		::tempobj::temporary_class<Graph>::type graphml(const int index = 0) MAY_THROW_EXCEPTION;
 		::tempobj::temporary_class<Graph>::type gml() MAY_THROW_EXCEPTION;
 		::tempobj::temporary_class<Graph>::type pajek() MAY_THROW_EXCEPTION;
 		::tempobj::temporary_class<Graph>::type graphdb(const Directedness directedness = Undirected) MAY_THROW_EXCEPTION;
+		/// Read a graph written by GraphWriter::binary(). 8-byte indices on little-endian machines are used in place without parsing.
+		::tempobj::temporary_class<Graph>::type binary() MAY_THROW_EXCEPTION;
 	};
 
 	class GraphWriter {
@@ -85,6 +131,7 @@ namespace igraph {
 		const igraph_t* _;
 		std::FILE* fptr;
 	
+		/// Open a file for writing. A compressed file (see identify_file_compression()) is compressed block by block as it is written, and finished when the writer is closed.
 		GraphWriter(const igraph_t* graph, const char* filename);
 		GraphWriter(const igraph_t* graph, std::FILE* filestream) throw();
 		
@@ -96,9 +143,28 @@ namespace igraph {
 			lglIsolatedVertices_Write,
 		};
 		
-		void edgelist(const char* separator = NULL, const char* line_separator = NULL) MAY_THROW_EXCEPTION;
-		void adjlist(const char* first_separator = ", ", const char* separator = ", ", const char* line_separator = "\n") MAY_THROW_EXCEPTION;
-		void ncol(const char* names = NULL, const char* weights = NULL) MAY_THROW_EXCEPTION;
+		enum BinaryIndexWidth {
+			/// 4-byte unsigned integers. Half the size, but have to be converted when read. Graphs with more than 2^32 vertices are rejected with IGRAPH_EINVAL.
+			BinaryIndexWidth_32 = 4,
+			/// 8-byte igraph_real_t, the in-memory layout of a VertexVector. Can be read without conversion.
+			BinaryIndexWidth_Native = 8,
+		};
+		
+		/**
+		 \brief Write an edge list.
+		 
+		 Without separators the output is the same as igraph_write_graph_edgelist(),
+		 which orders the edges by source vertex. Otherwise the edges are written
+		 in edge ID order.
+		 
+		 \param[in] thread_count Number of threads which format the output. The
+		                         output does not depend on it. 0 means one per hardware thread.
+		 */
+		void edgelist(const char* separator = NULL, const char* line_separator = NULL, const unsigned thread_count = 1) MAY_THROW_EXCEPTION;
+		/// Write an adjacency list. thread_count is as in edgelist().
+		void adjlist(const char* first_separator = ", ", const char* separator = ", ", const char* line_separator = "\n", const unsigned thread_count = 1) MAY_THROW_EXCEPTION;
+		/// Write an NCOL file. thread_count is as in edgelist(), but only used without names and weights.
+		void ncol(const char* names = NULL, const char* weights = NULL, const unsigned thread_count = 1) MAY_THROW_EXCEPTION;
 		void lgl(const char* names = NULL, const char* weights = NULL, const lglIsolatedVertices isolates = lglIsolatedVertices_Ignore) MAY_THROW_EXCEPTION;
 		void dimacs(const Vertex source, const Vertex target, const Vector& capacity_of_each_edge) MAY_THROW_EXCEPTION;
 		void graphml() MAY_THROW_EXCEPTION;
@@ -106,6 +172,31 @@ namespace igraph {
 		void gml(const Vector& new_vertex_ids, const char* creator = NULL) MAY_THROW_EXCEPTION;
 		void pajek() MAY_THROW_EXCEPTION;
 		void dot() MAY_THROW_EXCEPTION;
+		/**
+		 \brief Write in the native binary format.
+		 
+		 The file is a 32-byte header followed by the edge list as pairs of
+		 (from, to) in edge ID order. All numbers are little-endian. Header:
+		   - 4 bytes: magic "IGBN"
+		   - 1 byte: format version (1)
+		   - 1 byte: directedness (0 or 1)
+		   - 1 byte: index width (4 or 8)
+		   - 1 byte: reserved (0)
+		   - 8 bytes: vertex count
+		   - 8 bytes: edge count
+		   - 8 bytes: reserved (0)
+		 */
+		void binary(const BinaryIndexWidth index_width = BinaryIndexWidth_Native) MAY_THROW_EXCEPTION;
+		
+		/**
+		 \brief Flush the output and close the file, finishing the compressed stream if needed.
+		 
+		 The writer is also closed when it is destroyed, but then errors cannot
+		 be reported. A stream passed to the constructor is only flushed.
+		 
+		 \return Whether everything was written.
+		 */
+		bool close() MAY_THROW_EXCEPTION;
 			
 		friend class Graph;
 	};
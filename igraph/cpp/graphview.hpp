@@ -0,0 +1,145 @@
+/*
+
+graphview.hpp ... A graph with some vertices and edges hidden, without copying it.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_GRAPHVIEW_HPP
+#define IGRAPH_GRAPHVIEW_HPP
+
+#include <igraph/igraph.h>
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/exception.hpp>
+#include <igraph/cpp/vector.hpp>
+#include <igraph/cpp/neighborview.hpp>
+#include <igraph/cpp/graph.hpp>
+#include <vector>
+
+namespace igraph {
+	/**
+	 \class GraphView
+	 \brief A graph with some vertices and edges hidden, without copying it.
+
+	 Graph::subgraph(), Graph::max_component() and Graph::decompose() build
+	 new graphs. A GraphView instead refers to the parent graph and to masks,
+	 and skips the hidden vertices and edges while traversing. The masks are
+	 BoolVectors with one entry per vertex or edge of the parent, true for
+	 the ones kept. An edge is kept if it and both its endpoints are kept.
+
+	 Vertices and edges keep their IDs in the parent graph. Results indexed
+	 by vertex have an entry for every vertex of the parent, and the hidden
+	 ones get -1 (or 0 for degrees).
+
+	 Setting a mask is O(1). The view reads the parent graph and the masks
+	 on every call, so they must outlive it, and changing them changes the
+	 view. Resizing a mask, or adding or deleting vertices or edges of the
+	 parent, invalidates the view.
+
+	 \code
+	 BoolVector alive (g.size());
+	 alive.fill(true);
+	 alive[hub] = false;
+	 Vector membership, sizes;
+	 GraphView(g).set_vertex_mask(alive).cluster(membership, sizes);
+	 \endcode
+	 */
+	class GraphView {
+	private:
+		const igraph_t* graph;
+		const Boolean* vertex_mask;	// NULL to keep all.
+		const Boolean* edge_mask;	// NULL to keep all.
+
+		bool keeps(const long eid, const long neighbor) const throw() {
+			return (edge_mask == NULL || edge_mask[eid]) && (vertex_mask == NULL || vertex_mask[neighbor]);
+		}
+		long other_end(const long eid, const long v) const throw() {
+			long from = static_cast<long>(VECTOR(graph->from)[eid]);
+			return from == v ? static_cast<long>(VECTOR(graph->to)[eid]) : from;
+		}
+		bool check_vertex(const Vertex vid) const MAY_THROW_EXCEPTION;
+
+		template <typename F>
+		void for_each_incident(const long v, const NeighboringMode mode, F& f) const;
+
+		// return the number of components; hidden vertices are labeled -1.
+		long label_weak_components(::std::vector<long>& membership, ::std::vector<long>& csize) const;
+		long label_strong_components(::std::vector<long>& membership, ::std::vector<long>& csize) const;
+
+	public:
+		/// A view of the whole graph.
+		explicit GraphView(const Graph& g) throw();
+
+		/// Hide the vertices whose entry of \p mask is false. The size of \p mask must be the number of vertices.
+		GraphView& set_vertex_mask(const BoolVector& mask) MAY_THROW_EXCEPTION;
+		/// Hide the edges whose entry of \p mask is false. The size of \p mask must be the number of edges.
+		GraphView& set_edge_mask(const BoolVector& mask) MAY_THROW_EXCEPTION;
+		/// Show all vertices and edges again.
+		GraphView& clear_masks() throw() { vertex_mask = edge_mask = NULL; return *this; }
+
+		/// The number of vertices of the parent graph, which is one more than the largest vertex ID.
+		long size() const throw() { return static_cast<long>(igraph_vcount(graph)); }
+		Directedness is_directed() const throw() { return igraph_is_directed(graph) ? Directed : Undirected; }
+
+		bool has_vertex(const Vertex vid) const throw() { return vid >= 0 && vid < size() && (vertex_mask == NULL || vertex_mask[static_cast<long>(vid)]); }
+		bool has_edge(const Edge eid) const throw();
+		/// The number of kept vertices, in O(|V|).
+		long vertex_count() const throw();
+		/// The number of kept edges, in O(|E|).
+		long edge_count() const throw();
+
+		/**
+		 \brief The kept neighbors of a kept vertex.
+
+		 The neighbors are in the order of Graph::neighbor_view().
+
+		 - \b Complexity: O(d), where d is the degree in the parent graph.
+		 */
+		::tempobj::force_temporary_class<VertexVector>::type neighbors(const Vertex vid, NeighboringMode neimode = OutNeighbors) const MAY_THROW_EXCEPTION;
+		/// The kept edges at a kept vertex, in the order of Graph::incident_edge_view().
+		::tempobj::force_temporary_class<EdgeVector>::type adjacent(const Vertex vid, NeighboringMode neimode = OutNeighbors) const MAY_THROW_EXCEPTION;
+
+		/// The number of kept edges at a kept vertex, in O(d).
+		Integer degree_of(const Vertex vid, NeighboringMode neimode = OutNeighbors, SelfLoops countLoops = ContainSelfLoops) const MAY_THROW_EXCEPTION;
+		/// The degrees of all vertices, 0 for the hidden ones.
+		::tempobj::force_temporary_class<Vector>::type degree(NeighboringMode neimode = OutNeighbors, SelfLoops countLoops = ContainSelfLoops) const MAY_THROW_EXCEPTION;
+
+		/**
+		 \brief The number of edges on the shortest path from \p source to each vertex.
+
+		 Unreachable and hidden vertices get -1.
+
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		::tempobj::force_temporary_class<Vector>::type bfs_distances(const Vertex source, NeighboringMode mode = OutNeighbors) const MAY_THROW_EXCEPTION;
+
+		/**
+		 \brief The connected components of the kept vertices, as Graph::cluster().
+
+		 Hidden vertices get the cluster ID -1. Weakly connected components are
+		 numbered in the order of their smallest vertex ID, as in igraph;
+		 strongly connected components are numbered in no particular order.
+
+		 - \b Complexity: O(|V|+|E|)
+		 */
+		void cluster(Vector& cluster_id_each_vertex_belongs_to, Vector& size_of_each_cluster, Graph::Connectedness connectedness = Graph::WeaklyConnected) const MAY_THROW_EXCEPTION;
+		Integer cluster_count(const Graph::Connectedness connectedness = Graph::WeaklyConnected) const MAY_THROW_EXCEPTION;
+		bool is_connected(const Graph::Connectedness connectedness = Graph::WeaklyConnected) const MAY_THROW_EXCEPTION;
+	};
+}
+
+#endif
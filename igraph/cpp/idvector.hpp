@@ -0,0 +1,109 @@
+/*
+
+idvector.hpp ... Compact integer vectors of vertex and edge IDs.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_IDVECTOR_HPP
+#define IGRAPH_IDVECTOR_HPP
+
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/vector.hpp>
+
+namespace igraph {
+	/**
+	 \class IdVector
+	 \brief A growable array of vertex or edge IDs stored as integers.
+
+	 VertexVector and EdgeVector store IDs as igraph_real_t, which takes 8
+	 bytes per ID and a conversion whenever the ID is used as an index.
+	 IdVector32 takes 4 bytes per ID, for graphs with fewer than 2^31
+	 vertices and edges. IdVector64 has no such limit.
+
+	 The Graph functions which fill an IdVector read the graph's index
+	 directly. They reuse the storage of the vector, so calling them in a
+	 loop with the same vector does not allocate once it is large enough.
+
+	 \code
+	 IdVector32 nei;
+	 for (long v = 0; v < g.size(); ++ v) {
+	     g.neighbors(v, nei);
+	     for (const int32_t* p = nei.begin(); p != nei.end(); ++ p)
+	         visit(v, *p);
+	 }
+	 \endcode
+	 */
+	template <typename T>
+	class IdVector {
+	private:
+		T* array;
+		long count;
+		long capacity;
+
+	public:
+		MEMORY_MANAGER_INTERFACE_WITH_TEMPLATE(IdVector, <T>);
+
+		typedef T value_type;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+
+		/// An empty vector.
+		IdVector() throw();
+		/// A vector of \p size zeros.
+		explicit IdVector(const long size) MAY_THROW_EXCEPTION;
+		/// Convert a VertexVector or EdgeVector. An ID which does not fit in T (or NaN) raises IGRAPH_EINVAL, and without exceptions gives an empty vector.
+		explicit IdVector(const BasicVector<Real>& vec) MAY_THROW_EXCEPTION;
+
+		/// Convert to a VertexVector or EdgeVector, for the functions which take those.
+		::tempobj::force_temporary_class<BasicVector<Real> >::type as_vector() const MAY_THROW_EXCEPTION;
+
+		long size() const throw() { return count; }
+		bool empty() const throw() { return count == 0; }
+		T& operator[] (const long index) throw() { return array[index]; }
+		T operator[] (const long index) const throw() { return array[index]; }
+		T* begin() throw() { return array; }
+		T* end() throw() { return array + count; }
+		const T* begin() const throw() { return array; }
+		const T* end() const throw() { return array + count; }
+
+		/// If the memory cannot be allocated and exceptions are disabled, the vector is left unchanged.
+		IdVector<T>& reserve(const long new_capacity) MAY_THROW_EXCEPTION;
+		/// Change the size. New elements are not initialized.
+		IdVector<T>& resize(const long new_size) MAY_THROW_EXCEPTION;
+		IdVector<T>& clear() throw() { count = 0; return *this; }
+		IdVector<T>& push_back(const T e) MAY_THROW_EXCEPTION {
+			if (count == capacity) {
+				reserve(capacity < 4 ? 4 : capacity + capacity / 2);
+				if (count == capacity)
+					return *this;
+			}
+			array[count++] = e;
+			return *this;
+		}
+
+		bool operator== (const IdVector<T>& other) const throw();
+		bool operator!= (const IdVector<T>& other) const throw() { return !(*this == other); }
+	};
+
+	MEMORY_MANAGER_INTERFACE_EX_WITH_TEMPLATE(template<typename T>, IdVector<T>);
+
+	typedef IdVector<int32_t> IdVector32;
+	typedef IdVector<int64_t> IdVector64;
+}
+
+#endif
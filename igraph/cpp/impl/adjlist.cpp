@@ -23,6 +23,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define IGRAPH_ADJLIST_CPP
 
 #include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
 #include <igraph/cpp/vector.hpp>
 #include <igraph/cpp/adjlist.hpp>
 #include <igraph/cpp/graph.hpp>
@@ -65,6 +68,165 @@ namespace igraph {
 	Integer AdjacencyList::size() const throw() {
 		return igraph_adjlist_size(&_);
 	}
+
+#pragma mark -
+#pragma mark FlatAdjacencyList
+	
+	MEMORY_MANAGER_IMPLEMENTATION_NO_COPYING(FlatAdjacencyList);
+	
+	IMPLEMENT_MOVE_METHOD(FlatAdjacencyList) {
+		vertex_count = ::std::move(other.vertex_count);
+		offset_array = ::std::move(other.offset_array);
+		neighbor_array = ::std::move(other.neighbor_array);
+	}
+	IMPLEMENT_DEALLOC_METHOD(FlatAdjacencyList) {
+		::std::free(offset_array);
+		::std::free(neighbor_array);
+	}
+	
+	FlatAdjacencyList::FlatAdjacencyList(const Integer size, const long neighbor_count) MAY_THROW_EXCEPTION {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(FlatAdjacencyList);
+		TRY(allocate(size, neighbor_count));
+	}
+	
+	int FlatAdjacencyList::allocate(const Integer size, const long neighbor_count) throw() {
+		vertex_count = size;
+		offset_array = reinterpret_cast<long*>(::std::malloc((static_cast<long>(size) + 1) * sizeof(long)));
+		// allocate at least one element, so that NULL always means failure.
+		neighbor_array = reinterpret_cast<Vertex*>(::std::malloc((neighbor_count > 0 ? neighbor_count : 1) * sizeof(Vertex)));
+		if (offset_array == NULL || neighbor_array == NULL) {
+			::std::free(offset_array);
+			::std::free(neighbor_array);
+			vertex_count = 0;
+			offset_array = NULL;
+			neighbor_array = NULL;
+			return IGRAPH_ENOMEM;
+		}
+		offset_array[0] = 0;
+		return IGRAPH_SUCCESS;
+	}
+	
+	/**
+	 \internal
+	 The rows are read from igraph's index, where the out-neighbors (to[oi[k]]
+	 for k in os[v]..os[v+1]) and the in-neighbors (from[ii[k]] for k in
+	 is[v]..is[v+1]) are each sorted. For undirected graphs the out-neighbors
+	 are all at most v and the in-neighbors at least v, so the row is the
+	 first list followed by the second. For AllNeighbors on directed graphs
+	 the two lists are merged.
+	 */
+	FlatAdjacencyList::FlatAdjacencyList(const Graph& g, NeighboringMode mode) MAY_THROW_EXCEPTION {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(FlatAdjacencyList);
+		const igraph_t* graph = g.get();
+		if (!igraph_is_directed(graph))
+			mode = AllNeighbors;
+		bool use_out = mode != InNeighbors, use_in = mode != OutNeighbors;
+		long n = static_cast<long>(igraph_vcount(graph)), m = static_cast<long>(igraph_ecount(graph));
+		int errcode = allocate(igraph_vcount(graph), (use_out ? m : 0) + (use_in ? m : 0));
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return;
+		}
+		
+		const Real* oi = VECTOR(graph->oi);
+		const Real* ii = VECTOR(graph->ii);
+		const Real* os = VECTOR(graph->os);
+		const Real* is = VECTOR(graph->is);
+		const Real* from = VECTOR(graph->from);
+		const Real* to = VECTOR(graph->to);
+		
+		long pos = 0;
+		for (long v = 0; v < n; ++ v) {
+			long i = use_out ? static_cast<long>(os[v]) : 0, i_end = use_out ? static_cast<long>(os[v+1]) : 0;
+			long j = use_in ? static_cast<long>(is[v]) : 0, j_end = use_in ? static_cast<long>(is[v+1]) : 0;
+			while (i < i_end && j < j_end) {
+				Vertex out = to[static_cast<long>(oi[i])], in = from[static_cast<long>(ii[j])];
+				if (out <= in) {
+					neighbor_array[pos++] = out;
+					++ i;
+				} else {
+					neighbor_array[pos++] = in;
+					++ j;
+				}
+			}
+			for (; i < i_end; ++ i)
+				neighbor_array[pos++] = to[static_cast<long>(oi[i])];
+			for (; j < j_end; ++ j)
+				neighbor_array[pos++] = from[static_cast<long>(ii[j])];
+			offset_array[v+1] = pos;
+		}
+	}
+	
+	::tempobj::temporary_class<FlatAdjacencyList>::type FlatAdjacencyList::complementer(const Graph& g, NeighboringMode mode, SelfLoops loop) MAY_THROW_EXCEPTION {
+		FlatAdjacencyList neighbors (g, mode);
+		long n = static_cast<long>(neighbors.size());
+		
+		// mark[u] == v+1 iff u is a neighbor of v (or v itself, when loops are not wanted).
+		::std::vector<long> mark (n, 0);
+		long total = 0;
+		for (long v = 0; v < n; ++ v) {
+			long excluded = 0;
+			if (loop == NoSelfLoops) {
+				mark[v] = v+1;
+				++ excluded;
+			}
+			for (const Vertex* p = neighbors.begin(v); p != neighbors.end(v); ++ p) {
+				long u = static_cast<long>(*p);
+				if (mark[u] != v+1) {
+					mark[u] = v+1;
+					++ excluded;
+				}
+			}
+			total += n - excluded;
+		}
+		
+		FlatAdjacencyList res (neighbors.size(), total);
+		if (res.offset_array == NULL)
+			return ::tempobj::force_move(res);
+		::std::fill(mark.begin(), mark.end(), 0);
+		long pos = 0;
+		for (long v = 0; v < n; ++ v) {
+			if (loop == NoSelfLoops)
+				mark[v] = v+1;
+			for (const Vertex* p = neighbors.begin(v); p != neighbors.end(v); ++ p)
+				mark[static_cast<long>(*p)] = v+1;
+			for (long u = 0; u < n; ++ u)
+				if (mark[u] != v+1)
+					res.neighbor_array[pos++] = u;
+			res.offset_array[v+1] = pos;
+		}
+		return ::tempobj::force_move(res);
+	}
+	
+	::tempobj::temporary_class<Vector>::type FlatAdjacencyList::operator[](const Vertex v) const throw() {
+		return ::tempobj::force_move(Vector::view(begin(v), degree(v)));
+	}
+	
+	FlatAdjacencyList& FlatAdjacencyList::sort() throw() {
+		for (long v = 0; v < static_cast<long>(vertex_count); ++ v)
+			::std::sort(neighbor_array + offset_array[v], neighbor_array + offset_array[v+1]);
+		return *this;
+	}
+	
+	FlatAdjacencyList& FlatAdjacencyList::simplify() {
+		long n = static_cast<long>(vertex_count);
+		::std::vector<long> mark (n, 0);
+		long pos = 0, row_start = 0;
+		for (long v = 0; v < n; ++ v) {
+			long row_end = offset_array[v+1];
+			mark[v] = v+1;
+			for (long k = row_start; k < row_end; ++ k) {
+				long u = static_cast<long>(neighbor_array[k]);
+				if (mark[u] != v+1) {
+					mark[u] = v+1;
+					neighbor_array[pos++] = u;
+				}
+			}
+			row_start = row_end;
+			offset_array[v+1] = pos;
+		}
+		return *this;
+	}
 }
 
 #endif
@@ -0,0 +1,335 @@
+/*
+
+compressedgraph.cpp ... Read-only graphs with gap-encoded adjacency lists.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_COMPRESSEDGRAPH_CPP
+#define IGRAPH_COMPRESSEDGRAPH_CPP
+
+#include <igraph/cpp/compressedgraph.hpp>
+#include <igraph/cpp/graph.hpp>
+#include <igraph/cpp/edgestream.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace igraph {
+#pragma mark -
+#pragma mark Varints
+
+	/// The number of bytes of the varint of x.
+	static inline long XXINTRNL_varint_length(uint64_t x) throw() {
+		long length = 1;
+		while (x >= 0x80) {
+			x >>= 7;
+			++ length;
+		}
+		return length;
+	}
+	static inline unsigned char* XXINTRNL_write_varint(unsigned char* out, uint64_t x) throw() {
+		while (x >= 0x80) {
+			*out++ = static_cast<unsigned char>(x | 0x80);
+			x >>= 7;
+		}
+		*out++ = static_cast<unsigned char>(x);
+		return out;
+	}
+	static inline uint64_t XXINTRNL_read_varint(const unsigned char*& in) throw() {
+		uint64_t x = *in++;
+		if (x < 0x80)	// the common case of a small gap.
+			return x;
+		x &= 0x7F;
+		for (int shift = 7; ; shift += 7) {
+			uint64_t byte = *in++;
+			x |= (byte & 0x7F) << shift;
+			if (byte < 0x80)
+				return x;
+		}
+	}
+
+	/// Map signed differences to unsigned ones, small magnitudes to small numbers.
+	static inline uint64_t XXINTRNL_zigzag(const int64_t x) throw() {
+		return (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63);
+	}
+	static inline int64_t XXINTRNL_unzigzag(const uint64_t x) throw() {
+		return static_cast<int64_t>(x >> 1) ^ -static_cast<int64_t>(x & 1);
+	}
+
+	/// Write the list of v (sorted) to out, or only count its bytes if out is NULL.
+	static long XXINTRNL_encode_list(const long v, const ::std::vector<long>& list, unsigned char* out) throw() {
+		long count = list.size();
+		long length = XXINTRNL_varint_length(count);
+		if (out != NULL)
+			out = XXINTRNL_write_varint(out, count);
+		for (long i = 0; i < count; ++ i) {
+			uint64_t gap = i == 0 ? XXINTRNL_zigzag(list[0] - v) : static_cast<uint64_t>(list[i] - list[i-1]);
+			length += XXINTRNL_varint_length(gap);
+			if (out != NULL)
+				out = XXINTRNL_write_varint(out, gap);
+		}
+		return length;
+	}
+
+#pragma mark -
+#pragma mark Iteration
+
+	CompressedGraph::iterator::iterator(const unsigned char* first_gap, const long count, const long vertex) throw() : position(first_gap), remaining(count), current(0) {
+		if (remaining > 0)
+			current = vertex + XXINTRNL_unzigzag(XXINTRNL_read_varint(position));
+	}
+
+	CompressedGraph::iterator& CompressedGraph::iterator::operator++() throw() {
+		if (-- remaining > 0)
+			current += static_cast<long>(XXINTRNL_read_varint(position));
+		return *this;
+	}
+
+	long CompressedGraph::degree(const long v) const throw() {
+		const unsigned char* p = &data[0] + offset_array[v];
+		return static_cast<long>(XXINTRNL_read_varint(p));
+	}
+
+	CompressedGraph::Range CompressedGraph::neighbors(const long v) const throw() {
+		const unsigned char* p = &data[0] + offset_array[v];
+		long count = static_cast<long>(XXINTRNL_read_varint(p));
+		return Range(iterator(p, count, v), count);
+	}
+
+	template <typename T>
+	void CompressedGraph::neighbors(const long v, IdVector<T>& res) const {
+		const unsigned char* p = &data[0] + offset_array[v];
+		long count = static_cast<long>(XXINTRNL_read_varint(p));
+		res.resize(count);
+		if (count == 0)
+			return;
+		T* out = res.begin();
+		int64_t current = v + XXINTRNL_unzigzag(XXINTRNL_read_varint(p));
+		out[0] = static_cast<T>(current);
+		for (long i = 1; i < count; ++ i) {
+			current += XXINTRNL_read_varint(p);
+			out[i] = static_cast<T>(current);
+		}
+	}
+
+#pragma mark -
+#pragma mark Construction
+
+	CompressedGraph::CompressedGraph(const long size, const Directedness directedness, const NeighboringMode lists) throw()
+		: vertex_count(size), edge_count(0), entry_count(0), directed(directedness == Directed), mode(directedness == Directed ? lists : AllNeighbors) {}
+
+	/**
+	 \internal
+	 Encode the lists given by source.list(v, list), which fills list with
+	 the sorted neighbors of v. The lists are made twice: first to measure
+	 them, so that the data is allocated once at its exact size.
+	 */
+	template <typename Source>
+	void CompressedGraph::encode(Source& source) {
+		::std::vector<long> list;
+		offset_array.resize(vertex_count + 1);
+		uint64_t total = 0;
+		entry_count = 0;
+		for (long v = 0; v < vertex_count; ++ v) {
+			offset_array[v] = total;
+			source.list(v, list);
+			total += XXINTRNL_encode_list(v, list, NULL);
+			entry_count += list.size();
+		}
+		offset_array[vertex_count] = total;
+
+		data.resize(total);
+		for (long v = 0; v < vertex_count; ++ v) {
+			source.list(v, list);
+			XXINTRNL_encode_list(v, list, &data[0] + offset_array[v]);
+		}
+	}
+
+	/// The lists of a Graph, from its index.
+	struct XXINTRNL_GraphListSource {
+		const igraph_t* graph;
+		NeighboringMode mode;
+		void list(const long v, ::std::vector<long>& list) const {
+			NeighborView nei (graph, v, mode);
+			list.assign(nei.begin(), nei.end());
+			// the out-list and the in-list are each sorted, but not their concatenation.
+			if (mode == AllNeighbors && igraph_is_directed(graph))
+				::std::inplace_merge(list.begin(), list.begin() + NeighborView(graph, v, OutNeighbors).size(), list.end());
+		}
+	};
+
+	CompressedGraph::CompressedGraph(const Graph& g, const NeighboringMode lists) : vertex_count(g.size()), edge_count(g.edges()), entry_count(0), directed(g.is_directed() == Directed), mode(directed ? lists : AllNeighbors) {
+		XXINTRNL_GraphListSource source = {g.get(), mode};
+		encode(source);
+	}
+
+	/// The lists of a chunk of (owner, neighbor) pairs, sorted.
+	struct XXINTRNL_PairListSource {
+		const ::std::vector< ::std::pair<long, long> >* pairs;
+		::std::size_t position;
+		void list(const long v, ::std::vector<long>& list) {
+			if (v == 0)	// restart for the second pass.
+				position = 0;
+			list.clear();
+			for (; position < pairs->size() && (*pairs)[position].first == v; ++ position)
+				list.push_back((*pairs)[position].second);
+		}
+	};
+
+	/// The union of the lists of several compressed chunks.
+	struct XXINTRNL_ChunkMergeSource {
+		const ::std::vector<CompressedGraph>* chunks;
+		IdVector64 decoded;
+		void list(const long v, ::std::vector<long>& list) {
+			list.clear();
+			for (::std::size_t c = 0; c < chunks->size(); ++ c) {
+				const CompressedGraph& chunk = (*chunks)[c];
+				if (v >= chunk.size())
+					continue;
+				chunk.neighbors(v, decoded);
+				::std::size_t middle = list.size();
+				list.insert(list.end(), decoded.begin(), decoded.end());
+				::std::inplace_merge(list.begin(), list.begin() + middle, list.end());
+			}
+		}
+	};
+
+	CompressedGraph::CompressedGraph(EdgeStream& stream, const Directedness directedness, const NeighboringMode lists, const long chunk_size)
+		: vertex_count(0), edge_count(0), entry_count(0), directed(directedness == Directed), mode(directed ? lists : AllNeighbors) {
+		bool list_targets = mode != InNeighbors;	// from lists to
+		bool list_sources = mode != OutNeighbors;	// to lists from
+
+		::std::vector<CompressedGraph> chunks;
+		::std::vector< ::std::pair<long, long> > pairs;
+		pairs.reserve(chunk_size);
+		VertexVector batch;
+		bool more = true;
+		while (more) {
+			more = stream.next(batch);
+			long count = batch.size() / 2;
+			for (long i = 0; i < count; ++ i) {
+				long from = static_cast<long>(batch[2*i]), to = static_cast<long>(batch[2*i+1]);
+				if (from < 0 || to < 0)
+					continue;
+				++ edge_count;
+				if (from >= vertex_count)
+					vertex_count = from + 1;
+				if (to >= vertex_count)
+					vertex_count = to + 1;
+				if (list_targets)
+					pairs.push_back(::std::make_pair(from, to));
+				if (list_sources)
+					pairs.push_back(::std::make_pair(to, from));
+			}
+			if ((!more || static_cast<long>(pairs.size()) >= chunk_size) && !pairs.empty()) {
+				::std::sort(pairs.begin(), pairs.end());
+				chunks.push_back(CompressedGraph(pairs.back().first + 1, directedness, mode));
+				XXINTRNL_PairListSource source = {&pairs, 0};
+				chunks.back().encode(source);
+				pairs.clear();
+			}
+		}
+
+		if (chunks.size() == 1 && chunks[0].size() == vertex_count) {
+			offset_array.swap(chunks[0].offset_array);
+			data.swap(chunks[0].data);
+			entry_count = chunks[0].entry_count;
+		} else {
+			XXINTRNL_ChunkMergeSource source;
+			source.chunks = &chunks;
+			encode(source);
+		}
+	}
+
+#pragma mark -
+#pragma mark Traversals
+
+	template <typename T>
+	void CompressedGraph::bfs_distances(const long source, IdVector<T>& distance) const MAY_THROW_EXCEPTION {
+		distance.resize(vertex_count);
+		for (T* p = distance.begin(); p != distance.end(); ++ p)
+			*p = -1;
+		if (source < 0 || source >= vertex_count) {
+			TRY(IGRAPH_EINVVID);
+			return;
+		}
+		IdVector<T> queue;
+		queue.reserve(vertex_count);
+		distance[source] = 0;
+		queue.push_back(static_cast<T>(source));
+		for (long head = 0; head < queue.size(); ++ head) {
+			long v = static_cast<long>(queue[head]);
+			T next = distance[v] + 1;
+			Range nei = neighbors(v);
+			for (iterator it = nei.begin(); it != nei.end(); ++ it)
+				if (distance[*it] < 0) {
+					distance[*it] = next;
+					queue.push_back(static_cast<T>(*it));
+				}
+		}
+	}
+
+	/**
+	 \internal
+	 Union-find where the root of each set is its smallest vertex, so that
+	 parent[v] <= v always holds. After all unions one pass in increasing
+	 order replaces each parent by its root, and a second pass replaces the
+	 roots by consecutive labels, both in place.
+	 */
+	template <typename T>
+	long CompressedGraph::cluster(IdVector<T>& membership, IdVector<T>& csize) const {
+		IdVector<T>& parent = membership;
+		parent.resize(vertex_count);
+		for (long v = 0; v < vertex_count; ++ v)
+			parent[v] = static_cast<T>(v);
+		for (long v = 0; v < vertex_count; ++ v) {
+			Range nei = neighbors(v);
+			for (iterator it = nei.begin(); it != nei.end(); ++ it) {
+				long a = v, b = *it;
+				while (parent[a] != a)
+					a = parent[a] = parent[parent[a]];
+				while (parent[b] != b)
+					b = parent[b] = parent[parent[b]];
+				if (a < b)
+					parent[b] = static_cast<T>(a);
+				else if (b < a)
+					parent[a] = static_cast<T>(b);
+			}
+		}
+
+		for (long v = 0; v < vertex_count; ++ v)
+			parent[v] = parent[parent[v]];
+		csize.clear();
+		for (long v = 0; v < vertex_count; ++ v) {
+			long root = parent[v];
+			if (root == v) {
+				membership[v] = static_cast<T>(csize.size());
+				csize.push_back(0);
+			} else
+				membership[v] = membership[root];
+			++ csize[membership[v]];
+		}
+		return csize.size();
+	}
+
+	long CompressedGraph::cluster_count() const {
+		IdVector64 membership, csize;
+		return cluster(membership, csize);
+	}
+}
+
+#endif
@@ -0,0 +1,156 @@
+/*
+
+csrgraph.cpp ... Immutable compressed sparse row snapshot of a graph.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_CSRGRAPH_CPP
+#define IGRAPH_CSRGRAPH_CPP
+
+#include <igraph/cpp/csrgraph.hpp>
+#include <igraph/cpp/graph.hpp>
+#include <cstdlib>
+#include <new>
+
+namespace igraph {
+	MEMORY_MANAGER_IMPLEMENTATION_NO_COPYING(CsrGraph);
+
+	IMPLEMENT_MOVE_METHOD(CsrGraph) {
+		vertex_count = ::std::move(other.vertex_count);
+		edge_count = ::std::move(other.edge_count);
+		directed = ::std::move(other.directed);
+		storage = ::std::move(other.storage);
+		out_offset_array = ::std::move(other.out_offset_array);
+		out_target_array = ::std::move(other.out_target_array);
+		out_edge_array = ::std::move(other.out_edge_array);
+		in_offset_array = ::std::move(other.in_offset_array);
+		in_target_array = ::std::move(other.in_target_array);
+		in_edge_array = ::std::move(other.in_edge_array);
+	}
+	IMPLEMENT_DEALLOC_METHOD(CsrGraph) {
+		::std::free(storage);
+	}
+
+	CsrGraph::CsrGraph(const Graph& g) : storage(NULL) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(CsrGraph);
+		vertex_count = igraph_vcount(g.get());
+		edge_count = igraph_ecount(g.get());
+		directed = igraph_is_directed(g.get());
+
+		// directed: 2 offset arrays, and 2 target and 2 edge arrays of |E| entries.
+		// undirected: 1 offset array, and 1 target and 1 edge array of 2|E| entries.
+		long offset_arrays = directed ? 2 : 1;
+		storage = reinterpret_cast<long*>(::std::malloc((offset_arrays * (vertex_count + 1) + 4 * edge_count) * sizeof(long)));
+		if (storage == NULL)
+			throw ::std::bad_alloc();
+
+		if (directed)
+			build_directed(g.get());
+		else
+			build_undirected(g.get());
+	}
+
+	/// igraph already keeps the edges sorted by source (oi, os) and by target (ii, is), so the arrays are just a translation.
+	void CsrGraph::build_directed(const igraph_t* graph) throw() {
+		long n = vertex_count, m = edge_count;
+		out_offset_array = storage;
+		in_offset_array = out_offset_array + (n + 1);
+		out_target_array = in_offset_array + (n + 1);
+		out_edge_array = out_target_array + m;
+		in_target_array = out_edge_array + m;
+		in_edge_array = in_target_array + m;
+
+		const Real* from = VECTOR(graph->from);
+		const Real* to = VECTOR(graph->to);
+		for (long v = 0; v <= n; ++ v) {
+			out_offset_array[v] = static_cast<long>(VECTOR(graph->os)[v]);
+			in_offset_array[v] = static_cast<long>(VECTOR(graph->is)[v]);
+		}
+		for (long k = 0; k < m; ++ k) {
+			long e = static_cast<long>(VECTOR(graph->oi)[k]);
+			out_edge_array[k] = e;
+			out_target_array[k] = static_cast<long>(to[e]);
+			e = static_cast<long>(VECTOR(graph->ii)[k]);
+			in_edge_array[k] = e;
+			in_target_array[k] = static_cast<long>(from[e]);
+		}
+	}
+
+	/**
+	 \internal
+	 For undirected graphs igraph stores every edge with from >= to. The edges
+	 stored from v therefore reach the neighbors up to v, and the edges stored
+	 to v reach the neighbors from v onwards. Listing the first group before
+	 the second gives the sorted order of igraph_neighbors().
+	 */
+	void CsrGraph::build_undirected(const igraph_t* graph) throw() {
+		long n = vertex_count, m = edge_count;
+		out_offset_array = in_offset_array = storage;
+		out_target_array = in_target_array = out_offset_array + (n + 1);
+		out_edge_array = in_edge_array = out_target_array + 2 * m;
+
+		const Real* from = VECTOR(graph->from);
+		const Real* to = VECTOR(graph->to);
+		const Real* oi = VECTOR(graph->oi);
+		const Real* ii = VECTOR(graph->ii);
+		const Real* os = VECTOR(graph->os);
+		const Real* is = VECTOR(graph->is);
+
+		long pos = 0;
+		for (long v = 0; v < n; ++ v) {
+			out_offset_array[v] = pos;
+			for (long i = static_cast<long>(os[v]), j = static_cast<long>(os[v+1]); i < j; ++ i) {
+				long e = static_cast<long>(oi[i]);
+				out_target_array[pos] = static_cast<long>(to[e]);
+				out_edge_array[pos++] = e;
+			}
+			for (long i = static_cast<long>(is[v]), j = static_cast<long>(is[v+1]); i < j; ++ i) {
+				long e = static_cast<long>(ii[i]);
+				out_target_array[pos] = static_cast<long>(from[e]);
+				out_edge_array[pos++] = e;
+			}
+		}
+		out_offset_array[n] = pos;
+	}
+
+	::tempobj::temporary_class<Graph>::type CsrGraph::graph() const MAY_THROW_EXCEPTION {
+		igraph_t _;
+		igraph_vector_t edges;
+		int errcode = igraph_vector_init(&edges, 2 * edge_count);
+		if (errcode == IGRAPH_SUCCESS) {
+			// every edge is in the out-list of its source (of both ends if undirected), which puts it back at its ID.
+			Real* res = VECTOR(edges);
+			for (long v = 0; v < vertex_count; ++ v) {
+				for (long k = out_offset_array[v]; k < out_offset_array[v+1]; ++ k) {
+					long e = out_edge_array[k];
+					res[2*e] = v;
+					res[2*e+1] = out_target_array[k];
+				}
+			}
+			errcode = igraph_create(&_, &edges, vertex_count, directed);
+			igraph_vector_destroy(&edges);
+		}
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			igraph_empty(&_, 0, directed);
+		}
+		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
+	}
+}
+
+#endif
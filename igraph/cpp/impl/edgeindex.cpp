@@ -0,0 +1,98 @@
+/*
+
+edgeindex.cpp ... Hash table from vertex pairs to edge IDs.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_EDGEINDEX_CPP
+#define IGRAPH_EDGEINDEX_CPP
+
+#include <igraph/cpp/edgeindex.hpp>
+#include <igraph/cpp/graph.hpp>
+#include <igraph/cpp/impl/graph.cpp>
+#include <algorithm>
+
+namespace igraph {
+	EdgeIndex::EdgeIndex(const Graph& g) : graph(g.get()) {
+		rebuild();
+	}
+
+	void EdgeIndex::rebuild() {
+		vertex_count = static_cast<long>(igraph_vcount(graph));
+		edge_count = static_cast<long>(igraph_ecount(graph));
+		directed = igraph_is_directed(graph);
+
+		::std::size_t capacity = XXINTRNL_vertex_pair_table_capacity(edge_count);
+		Slot empty = {-1, -1};
+		slots.assign(capacity, empty);
+		mask = capacity - 1;
+
+		// Undirected edges are stored with from >= to, which is also the key order.
+		const Real* from = VECTOR(graph->from);
+		const Real* to = VECTOR(graph->to);
+		for (long eid = 0; eid < edge_count; ++ eid) {
+			int64_t key = static_cast<int64_t>(from[eid]) * vertex_count + static_cast<int64_t>(to[eid]);
+			::std::size_t i = XXINTRNL_probe_vertex_pair(slots, mask, key);
+			if (slots[i].key == -1) {	// parallel edges keep the smallest ID.
+				slots[i].key = key;
+				slots[i].eid = eid;
+			}
+		}
+	}
+
+	bool EdgeIndex::is_stale() const throw() {
+		return vertex_count != static_cast<long>(igraph_vcount(graph)) || edge_count != static_cast<long>(igraph_ecount(graph));
+	}
+
+	long EdgeIndex::find(const long from, const long to) const throw() {
+		int64_t key = static_cast<int64_t>(from) * vertex_count + to;
+		return slots[XXINTRNL_probe_vertex_pair(slots, mask, key)].eid;
+	}
+
+	Edge EdgeIndex::get_eid(const Vertex from, const Vertex to, const Directedness arc) const throw() {
+		if (from < 0 || from >= vertex_count || to < 0 || to >= vertex_count)
+			return -1;
+		long a = static_cast<long>(from), b = static_cast<long>(to);
+		if (!directed)
+			return a >= b ? find(a, b) : find(b, a);
+		long eid = find(a, b);
+		if (eid < 0 && arc == Undirected)
+			eid = find(b, a);
+		return eid;
+	}
+
+	::tempobj::force_temporary_class<EdgeVector>::type EdgeIndex::lookup(const VertexVector& pairs, const Directedness arc) const MAY_THROW_EXCEPTION {
+		long count = pairs.size() / 2;
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, count));
+		// The slots are looked up in random order, so fetch them a few pairs ahead.
+		const long distance = 8;
+		for (long i = 0; i < count; ++ i) {
+			if (i + distance < count) {
+				int64_t a = static_cast<int64_t>(pairs[2*(i+distance)]), b = static_cast<int64_t>(pairs[2*(i+distance)+1]);
+				if (!directed && a < b)
+					::std::swap(a, b);
+				__builtin_prefetch(&slots[XXINTRNL_hash_vertex_pair(a * vertex_count + b) & mask]);
+			}
+			VECTOR(res)[i] = get_eid(pairs[2*i], pairs[2*i+1], arc);
+		}
+		return ::tempobj::force_move(EdgeVector(&res, ::tempobj::OwnershipTransferMove));
+	}
+}
+
+#endif
@@ -0,0 +1,331 @@
+/*
+
+edgestream.cpp ... Streaming, bounded-memory edge ingestion.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_EDGESTREAM_CPP
+#define IGRAPH_EDGESTREAM_CPP
+
+#include <igraph/cpp/edgestream.hpp>
+#include <igraph/cpp/graph.hpp>
+#include <igraph/cpp/impl/graphio.cpp>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace igraph {
+
+#pragma mark -
+#pragma mark EdgeStream
+
+	MEMORY_MANAGER_IMPLEMENTATION_NO_COPYING(EdgeStream);
+
+	IMPLEMENT_MOVE_METHOD(EdgeStream) {
+		fptr = ::std::move(other.fptr);
+		owns_file = ::std::move(other.owns_file);
+		buffer = ::std::move(other.buffer);
+		buffer_size = ::std::move(other.buffer_size);
+		cursor = ::std::move(other.cursor);
+		filled = ::std::move(other.filled);
+		at_eof = ::std::move(other.at_eof);
+		negative = ::std::move(other.negative);
+		batch_size = ::std::move(other.batch_size);
+	}
+	IMPLEMENT_DEALLOC_METHOD(EdgeStream) {
+		::std::free(buffer);
+		if (owns_file)
+			XXINTRNL_close_file(fptr);
+	}
+
+	EdgeStream::EdgeStream(::std::FILE* filestream, const long batch_size_, const ::std::size_t buffer_size_)
+		: fptr(filestream), owns_file(false), buffer(NULL), buffer_size(buffer_size_), batch_size(batch_size_) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(EdgeStream);
+		init_buffer();
+	}
+
+	EdgeStream::EdgeStream(const char* filename, const long batch_size_, const ::std::size_t buffer_size_)
+		: fptr(NULL), owns_file(false), buffer(NULL), buffer_size(buffer_size_), batch_size(batch_size_) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(EdgeStream);
+		init_buffer();
+		int errcode;
+		fptr = XXINTRNL_open_file(filename, false, errcode);
+		owns_file = true;
+		try {
+			TRY(errcode);
+		} catch (...) {
+			::std::free(buffer);
+			throw;
+		}
+	}
+
+	void EdgeStream::init_buffer() {
+		if (buffer_size < 2)
+			buffer_size = 2;
+		if (batch_size < 1)
+			batch_size = 1;
+		buffer = reinterpret_cast<char*>(::std::malloc(buffer_size));
+		if (buffer == NULL)
+			throw ::std::bad_alloc();
+		cursor = filled = buffer;
+		at_eof = false;
+		negative = false;
+	}
+
+	/// Move the last keep bytes to the start of the buffer, and fill the rest from the file.
+	void EdgeStream::refill(const ::std::size_t keep) throw() {
+		::std::memmove(buffer, filled - keep, keep);
+		::std::size_t count = ::std::fread(buffer + keep, 1, buffer_size - keep, fptr);
+		cursor = buffer;
+		filled = buffer + keep + count;
+		if (count == 0)
+			at_eof = true;
+	}
+
+	bool EdgeStream::next(VertexVector& batch) MAY_THROW_EXCEPTION {
+		batch.resize(2 * batch_size);
+		Vertex* res = batch.begin();
+		Vertex* const res_end = batch.end();
+
+		while (res != res_end) {
+			while (cursor != filled && !XXINTRNL_is_digit(*cursor)) {
+				negative = *cursor == '-';
+				++ cursor;
+			}
+			if (cursor == filled) {
+				if (at_eof) {
+					// a read error, e.g. a corrupt compressed file, also ends the stream.
+					if (::std::ferror(fptr))
+						TRY(IGRAPH_EFILE);
+					break;
+				}
+				refill(0);
+				continue;
+			}
+
+			const char* p = cursor;
+			while (p != filled && XXINTRNL_is_digit(*p))
+				++ p;
+			// a number touching the end of the buffer may continue in the next block.
+			::std::size_t length = p - cursor;
+			if (p == filled && !at_eof && length < buffer_size) {
+				refill(length);
+				continue;
+			}
+
+			long num = 0;
+			for (; cursor != p; ++ cursor)
+				num = num * 10 + (*cursor - '0');
+			*res++ = static_cast<Vertex>(negative ? -num : num);
+			negative = false;
+		}
+
+		long count = res - batch.begin();
+		batch.resize(count & ~1L);
+		return count >= 2;
+	}
+
+#pragma mark -
+#pragma mark GraphBuilder
+
+	MEMORY_MANAGER_IMPLEMENTATION_NO_COPYING(GraphBuilder);
+
+	IMPLEMENT_MOVE_METHOD(GraphBuilder) {
+		_ = ::std::move(other._);
+		min_size = ::std::move(other.min_size);
+		vertex_count = ::std::move(other.vertex_count);
+		built = ::std::move(other.built);
+		drop_loops = ::std::move(other.drop_loops);
+		has_range = ::std::move(other.has_range);
+		relabel_range = ::std::move(other.relabel_range);
+		range_first = ::std::move(other.range_first);
+		range_last = ::std::move(other.range_last);
+	}
+	IMPLEMENT_DEALLOC_METHOD(GraphBuilder) {
+		if (!built)
+			igraph_destroy(&_);
+	}
+
+	GraphBuilder::GraphBuilder(const Directedness directedness, const Integer size) MAY_THROW_EXCEPTION
+		: min_size(size), vertex_count(0), built(false), drop_loops(false), has_range(false), relabel_range(false), range_first(0), range_last(0) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(GraphBuilder);
+		TRY(igraph_empty(&_, 0, directedness));
+	}
+
+	GraphBuilder& GraphBuilder::drop_self_loops(const bool drop) throw() {
+		drop_loops = drop;
+		return *this;
+	}
+
+	GraphBuilder& GraphBuilder::keep_vertex_range(const Vertex first, const Vertex last, const bool relabel) throw() {
+		has_range = true;
+		relabel_range = relabel;
+		range_first = first;
+		range_last = last;
+		return *this;
+	}
+
+	/// Make room for count more edges, growing by at least 1.5 times to keep the appends amortized O(1).
+	int GraphBuilder::reserve_edges(const long count) throw() {
+		long size = igraph_vector_size(&_.from);
+		long capacity = _.from.stor_end - _.from.stor_begin;
+		if (size + count <= capacity)
+			return IGRAPH_SUCCESS;
+		long new_capacity = capacity + capacity / 2;
+		if (new_capacity < size + count)
+			new_capacity = size + count;
+		int errcode = igraph_vector_reserve(&_.from, new_capacity);
+		if (errcode == IGRAPH_SUCCESS)
+			errcode = igraph_vector_reserve(&_.to, new_capacity);
+		return errcode;
+	}
+
+	GraphBuilder& GraphBuilder::append(const Vertex* pairs, const long edge_count) MAY_THROW_EXCEPTION {
+		int errcode = reserve_edges(edge_count);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return *this;	// without exceptions, leave the graph unchanged.
+		}
+
+		// Write straight into the edge vectors, with the same orientation as
+		// igraph_add_edges(): for undirected graphs "from" is the larger ID.
+		bool directed = igraph_is_directed(&_);
+		Vertex* from = _.from.end;
+		Vertex* to = _.to.end;
+		Vertex max_vertex = vertex_count - 1;
+		const Vertex* const pairs_end = pairs + 2 * edge_count;
+		for (; pairs != pairs_end; pairs += 2) {
+			Vertex a = pairs[0], b = pairs[1];
+			if (a < 0 || b < 0)
+				continue;
+			if (drop_loops && a == b)
+				continue;
+			if (has_range) {
+				if (a < range_first || a > range_last || b < range_first || b > range_last)
+					continue;
+				if (relabel_range) {
+					a -= range_first;
+					b -= range_first;
+				}
+			}
+			if (!directed && a < b) {
+				Vertex temp = a;
+				a = b;
+				b = temp;
+			}
+			*from++ = a;
+			*to++ = b;
+			if (a > max_vertex)
+				max_vertex = a;
+			if (b > max_vertex)
+				max_vertex = b;
+		}
+		_.from.end = from;
+		_.to.end = to;
+		vertex_count = max_vertex + 1;
+		return *this;
+	}
+
+	GraphBuilder& GraphBuilder::append(const VertexVector& pairs) MAY_THROW_EXCEPTION {
+		return append(pairs.begin(), pairs.size() / 2);
+	}
+
+	GraphBuilder& GraphBuilder::append(EdgeStream& stream) MAY_THROW_EXCEPTION {
+		VertexVector batch;
+		while (stream.next(batch))
+			append(batch);
+		return *this;
+	}
+
+	Integer GraphBuilder::vcount() const throw() {
+		Integer n = vertex_count;
+		if (n < min_size)
+			n = min_size;
+		if (has_range && relabel_range && n < range_last - range_first + 1)
+			n = range_last - range_first + 1;
+		return n;
+	}
+
+	Integer GraphBuilder::ecount() const throw() {
+		return igraph_vector_size(&_.from);
+	}
+
+	/**
+	 \brief Build the index of the edges appended to graph->from and graph->to.
+	 
+	 An attached attribute handler has to be told about new edges, so in that
+	 case the edges are taken out and added again through igraph_add_edges().
+	 */
+	static int XXINTRNL_index_appended_edges(igraph_t* graph) throw() {
+		igraph_vector_t edges;
+		int errcode;
+		if (graph->attr == NULL) {
+			// igraph_add_edges() re-indexes all of "from" and "to", so adding
+			// no edges builds the index for everything appended.
+			errcode = igraph_vector_init(&edges, 0);
+			if (errcode == IGRAPH_SUCCESS) {
+				errcode = igraph_add_edges(graph, &edges, 0);
+				igraph_vector_destroy(&edges);
+			}
+			return errcode;
+		}
+		
+		long count = igraph_vector_size(&graph->from);
+		errcode = igraph_vector_init(&edges, 2 * count);
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		Real* edge = VECTOR(edges);
+		for (long i = 0; i < count; ++ i) {
+			*edge++ = VECTOR(graph->from)[i];
+			*edge++ = VECTOR(graph->to)[i];
+		}
+		igraph_vector_clear(&graph->from);
+		igraph_vector_clear(&graph->to);
+		errcode = igraph_add_edges(graph, &edges, 0);
+		if (errcode != IGRAPH_SUCCESS) {
+			// the vectors kept their storage, so putting the edges back cannot fail.
+			igraph_vector_resize(&graph->from, count);
+			igraph_vector_resize(&graph->to, count);
+			for (long i = 0; i < count; ++ i) {
+				VECTOR(graph->from)[i] = VECTOR(edges)[2*i];
+				VECTOR(graph->to)[i] = VECTOR(edges)[2*i+1];
+			}
+		}
+		igraph_vector_destroy(&edges);
+		return errcode;
+	}
+	
+	::tempobj::temporary_class<Graph>::type GraphBuilder::build() MAY_THROW_EXCEPTION {
+		int errcode = IGRAPH_SUCCESS;
+		Integer n = vcount();
+		if (n > _.n)
+			errcode = igraph_add_vertices(&_, n - _.n, 0);
+		if (errcode == IGRAPH_SUCCESS)
+			errcode = XXINTRNL_index_appended_edges(&_);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			// without exceptions, the builder keeps its edges and the result is empty.
+			return ::tempobj::force_move(Graph(0, igraph_is_directed(&_) ? Directed : Undirected));
+		}
+		
+		built = true;
+		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
+	}
+}
+
+#endif
@@ -24,9 +24,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <igraph/cpp/graph.hpp>
 #include <igraph/cpp/adjlist.hpp>
+#include <igraph/cpp/csrgraph.hpp>
+#include <igraph/cpp/sparsematrix.hpp>
+#include <igraph/cpp/graphbatch.hpp>
 #include <gsl/cpp/rng_minimal.hpp>
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include <igraph/cpp/impl/igraph_extension.cpp>
 
 namespace igraph {
@@ -53,6 +58,30 @@ namespace igraph {
 	}
 
 
+	/// Create a graph with n vertices and room for m edges in its edge vectors, to be written directly and then indexed with XXINTRNL_reindex_edges().
+	static int XXINTRNL_empty_with_edges(igraph_t* graph, const Integer n, const Directedness directedness, const long m) throw() {
+		int errcode = igraph_empty(graph, n, directedness);
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		errcode = igraph_vector_resize(&graph->from, m);
+		if (errcode == IGRAPH_SUCCESS)
+			errcode = igraph_vector_resize(&graph->to, m);
+		if (errcode != IGRAPH_SUCCESS)
+			igraph_destroy(graph);
+		return errcode;
+	}
+	
+	/// Rebuild the index of a graph whose edge vectors were written directly. igraph_add_edges() re-indexes all edges, so adding none is enough.
+	static int XXINTRNL_reindex_edges(igraph_t* graph) throw() {
+		igraph_vector_t no_edges;
+		int errcode = igraph_vector_init(&no_edges, 0);
+		if (errcode == IGRAPH_SUCCESS) {
+			errcode = igraph_add_edges(graph, &no_edges, 0);
+			igraph_vector_destroy(&no_edges);
+		}
+		return errcode;
+	}
+
 	Graph::Graph(Integer size, Directedness directedness) MAY_THROW_EXCEPTION {
 		XXINTRNL_DEBUG_CALL_INITIALIZER(Graph);
 		TRY(igraph_empty(&_, size, directedness));
@@ -88,11 +117,99 @@ namespace igraph {
 		return ::tempobj::force_move(EdgeVector(&res, ::tempobj::OwnershipTransferMove));
 	}
 
+	/**
+	 \internal
+	 Write the neighbors of v, or the IDs of its edges, in the order of
+	 igraph_neighbors() and igraph_adjacent(): the out-list of the index, then
+	 the in-list. igraph_neighbors() merges the two lists by neighbor; for
+	 undirected graphs that is the same as appending them.
+	 */
+	template <typename T>
+	static void XXINTRNL_incident_ids(const igraph_t* graph, const Vertex vid, NeighboringMode mode, const bool edges, IdVector<T>& res) MAY_THROW_EXCEPTION {
+		if (vid < 0 || vid >= igraph_vcount(graph)) {
+			res.clear();
+			TRY(IGRAPH_EINVVID);
+			return;
+		}
+		if (!igraph_is_directed(graph))
+			mode = AllNeighbors;
+		long v = static_cast<long>(vid);
+		const Real* oi = VECTOR(graph->oi);
+		const Real* ii = VECTOR(graph->ii);
+		const Real* from = VECTOR(graph->from);
+		const Real* to = VECTOR(graph->to);
+		long i = 0, i_end = 0, j = 0, j_end = 0;
+		if (mode != InNeighbors) {
+			i = static_cast<long>(VECTOR(graph->os)[v]);
+			i_end = static_cast<long>(VECTOR(graph->os)[v+1]);
+		}
+		if (mode != OutNeighbors) {
+			j = static_cast<long>(VECTOR(graph->is)[v]);
+			j_end = static_cast<long>(VECTOR(graph->is)[v+1]);
+		}
+		
+		long size = (i_end - i) + (j_end - j);
+		if (res.resize(size).size() != size)
+			return;
+		T* out = res.begin();
+		while (!edges && i < i_end && j < j_end) {
+			Real a = to[static_cast<long>(oi[i])], b = from[static_cast<long>(ii[j])];
+			if (a <= b) {
+				*out++ = static_cast<T>(a);
+				++ i;
+			} else {
+				*out++ = static_cast<T>(b);
+				++ j;
+			}
+		}
+		for (; i < i_end; ++ i)
+			*out++ = static_cast<T>(edges ? oi[i] : to[static_cast<long>(oi[i])]);
+		for (; j < j_end; ++ j)
+			*out++ = static_cast<T>(edges ? ii[j] : from[static_cast<long>(ii[j])]);
+	}
+	
+	template <typename T>
+	void Graph::neighbors(const Vertex vid, IdVector<T>& res, NeighboringMode neimode) const MAY_THROW_EXCEPTION {
+		XXINTRNL_incident_ids(&_, vid, neimode, false, res);
+	}
+	template <typename T>
+	void Graph::adjacent(const Vertex vid, IdVector<T>& res, NeighboringMode neimode) const MAY_THROW_EXCEPTION {
+		XXINTRNL_incident_ids(&_, vid, neimode, true, res);
+	}
+	
 	Integer Graph::degree_of(Vertex i, NeighboringMode neimode, SelfLoops countLoops) const MAY_THROW_EXCEPTION {
+		if (i < 0 || i >= igraph_vcount(&_)) {
+			TRY(IGRAPH_EINVVID);
+			return 0;
+		}
+		
+		// with self-loops counted, the degree is just the size of the vertex's range in the index.
+		if (countLoops == ContainSelfLoops) {
+			long v = static_cast<long>(i);
+			Integer out_degree = VECTOR(_.os)[v+1] - VECTOR(_.os)[v];
+			Integer in_degree = VECTOR(_.is)[v+1] - VECTOR(_.is)[v];
+			if (!igraph_is_directed(&_))
+				return out_degree + in_degree;
+			switch (neimode) {
+				case OutNeighbors: return out_degree;
+				case InNeighbors: return in_degree;
+				default: return out_degree + in_degree;
+			}
+		}
+		
 		igraph_vector_t res;
-		TRY(igraph_vector_init(&res, 1));
-		TRY(igraph_degree(&_, &res, igraph_vss_1(i), (igraph_neimode_t)neimode, countLoops));
+		int errcode = igraph_vector_init(&res, 1);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return 0;
+		}
+		errcode = igraph_degree(&_, &res, igraph_vss_1(i), (igraph_neimode_t)neimode, countLoops);
 		Integer resdeg = VECTOR(res)[0];
+		igraph_vector_destroy(&res);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return 0;
+		}
 		return resdeg;
 	}
 	::tempobj::force_temporary_class<Vector>::type Graph::degree(const VertexSelector& vids, NeighboringMode neimode, SelfLoops countLoops) const MAY_THROW_EXCEPTION {
@@ -136,6 +253,10 @@ namespace igraph {
 		return *this;
 	}
 
+	::tempobj::temporary_class<GraphBatch>::type Graph::begin_batch() {
+		return ::tempobj::force_move(GraphBatch(&_));
+	}
+
 #pragma mark -
 #pragma mark Deterministic Graph Generators
 
@@ -149,6 +270,47 @@ namespace igraph {
 		TRY(igraph_create(&_, &edges._, min_size, directedness));
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
+	template <typename T>
+	::tempobj::force_temporary_class<Graph>::type Graph::create(const IdVector<T>& edges, const Integer min_size, const Directedness directedness) MAY_THROW_EXCEPTION {
+		if (edges.size() % 2 != 0) {
+			TRY(IGRAPH_EINVEVECTOR);
+			return ::tempobj::force_move(Graph(min_size, directedness));
+		}
+		long m = edges.size() / 2;
+		T max_id = -1;
+		for (const T* p = edges.begin(); p != edges.end(); ++ p) {
+			if (*p < 0) {
+				TRY(IGRAPH_EINVVID);
+				return ::tempobj::force_move(Graph(min_size, directedness));
+			}
+			if (*p > max_id)
+				max_id = *p;
+		}
+		Integer n = max_id + 1 > min_size ? static_cast<Integer>(max_id + 1) : min_size;
+		
+		igraph_t _;
+		int errcode = XXINTRNL_empty_with_edges(&_, n, directedness, m);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return ::tempobj::force_move(Graph(min_size, directedness));
+		}
+		// Write with the orientation of igraph_add_edges(): for undirected graphs "from" is the larger ID.
+		Vertex* from = VECTOR(_.from);
+		Vertex* to = VECTOR(_.to);
+		const T* pairs = edges.begin();
+		for (long eid = 0; eid < m; ++ eid, pairs += 2) {
+			bool swap = directedness == Undirected && pairs[1] > pairs[0];
+			from[eid] = pairs[swap ? 1 : 0];
+			to[eid] = pairs[swap ? 0 : 1];
+		}
+		errcode = XXINTRNL_reindex_edges(&_);
+		if (errcode != IGRAPH_SUCCESS) {
+			igraph_destroy(&_);
+			TRY(errcode);
+			return ::tempobj::force_move(Graph(min_size, directedness));
+		}
+		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
+	}
 	::tempobj::force_temporary_class<Graph>::type Graph::adjacency(Matrix& adjmatrix, AdjacencyMode mode) MAY_THROW_EXCEPTION  {
 		XXINTRNL_FORWARD_GRAPH_CREATION(_, igraph_adjacency(&_, &adjmatrix._, (igraph_adjacency_t)mode) );
 	}
@@ -160,6 +322,66 @@ namespace igraph {
 		TRY(igraph_adjlist(&_, &lst._, directedness, duplicate_edges == ToUndirectedMode_Each));
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
+	::tempobj::force_temporary_class<Graph>::type Graph::adjlist(const FlatAdjacencyList& lst, const Directedness directedness, const ToUndirectedMode duplicate_edges) MAY_THROW_EXCEPTION {
+		long n = static_cast<long>(lst.size());
+		const long* offsets = lst.offsets();
+		const Vertex* neighbors = lst.neighbors();
+		bool halve = directedness == Undirected && duplicate_edges == ToUndirectedMode_Each;
+		
+		// with halve, a neighbor u > v is the other copy of an edge already counted at u, and a self-loop counts half.
+		long m = 0;
+		for (long v = 0; v < n; ++ v) {
+			long loops = 0;
+			for (long k = offsets[v]; k < offsets[v+1]; ++ k) {
+				if (!halve || neighbors[k] < v)
+					++ m;
+				else if (neighbors[k] == v)
+					++ loops;
+			}
+			m += loops / 2;
+		}
+		
+		igraph_t _;
+		int errcode = XXINTRNL_empty_with_edges(&_, lst.size(), directedness, m);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return ::tempobj::force_move(Graph(lst.size(), directedness));
+		}
+		
+		// Write with the orientation of igraph_add_edges(): for undirected graphs "from" is the larger ID.
+		Vertex* from = VECTOR(_.from);
+		Vertex* to = VECTOR(_.to);
+		long eid = 0;
+		for (long v = 0; v < n; ++ v) {
+			long loops = 0;
+			for (long k = offsets[v]; k < offsets[v+1]; ++ k) {
+				Vertex u = neighbors[k];
+				if (halve && u >= v) {
+					if (u == v && ++ loops % 2 == 0) {
+						from[eid] = to[eid] = v;
+						++ eid;
+					}
+					continue;
+				}
+				if (directedness == Undirected && u > v) {
+					from[eid] = u;
+					to[eid] = v;
+				} else {
+					from[eid] = v;
+					to[eid] = u;
+				}
+				++ eid;
+			}
+		}
+		
+		errcode = XXINTRNL_reindex_edges(&_);
+		if (errcode != IGRAPH_SUCCESS) {
+			igraph_destroy(&_);
+			TRY(errcode);
+			return ::tempobj::force_move(Graph(lst.size(), directedness));
+		}
+		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
+	}
 	
 	::tempobj::force_temporary_class<Graph>::type Graph::star(const Integer n, const StarMode mode, const Vertex center) MAY_THROW_EXCEPTION {
 		igraph_t _;
@@ -383,17 +605,151 @@ namespace igraph {
 		return *this;
 	}
 	Graph& Graph::rewire_edges_simple(const Real prob) MAY_THROW_EXCEPTION { return rewire_edges_simple(::gsl::Random::default_generator(), prob); }
+	/**
+	 \internal
+	 Open-addressing hash tables keyed by the vertex pair (a, b), packed as
+	 a * vertex_count + b. Slots are any struct with an int64_t \c key, which
+	 is -1 if the slot is empty, and are probed linearly.
+	 */
+	static inline ::std::size_t XXINTRNL_hash_vertex_pair(const int64_t key) throw() {
+		uint64_t h = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL;
+		return static_cast< ::std::size_t>(h >> 32);
+	}
+	/// The number of slots which keeps the load factor of max_keys at most 1/2.
+	static inline ::std::size_t XXINTRNL_vertex_pair_table_capacity(const long max_keys) throw() {
+		::std::size_t capacity = 16;
+		while (capacity < 2 * static_cast< ::std::size_t>(max_keys))
+			capacity *= 2;
+		return capacity;
+	}
+	/// The slot holding key, or the empty slot where it would go.
+	template <typename Slot>
+	static inline ::std::size_t XXINTRNL_probe_vertex_pair(const ::std::vector<Slot>& slots, const ::std::size_t mask, const int64_t key) throw() {
+		::std::size_t i = XXINTRNL_hash_vertex_pair(key) & mask;
+		while (slots[i].key != -1 && slots[i].key != key)
+			i = (i + 1) & mask;
+		return i;
+	}
+
+	/**
+	 \internal
+	 A multiset of vertex pairs, as an open-addressing hash table with linear
+	 probing. Keys are never removed, only their count drops to 0, so the
+	 table must be created large enough for every key ever inserted.
+	 */
+	class XXINTRNL_VertexPairCounter {
+	private:
+		struct Slot {
+			int64_t key;	// -1 if empty.
+			long count;
+		};
+		::std::vector<Slot> slots;
+		::std::size_t mask;
+		int64_t vertex_count;
+
+		/// The slot of the pair, or the empty slot where it would go.
+		Slot& find(const long a, const long b) {
+			return slots[XXINTRNL_probe_vertex_pair(slots, mask, a * vertex_count + b)];
+		}
+
+	public:
+		XXINTRNL_VertexPairCounter(const long n, const long max_keys) : vertex_count(n) {
+			::std::size_t capacity = XXINTRNL_vertex_pair_table_capacity(max_keys);
+			Slot empty = {-1, 0};
+			slots.assign(capacity, empty);
+			mask = capacity - 1;
+		}
+
+		bool contains(const long a, const long b) { return find(a, b).count > 0; }
+		/// Returns whether the pair was absent before.
+		bool insert(const long a, const long b) {
+			Slot& slot = find(a, b);
+			slot.key = a * vertex_count + b;
+			return slot.count ++ == 0;
+		}
+		/// Returns whether the pair is absent now.
+		bool remove(const long a, const long b) { return -- find(a, b).count == 0; }
+	};
+
+	/**
+	 \internal
+	 Each selected edge (head, tail) becomes (head, x), with x drawn uniformly
+	 from the vertices which are neither head nor adjacent to head. x is found
+	 by drawing from all vertices and rejecting the bad ones against a hash
+	 set of the current edges. Edges whose head is adjacent to every vertex are
+	 kept.
+
+	 The new endpoints are written into the edge vectors in place, so the
+	 edge IDs and attributes stay the same, and the graph is re-indexed once.
+	 If that fails, the old endpoints are put back.
+	 */
 	Graph& Graph::rewire_edges_simple(const ::gsl::Random& rangen, const Real prob) MAY_THROW_EXCEPTION {
-		// Will this create some sort of bias?
-		for (long eid = ecount()-1; eid >= 0; -- eid) {
-			if (rangen.uniform() < prob) {
-				Vertex head, tail;
-				edge(eid, head, tail);
-				VertexVector nonadj_vertices = VertexSelector::nonadj(head, OutNeighbors).as_vector(*this).remove_first_matching_assume_sorted(head);
-				delete_edge(eid);
-				add_edge(head, nonadj_vertices[rangen.uniform_int(nonadj_vertices.size())]);
+		long n = size(), m = edges();
+		bool directed = igraph_is_directed(&_);
+		Vertex* from = VECTOR(_.from);
+		Vertex* to = VECTOR(_.to);
+
+		::std::vector<long> selected;
+		for (long eid = 0; eid < m; ++ eid)
+			if (rangen.uniform() < prob)
+				selected.push_back(eid);
+		if (selected.empty())
+			return *this;
+
+		// An undirected pair is keyed by (larger ID, smaller ID), the same as igraph stores it.
+		XXINTRNL_VertexPairCounter pairs (n, m + static_cast<long>(selected.size()));
+		::std::vector<long> distinct_neighbors (n, 0);	// not counting the vertex itself.
+		for (long eid = 0; eid < m; ++ eid) {
+			long a = static_cast<long>(from[eid]), b = static_cast<long>(to[eid]);
+			if (pairs.insert(a, b) && a != b) {
+				++ distinct_neighbors[a];
+				if (!directed)
+					++ distinct_neighbors[b];
 			}
 		}
+
+		// igraph keeps the old index if re-indexing fails, so the old endpoints are kept to match it.
+		::std::vector<Vertex> old_endpoints (2 * selected.size());
+		for (::std::size_t k = 0; k < selected.size(); ++ k) {
+			old_endpoints[2*k] = from[selected[k]];
+			old_endpoints[2*k+1] = to[selected[k]];
+		}
+
+		for (::std::vector<long>::const_iterator cit = selected.begin(); cit != selected.end(); ++ cit) {
+			long eid = *cit;
+			long head = static_cast<long>(from[eid]), tail = static_cast<long>(to[eid]);
+			if (distinct_neighbors[head] >= n - 1)
+				continue;
+
+			long target, a, b;
+			do {
+				target = static_cast<long>(rangen.uniform_int(n));
+				a = head, b = target;
+				if (!directed && a < b)
+					::std::swap(a, b);
+			} while (target == head || pairs.contains(a, b));
+
+			if (pairs.remove(head, tail) && head != tail) {
+				-- distinct_neighbors[head];
+				if (!directed)
+					-- distinct_neighbors[tail];
+			}
+			pairs.insert(a, b);	// always new, and target != head.
+			++ distinct_neighbors[head];
+			if (!directed)
+				++ distinct_neighbors[target];
+			from[eid] = a;
+			to[eid] = b;
+		}
+
+		int errcode = XXINTRNL_reindex_edges(&_);
+		if (errcode != IGRAPH_SUCCESS) {
+			for (::std::size_t k = 0; k < selected.size(); ++ k) {
+				from[selected[k]] = old_endpoints[2*k];
+				to[selected[k]] = old_endpoints[2*k+1];
+			}
+			TRY(errcode);
+		}
 		return *this;
 	}
 
@@ -548,6 +904,27 @@ namespace igraph {
 	::tempobj::force_temporary_class<VertexVector>::type Graph::subcomponent(const Vertex representative, const NeighboringMode mode) const MAY_THROW_EXCEPTION {
 		XXINTRNL_TEMP_RETURN_VECTOR(res, igraph_subcomponent(&_, &res, representative, (igraph_neimode_t)mode));
 	}
+	/// Breadth-first search as igraph_subcomponent(), with the result itself as the queue.
+	template <typename T>
+	void Graph::subcomponent(const Vertex representative, IdVector<T>& res, const NeighboringMode mode) const MAY_THROW_EXCEPTION {
+		res.clear();
+		if (representative < 0 || representative >= igraph_vcount(&_)) {
+			TRY(IGRAPH_EINVVID);
+			return;
+		}
+		::std::vector<char> added (static_cast<long>(igraph_vcount(&_)), 0);
+		IdVector<T> nei;
+		res.push_back(static_cast<T>(representative));
+		added[static_cast<long>(representative)] = 1;
+		for (long head = 0; head < res.size(); ++ head) {
+			neighbors(res[head], nei, mode);
+			for (const T* p = nei.begin(); p != nei.end(); ++ p)
+				if (!added[*p]) {
+					added[*p] = 1;
+					res.push_back(*p);
+				}
+		}
+	}
 	::tempobj::force_temporary_class<Graph>::type Graph::subgraph(const VertexSelector& vids) const MAY_THROW_EXCEPTION {
 		XXINTRNL_FORWARD_GRAPH_CREATION(res, igraph_subgraph(&_, &res, vids._) );
 	}
@@ -678,6 +1055,182 @@ namespace igraph {
 	::tempobj::force_temporary_class<Matrix>::type Graph::similarity_dice(const VertexSelector& vids, NeighboringMode neimode, SelfLoops countloops) const MAY_THROW_EXCEPTION {
 		XXINTRNL_TEMP_RETURN_MATRIX(res, igraph_similarity_dice(&_, &res, vids._, (igraph_neimode_t)neimode, countloops));
 	}
+	
+	static inline NeighboringMode XXINTRNL_reverse_mode(const NeighboringMode mode) throw() {
+		return mode == OutNeighbors ? InNeighbors : mode == InNeighbors ? OutNeighbors : AllNeighbors;
+	}
+	
+	/**
+	 \internal
+	 The rows of igraph_cocitation_real() for the vertices of vids. igraph adds
+	 1 to (u, v) for any two positions of u and v in neighbors(f, mode), for
+	 every vertex f. So the row of x only depends on the vertices f which list
+	 x: each vertex listed by such an f gets the number of times f lists x,
+	 except that a position of x is not paired with itself.
+	 */
+	static void XXINTRNL_cocitation_rows(const igraph_t* graph, const VertexVector& vids, const NeighboringMode mode, SparseMatrix& res) {
+		long n = static_cast<long>(igraph_vcount(graph));
+		XXINTRNL_SparseAccumulator row (n);
+		::std::vector<long> seen (n, -1);
+		for (long k = 0; k < vids.size(); ++ k) {
+			long x = static_cast<long>(vids[k]);
+			NeighborView listers (graph, x, XXINTRNL_reverse_mode(mode));
+			for (NeighborView::iterator it = listers.begin(); it != listers.end(); ++ it) {
+				long f = static_cast<long>(*it);
+				if (seen[f] == k)
+					continue;
+				seen[f] = k;
+				NeighborView listed (graph, f, mode);
+				long times = 0;
+				for (NeighborView::iterator jt = listed.begin(); jt != listed.end(); ++ jt)
+					if (*jt == x)
+						++ times;
+				for (NeighborView::iterator jt = listed.begin(); jt != listed.end(); ++ jt)
+					row.add(static_cast<long>(*jt), times);
+				row.add(x, -times);
+			}
+			row.flush(res);
+		}
+	}
+	
+	/// \internal The neighbor set of igraph_similarity_jaccard(): no repeated vertices, and v itself only if loops are counted.
+	static void XXINTRNL_neighbor_set(const igraph_t* graph, const long v, const NeighboringMode mode, const SelfLoops loops, ::std::vector<long>& mark, long& stamp, ::std::vector<long>& set) {
+		++ stamp;
+		set.clear();
+		mark[v] = stamp;
+		if (loops)
+			set.push_back(v);
+		NeighborView nei (graph, v, mode);
+		for (NeighborView::iterator it = nei.begin(); it != nei.end(); ++ it) {
+			long u = static_cast<long>(*it);
+			if (mark[u] != stamp) {
+				mark[u] = stamp;
+				set.push_back(u);
+			}
+		}
+	}
+	
+	/**
+	 \internal
+	 The rows of igraph_similarity_jaccard(), or of igraph_similarity_dice(),
+	 for the vertices of vids. Two vertices are similar only if some vertex w
+	 is in both neighbor sets, so the vertices similar to x are found from the
+	 vertices listing each w of the set of x, and the size of the intersection
+	 is the number of such w.
+	 */
+	static void XXINTRNL_similarity_rows(const igraph_t* graph, const VertexVector& vids, const NeighboringMode mode, const SelfLoops loops, const bool dice, SparseMatrix& res) {
+		long n = static_cast<long>(igraph_vcount(graph)), count = vids.size();
+		
+		// the positions of each vertex in vids, as linked lists.
+		::std::vector<long> first_position (n, -1), next_position (count);
+		for (long k = count - 1; k >= 0; -- k) {
+			long v = static_cast<long>(vids[k]);
+			next_position[k] = first_position[v];
+			first_position[v] = k;
+		}
+		
+		::std::vector<long> mark (n, -1), set, set_size (n, 0);
+		long stamp = 0;
+		for (long v = 0; v < n; ++ v)
+			if (first_position[v] >= 0) {
+				XXINTRNL_neighbor_set(graph, v, mode, loops, mark, stamp, set);
+				set_size[v] = static_cast<long>(set.size());
+			}
+		
+		XXINTRNL_SparseAccumulator row (count);
+		::std::vector<long> shared (n, 0), seen (n, -1), similar;
+		long seen_stamp = 0;
+		for (long i = 0; i < count; ++ i) {
+			long x = static_cast<long>(vids[i]);
+			XXINTRNL_neighbor_set(graph, x, mode, loops, mark, stamp, set);
+			for (::std::vector<long>::const_iterator w = set.begin(); w != set.end(); ++ w) {
+				++ seen_stamp;
+				if (loops && first_position[*w] >= 0) {	// w is in its own set.
+					seen[*w] = seen_stamp;
+					if (shared[*w]++ == 0)
+						similar.push_back(*w);
+				}
+				NeighborView listers (graph, *w, XXINTRNL_reverse_mode(mode));
+				for (NeighborView::iterator it = listers.begin(); it != listers.end(); ++ it) {
+					long y = static_cast<long>(*it);
+					if (y == *w || seen[y] == seen_stamp || first_position[y] < 0)
+						continue;
+					seen[y] = seen_stamp;
+					if (shared[y]++ == 0)
+						similar.push_back(y);
+				}
+			}
+			
+			row.add(i, 1);
+			for (::std::vector<long>::const_iterator y = similar.begin(); y != similar.end(); ++ y) {
+				Real jaccard = static_cast<Real>(shared[*y]) / (set_size[x] + set_size[*y] - shared[*y]);
+				Real value = dice ? 2 * jaccard / (1 + jaccard) : jaccard;
+				for (long p = first_position[*y]; p >= 0; p = next_position[p])
+					if (p != i)
+						row.add(p, value);
+				shared[*y] = 0;
+			}
+			similar.clear();
+			row.flush(res);
+		}
+	}
+	
+	/// \internal Whether every ID of vids is a vertex. igraph lets NaN IDs through, which cannot be converted to an index.
+	static bool XXINTRNL_all_vertices(const VertexVector& vids, const long n) throw() {
+		for (long k = 0; k < vids.size(); ++ k)
+			if (!(vids[k] >= 0 && vids[k] < n))
+				return false;
+		return true;
+	}
+	
+	::tempobj::force_temporary_class<SparseMatrix>::type Graph::bibcoupling_sparse(const VertexSelector& vids) const MAY_THROW_EXCEPTION {
+		VertexVector vs = vids.as_vector(*this);
+		long n = static_cast<long>(igraph_vcount(&_));
+		SparseMatrix res (vs.size(), n);
+		if (!XXINTRNL_all_vertices(vs, n)) {
+			TRY(IGRAPH_EINVVID);
+			return ::tempobj::force_move(res);
+		}
+		res.reset(vs.size(), n);
+		XXINTRNL_cocitation_rows(&_, vs, InNeighbors, res);
+		return ::tempobj::force_move(res);
+	}
+	::tempobj::force_temporary_class<SparseMatrix>::type Graph::cocitation_sparse(const VertexSelector& vids) const MAY_THROW_EXCEPTION {
+		VertexVector vs = vids.as_vector(*this);
+		long n = static_cast<long>(igraph_vcount(&_));
+		SparseMatrix res (vs.size(), n);
+		if (!XXINTRNL_all_vertices(vs, n)) {
+			TRY(IGRAPH_EINVVID);
+			return ::tempobj::force_move(res);
+		}
+		res.reset(vs.size(), n);
+		XXINTRNL_cocitation_rows(&_, vs, OutNeighbors, res);
+		return ::tempobj::force_move(res);
+	}
+	::tempobj::force_temporary_class<SparseMatrix>::type Graph::similarity_jaccard_sparse(const VertexSelector& vids, NeighboringMode neimode, SelfLoops countloops) const MAY_THROW_EXCEPTION {
+		VertexVector vs = vids.as_vector(*this);
+		long n = static_cast<long>(igraph_vcount(&_));
+		SparseMatrix res (vs.size(), vs.size());
+		if (!XXINTRNL_all_vertices(vs, n)) {
+			TRY(IGRAPH_EINVVID);
+			return ::tempobj::force_move(res);
+		}
+		res.reset(vs.size(), vs.size());
+		XXINTRNL_similarity_rows(&_, vs, neimode, countloops, false, res);
+		return ::tempobj::force_move(res);
+	}
+	::tempobj::force_temporary_class<SparseMatrix>::type Graph::similarity_dice_sparse(const VertexSelector& vids, NeighboringMode neimode, SelfLoops countloops) const MAY_THROW_EXCEPTION {
+		VertexVector vs = vids.as_vector(*this);
+		long n = static_cast<long>(igraph_vcount(&_));
+		SparseMatrix res (vs.size(), vs.size());
+		if (!XXINTRNL_all_vertices(vs, n)) {
+			TRY(IGRAPH_EINVVID);
+			return ::tempobj::force_move(res);
+		}
+		res.reset(vs.size(), vs.size());
+		XXINTRNL_similarity_rows(&_, vs, neimode, countloops, true, res);
+		return ::tempobj::force_move(res);
+	}
 	::tempobj::force_temporary_class<Matrix>::type Graph::similarity_inverse_log_weighted(const VertexSelector& vids, NeighboringMode neimode) const MAY_THROW_EXCEPTION {
 		XXINTRNL_TEMP_RETURN_MATRIX(res, igraph_similarity_inverse_log_weighted(&_, &res, vids._, (igraph_neimode_t)neimode));
 	}
@@ -736,6 +1289,59 @@ namespace igraph {
 	::tempobj::force_temporary_class<Matrix>::type Graph::laplacian(Boolean normalized) const MAY_THROW_EXCEPTION {
 		XXINTRNL_TEMP_RETURN_MATRIX(res, igraph_laplacian(&_, &res, normalized));
 	}
+	/// The same entries as igraph_laplacian(), from a list of (row, column, value) entries.
+	::tempobj::force_temporary_class<SparseMatrix>::type Graph::laplacian_sparse(Boolean normalized) const MAY_THROW_EXCEPTION {
+		long n = static_cast<long>(igraph_vcount(&_)), m = static_cast<long>(igraph_ecount(&_));
+		bool directed = igraph_is_directed(&_);
+		const Real* from = VECTOR(_.from);
+		const Real* to = VECTOR(_.to);
+		
+		// the out-degree without loops, as igraph_laplacian().
+		::std::vector<Real> degree (n, 0);
+		for (long eid = 0; eid < m; ++ eid) {
+			long a = static_cast<long>(from[eid]), b = static_cast<long>(to[eid]);
+			if (a != b) {
+				++ degree[a];
+				if (!directed)
+					++ degree[b];
+			}
+		}
+		
+		::std::vector<long> rows, cols;
+		::std::vector<Real> values;
+		rows.reserve(n + 2*m);
+		cols.reserve(n + 2*m);
+		values.reserve(n + 2*m);
+		for (long i = 0; i < n; ++ i) {
+			if (degree[i] == 0)
+				continue;
+			rows.push_back(i);
+			cols.push_back(i);
+			if (!normalized)
+				values.push_back(degree[i]);
+			else {
+				values.push_back(1);
+				degree[i] = directed ? 1 / degree[i] : 1 / ::std::sqrt(degree[i]);
+			}
+		}
+		for (long eid = 0; eid < m; ++ eid) {
+			long a = static_cast<long>(from[eid]), b = static_cast<long>(to[eid]);
+			if (a == b)
+				continue;
+			Real weight = !normalized ? 1 : directed ? degree[a] : degree[a] * degree[b];
+			rows.push_back(a);
+			cols.push_back(b);
+			values.push_back(-weight);
+			if (!directed) {
+				rows.push_back(b);
+				cols.push_back(a);
+				values.push_back(-weight);
+			}
+		}
+		SparseMatrix res;
+		res.assign_triplets(n, n, rows, cols, values);
+		return ::tempobj::force_move(res);
+	}
 
 
 #pragma mark -
@@ -851,9 +1457,57 @@ namespace igraph {
 	::tempobj::force_temporary_class<Matrix>::type Graph::get_adjacency(GetAdjacency type) const MAY_THROW_EXCEPTION {
 		XXINTRNL_TEMP_RETURN_MATRIX(res, igraph_get_adjacency(&_, &res, (igraph_get_adjacency_t)type));
 	}
+	/// The same entries as igraph_get_adjacency(), from a list of (row, column, 1) entries.
+	::tempobj::force_temporary_class<SparseMatrix>::type Graph::get_adjacency_sparse(GetAdjacency type) const MAY_THROW_EXCEPTION {
+		long n = static_cast<long>(igraph_vcount(&_)), m = static_cast<long>(igraph_ecount(&_));
+		bool directed = igraph_is_directed(&_);
+		const Real* from = VECTOR(_.from);
+		const Real* to = VECTOR(_.to);
+		::std::vector<long> rows, cols;
+		rows.reserve(2*m);
+		cols.reserve(2*m);
+		for (long eid = 0; eid < m; ++ eid) {
+			long a = static_cast<long>(from[eid]), b = static_cast<long>(to[eid]);
+			if (!directed && type == GetAdjacency_Upper && a > b)
+				::std::swap(a, b);
+			else if (!directed && type == GetAdjacency_Lower && a < b)
+				::std::swap(a, b);
+			rows.push_back(a);
+			cols.push_back(b);
+			if (!directed && type == GetAdjacency_Both && a != b) {	// a self-loop is counted once.
+				rows.push_back(b);
+				cols.push_back(a);
+			}
+		}
+		SparseMatrix res;
+		res.assign_triplets(n, n, rows, cols, ::std::vector<Real>(rows.size(), 1));
+		return ::tempobj::force_move(res);
+	}
 	::tempobj::force_temporary_class<Vector>::type Graph::get_edgelist(EdgelistSequenceOrdering bycol) const MAY_THROW_EXCEPTION {
 		XXINTRNL_TEMP_RETURN_VECTOR(res, igraph_get_edgelist(&_, &res, static_cast<igraph_bool_t>(bycol)) );
 	}
+	template <typename T>
+	void Graph::get_edgelist(IdVector<T>& res, EdgelistSequenceOrdering bycol) const MAY_THROW_EXCEPTION {
+		long m = static_cast<long>(igraph_ecount(&_));
+		if (res.resize(2 * m).size() != 2 * m)
+			return;
+		// igraph_edge() reports undirected edges with the smaller ID first, which is "to".
+		bool directed = igraph_is_directed(&_);
+		const Real* from = directed ? VECTOR(_.from) : VECTOR(_.to);
+		const Real* to = directed ? VECTOR(_.to) : VECTOR(_.from);
+		T* out = res.begin();
+		if (bycol == EdgelistSequenceOrdering_ByColumns) {
+			for (long eid = 0; eid < m; ++ eid) {
+				out[eid] = static_cast<T>(from[eid]);
+				out[m + eid] = static_cast<T>(to[eid]);
+			}
+		} else {
+			for (long eid = 0; eid < m; ++ eid) {
+				out[2*eid] = static_cast<T>(from[eid]);
+				out[2*eid+1] = static_cast<T>(to[eid]);
+			}
+		}
+	}
 
 
 #pragma mark -
@@ -908,7 +1562,261 @@ namespace igraph {
 	::tempobj::force_temporary_class<Graph>::type Graph::permute_vertices(const VertexVector& permutation) const MAY_THROW_EXCEPTION {
 		igraph_t res;
 		TRY(igraph_permute_vertices(&_, &res, &permutation._));
-		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
+		return ::tempobj::force_move(Graph(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	/// Orders vertex IDs by degree, then by ID.
+	struct XXINTRNL_LessDegree {
+		const long* degree;
+		bool operator() (const long a, const long b) const throw() { return degree[a] < degree[b] || (degree[a] == degree[b] && a < b); }
+	};
+
+	/// The vertices sorted by degree (ascending or descending), then by ID, with a counting sort.
+	static void XXINTRNL_sort_by_degree(const ::std::vector<long>& degree, const bool descending, ::std::vector<long>& order) {
+		long n = static_cast<long>(degree.size()), max_degree = 0;
+		for (long v = 0; v < n; ++ v)
+			if (degree[v] > max_degree)
+				max_degree = degree[v];
+		::std::vector<long> start (max_degree + 2, 0);
+		for (long v = 0; v < n; ++ v)
+			++ start[(descending ? max_degree - degree[v] : degree[v]) + 1];
+		for (long d = 1; d <= max_degree + 1; ++ d)
+			start[d] += start[d-1];
+		order.resize(n);
+		for (long v = 0; v < n; ++ v)
+			order[start[descending ? max_degree - degree[v] : degree[v]] ++] = v;
+	}
+
+	/// Call f(u) for every neighbor u of v, ignoring the direction. Self-loops and multi-edges are repeated.
+	template <typename F>
+	static inline void XXINTRNL_for_each_neighbor(const CsrGraph& csr, const long v, F& f) {
+		CsrGraph::Range out = csr.out_neighbors(v);
+		for (const long* p = out.begin(); p != out.end(); ++ p)
+			f(*p);
+		if (csr.is_directed()) {
+			CsrGraph::Range in = csr.in_neighbors(v);
+			for (const long* p = in.begin(); p != in.end(); ++ p)
+				f(*p);
+		}
+	}
+
+	struct XXINTRNL_CollectUnvisited {
+		::std::vector<char>& visited;
+		::std::vector<long>& candidates;
+		void operator() (const long u) {
+			if (!visited[u]) {
+				visited[u] = 1;
+				candidates.push_back(u);
+			}
+		}
+	};
+
+	/**
+	 \internal
+	 Each component is searched breadth-first from its vertex of lowest degree,
+	 adding the neighbors of every vertex in the order of increasing degree.
+	 The final order is the reverse.
+	 */
+	static void XXINTRNL_reverse_cuthill_mckee(const CsrGraph& csr, const ::std::vector<long>& degree, ::std::vector<long>& order) {
+		long n = csr.size();
+		::std::vector<long> starts;
+		XXINTRNL_sort_by_degree(degree, false, starts);
+		::std::vector<char> visited (n, 0);
+		::std::vector<long> candidates;
+		XXINTRNL_CollectUnvisited collect = {visited, candidates};
+		XXINTRNL_LessDegree less_degree = {degree.empty() ? NULL : &degree[0]};
+
+		order.clear();
+		order.reserve(n);
+		for (long i = 0; i < n; ++ i) {
+			long start = starts[i];
+			if (visited[start])
+				continue;
+			visited[start] = 1;
+			order.push_back(start);
+			for (::std::size_t head = order.size() - 1; head < order.size(); ++ head) {
+				candidates.clear();
+				XXINTRNL_for_each_neighbor(csr, order[head], collect);
+				::std::sort(candidates.begin(), candidates.end(), less_degree);
+				order.insert(order.end(), candidates.begin(), candidates.end());
+			}
+		}
+		::std::reverse(order.begin(), order.end());
+	}
+
+	/**
+	 \internal
+	 A max-priority queue of vertices for keys which only change by 1, as a
+	 doubly-linked list of vertices per key. Every operation is O(1) except
+	 pop(), which is amortized O(1) over the increments.
+	 */
+	class XXINTRNL_UnitHeap {
+	private:
+		::std::vector<long> key, prev, next, head;	// head[k] is the first vertex with key k, or -1.
+		::std::vector<char> removed;
+		long top;
+
+		void unlink(const long v) throw() {
+			if (prev[v] >= 0)
+				next[prev[v]] = next[v];
+			else
+				head[key[v]] = next[v];
+			if (next[v] >= 0)
+				prev[next[v]] = prev[v];
+		}
+		void link(const long v) throw() {
+			prev[v] = -1;
+			next[v] = head[key[v]];
+			if (next[v] >= 0)
+				prev[next[v]] = v;
+			head[key[v]] = v;
+		}
+
+	public:
+		explicit XXINTRNL_UnitHeap(const long n) : key(n, 0), prev(n), next(n), head(1, n > 0 ? 0 : -1), removed(n, 0), top(0) {
+			for (long v = 0; v < n; ++ v) {
+				prev[v] = v - 1;
+				next[v] = v + 1 < n ? v + 1 : -1;
+			}
+		}
+
+		void increment(const long v) {
+			if (removed[v])
+				return;
+			unlink(v);
+			if (++ key[v] >= static_cast<long>(head.size()))
+				head.push_back(-1);
+			link(v);
+			if (key[v] > top)
+				top = key[v];
+		}
+		void decrement(const long v) throw() {
+			if (removed[v])
+				return;
+			unlink(v);
+			-- key[v];
+			link(v);
+		}
+		void remove(const long v) throw() {
+			unlink(v);
+			removed[v] = 1;
+		}
+		/// Remove and return a vertex of the largest key. The heap must not be empty.
+		long pop() throw() {
+			while (head[top] < 0)
+				-- top;
+			long v = head[top];
+			remove(v);
+			return v;
+		}
+	};
+
+	/**
+	 \internal
+	 Gorder (H. Wei et al., "Speedup Graph Processing by Graph Ordering", 2016).
+	 The key of an unplaced vertex is the number of edges between it and the
+	 last w placed vertices, plus the number of in-neighbors it shares with
+	 them. The vertex with the largest key is placed next.
+	 */
+	class XXINTRNL_Gorder {
+	private:
+		const CsrGraph& csr;
+		const ::std::vector<long>& degree;
+		XXINTRNL_UnitHeap heap;
+		long huge_degree;
+
+		template <bool entering>
+		void update(const long u) {
+			long n_edges[2] = {csr.out_degree(u), csr.is_directed() ? csr.in_degree(u) : 0};
+			const long* neighbors[2] = {csr.out_neighbors(u).begin(), csr.in_neighbors(u).begin()};
+			for (int side = 0; side < 2; ++ side)
+				for (long i = 0; i < n_edges[side]; ++ i)
+					adjust<entering>(neighbors[side][i]);
+
+			// siblings: the out-neighbors of the in-neighbors of u.
+			CsrGraph::Range parents = csr.in_neighbors(u);
+			for (const long* p = parents.begin(); p != parents.end(); ++ p) {
+				if (degree[*p] > huge_degree)
+					continue;
+				CsrGraph::Range siblings = csr.out_neighbors(*p);
+				for (const long* q = siblings.begin(); q != siblings.end(); ++ q)
+					if (*q != u)
+						adjust<entering>(*q);
+			}
+		}
+
+		template <bool entering>
+		void adjust(const long v) {
+			if (entering)
+				heap.increment(v);
+			else
+				heap.decrement(v);
+		}
+
+	public:
+		XXINTRNL_Gorder(const CsrGraph& csr_, const ::std::vector<long>& degree_) : csr(csr_), degree(degree_), heap(csr_.size()) {
+			huge_degree = static_cast<long>(::std::sqrt(static_cast<double>(csr.size())));
+		}
+
+		void run(const long window, ::std::vector<long>& order) {
+			long n = csr.size();
+			order.clear();
+			order.reserve(n);
+			if (n == 0)
+				return;
+
+			long start = static_cast<long>(::std::max_element(degree.begin(), degree.end()) - degree.begin());
+			heap.remove(start);
+			order.push_back(start);
+			update<true>(start);
+			while (static_cast<long>(order.size()) < n) {
+				long k = static_cast<long>(order.size());
+				if (k > window)
+					update<false>(order[k - 1 - window]);
+				long v = heap.pop();
+				order.push_back(v);
+				update<true>(v);
+			}
+		}
+	};
+
+	::tempobj::force_temporary_class<VertexVector>::type Graph::locality_ordering(LocalityOrdering method, Integer window) const MAY_THROW_EXCEPTION {
+		CsrGraph csr (*this);
+		long n = csr.size();
+		::std::vector<long> degree (n);
+		for (long v = 0; v < n; ++ v)
+			degree[v] = csr.out_degree(v) + (csr.is_directed() ? csr.in_degree(v) : 0);
+
+		::std::vector<long> order;
+		switch (method) {
+			case LocalityOrdering_DegreeDescending:
+				XXINTRNL_sort_by_degree(degree, true, order);
+				break;
+			case LocalityOrdering_Gorder:
+				XXINTRNL_Gorder(csr, degree).run(window > 1 ? static_cast<long>(window) : 1, order);
+				break;
+			default:
+				XXINTRNL_reverse_cuthill_mckee(csr, degree, order);
+				break;
+		}
+
+		igraph_vector_t permutation;
+		TRY(igraph_vector_init(&permutation, n));
+		for (long i = 0; i < n; ++ i)
+			VECTOR(permutation)[order[i]] = i;
+		return ::tempobj::force_move(VertexVector(&permutation, ::tempobj::OwnershipTransferMove));
+	}
+
+	::tempobj::force_temporary_class<VertexVector>::type Graph::reorder_for_locality(LocalityOrdering method, Integer window) MAY_THROW_EXCEPTION {
+		VertexVector permutation = locality_ordering(method, window);
+		*this = permute_vertices(permutation);
+
+		long n = permutation.size();
+		igraph_vector_t inverse;
+		TRY(igraph_vector_init(&inverse, n));
+		for (long i = 0; i < n; ++ i)
+			VECTOR(inverse)[static_cast<long>(permutation[i])] = i;
+		return ::tempobj::force_move(VertexVector(&inverse, ::tempobj::OwnershipTransferMove));
 	}
 
 
@@ -1006,10 +1914,13 @@ namespace igraph {
 				case GraphFormat_pajek:
 					writer.pajek();
 					break;
+				case GraphFormat_binary:
+					writer.binary();
+					break;
 				default:
 					return false;
 			}
-			return true;
+			return writer.close();
 		}
 		return false;
 	}
@@ -1036,9 +1947,14 @@ namespace igraph {
 					return ::tempobj::force_move(reader.graphdb());
 				case GraphFormat_lgl:
 					return ::tempobj::force_move(reader.lgl());
-//				case GraphFormat_ncol:
+				case GraphFormat_ncol: {
+					VertexNames names;
+					return ::tempobj::force_move(reader.ncol(names));
+				}
 				case GraphFormat_pajek:
 					return ::tempobj::force_move(reader.pajek());
+				case GraphFormat_binary:
+					return ::tempobj::force_move(reader.binary());
 				default:
 					break;
 			}
@@ -1165,6 +2081,10 @@ namespace igraph {
 	
 #pragma mark -
 #pragma mark Miscellaneous
+	
+	::tempobj::temporary_class<CsrGraph>::type Graph::freeze() const {
+		return ::tempobj::force_move(CsrGraph(*this));
+	}
 		
 #undef XXINTRNL_FORWARD_GRAPH_CREATION
 #undef XXINTRNL_TEMP_RETURN_MATRIX
@@ -0,0 +1,234 @@
+/*
+
+graphbatch.cpp ... Queue edge additions and deletions and apply them at once.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_GRAPHBATCH_CPP
+#define IGRAPH_GRAPHBATCH_CPP
+
+#include <igraph/cpp/graphbatch.hpp>
+#include <igraph/cpp/impl/graph.cpp>
+#include <algorithm>
+
+namespace igraph {
+	MEMORY_MANAGER_IMPLEMENTATION_NO_COPYING(GraphBatch);
+
+	IMPLEMENT_MOVE_METHOD(GraphBatch) {
+		_ = ::std::move(other._);
+		added = ::std::move(other.added);
+		deleted = ::std::move(other.deleted);
+		is_deleted = ::std::move(other.is_deleted);
+		base_vcount = ::std::move(other.base_vcount);
+		base_ecount = ::std::move(other.base_ecount);
+		base_checksum = ::std::move(other.base_checksum);
+	}
+	IMPLEMENT_DEALLOC_METHOD(GraphBatch) {}
+
+	GraphBatch::GraphBatch(igraph_t* graph) MAY_THROW_EXCEPTION : _(graph), COMMON_INIT_WITH(::tempobj::OwnershipTransferNoOwnership) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(GraphBatch);
+		discard();
+	}
+
+	GraphBatch& GraphBatch::add_edge(const Vertex from, const Vertex to) MAY_THROW_EXCEPTION {
+		// Check here, so that commit() cannot fail half-way because of a bad ID.
+		Integer n = igraph_vcount(_);
+		if (from < 0 || from >= n || to < 0 || to >= n) {
+			TRY(IGRAPH_EINVVID);
+			return *this;
+		}
+		added.push_back(from);
+		added.push_back(to);
+		return *this;
+	}
+
+	GraphBatch& GraphBatch::add_edges(const VertexVector& pairs) MAY_THROW_EXCEPTION {
+		long count = pairs.size() / 2;
+		Integer n = igraph_vcount(_);
+		for (long i = 0; i < 2 * count; ++ i) {
+			if (pairs[i] < 0 || pairs[i] >= n) {
+				TRY(IGRAPH_EINVVID);
+				return *this;
+			}
+		}
+		added.reserve(added.size() + 2 * count);
+		for (long i = 0; i < 2 * count; ++ i)
+			added.push_back(pairs[i]);
+		return *this;
+	}
+
+	/// Returns false if the edge is already queued.
+	bool GraphBatch::queue_deletion(const long eid) {
+		if (is_deleted.empty())
+			is_deleted.resize(static_cast<long>(igraph_ecount(_)), false);
+		if (is_deleted[eid])
+			return false;
+		is_deleted[eid] = true;
+		deleted.push_back(eid);
+		return true;
+	}
+
+	GraphBatch& GraphBatch::delete_edge(const Edge eid) MAY_THROW_EXCEPTION {
+		if (eid < 0 || eid >= igraph_ecount(_)) {
+			TRY(IGRAPH_EINVAL);
+			return *this;
+		}
+		queue_deletion(static_cast<long>(eid));
+		return *this;
+	}
+
+	GraphBatch& GraphBatch::delete_edge(const Vertex from, const Vertex to) MAY_THROW_EXCEPTION {
+		Integer n = igraph_vcount(_);
+		if (from < 0 || from >= n || to < 0 || to >= n) {
+			TRY(IGRAPH_EINVVID);
+			return *this;
+		}
+
+		// Undirected edges are stored with from >= to, so only the edges
+		// stored from the larger ID need to be searched.
+		long source = static_cast<long>(from), target = static_cast<long>(to);
+		if (!igraph_is_directed(_) && source < target)
+			::std::swap(source, target);
+
+		const Real* oi = VECTOR(_->oi);
+		const Real* targets = VECTOR(_->to);
+		for (long i = static_cast<long>(VECTOR(_->os)[source]), j = static_cast<long>(VECTOR(_->os)[source+1]); i < j; ++ i) {
+			long eid = static_cast<long>(oi[i]);
+			if (static_cast<long>(targets[eid]) == target && (is_deleted.empty() || !is_deleted[eid])) {
+				queue_deletion(eid);
+				return *this;
+			}
+		}
+
+		TRY(IGRAPH_EINVAL);	// no such edge left.
+		return *this;
+	}
+
+	/**
+	 \brief Replace the edges of graph by the edges not marked in is_deleted, followed by the added ones.
+	 
+	 The new edge vectors are filled completely before they are swapped in,
+	 so the graph is unchanged if anything fails.
+	 */
+	static int XXINTRNL_replace_edges(igraph_t* graph, const ::std::vector<bool>& is_deleted, const long deleted_count, const igraph_vector_t* added) throw() {
+		long old_count = igraph_vector_size(&graph->from);
+		long added_count = igraph_vector_size(added) / 2;
+		long new_count = old_count - deleted_count + added_count;
+		
+		igraph_vector_t from, to;
+		int errcode = igraph_vector_init(&from, new_count);
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		errcode = igraph_vector_init(&to, new_count);
+		if (errcode != IGRAPH_SUCCESS) {
+			igraph_vector_destroy(&from);
+			return errcode;
+		}
+		
+		Real* f = VECTOR(from);
+		Real* t = VECTOR(to);
+		for (long eid = 0; eid < old_count; ++ eid) {
+			if (is_deleted.empty() || !is_deleted[eid]) {
+				*f++ = VECTOR(graph->from)[eid];
+				*t++ = VECTOR(graph->to)[eid];
+			}
+		}
+		// the same orientation as igraph_add_edges(): for undirected graphs "from" is the larger ID.
+		bool directed = igraph_is_directed(graph);
+		for (long i = 0; i < added_count; ++ i) {
+			Real a = VECTOR(*added)[2*i], b = VECTOR(*added)[2*i+1];
+			if (!directed && a < b)
+				::std::swap(a, b);
+			*f++ = a;
+			*t++ = b;
+		}
+		
+		::std::swap(graph->from, from);
+		::std::swap(graph->to, to);
+		// igraph only replaces the index once the new one is complete.
+		errcode = XXINTRNL_reindex_edges(graph);
+		if (errcode != IGRAPH_SUCCESS) {
+			::std::swap(graph->from, from);
+			::std::swap(graph->to, to);
+		}
+		igraph_vector_destroy(&from);
+		igraph_vector_destroy(&to);
+		return errcode;
+	}
+	
+	/// Apply the changes through igraph, so that the attribute handler follows them.
+	static int XXINTRNL_apply_with_attributes(igraph_t* graph, const igraph_vector_t* deleted, const igraph_vector_t* added) throw() {
+		long old_count = igraph_ecount(graph);
+		// adding first keeps the IDs of the edges to delete, and a failed
+		// igraph_add_edges() leaves the graph unchanged.
+		int errcode = IGRAPH_SUCCESS;
+		if (igraph_vector_size(added) > 0)
+			errcode = igraph_add_edges(graph, added, 0);
+		if (errcode != IGRAPH_SUCCESS || igraph_vector_size(deleted) == 0)
+			return errcode;
+		errcode = igraph_delete_edges(graph, igraph_ess_vector(deleted));
+		if (errcode != IGRAPH_SUCCESS && igraph_ecount(graph) > old_count)
+			igraph_delete_edges(graph, igraph_ess_seq(old_count, igraph_ecount(graph) - 1));
+		return errcode;
+	}
+	
+	/// An FNV-1a hash of the endpoints of every edge, in edge ID order.
+	static uint64_t XXINTRNL_edge_checksum(const igraph_t* graph) throw() {
+		uint64_t hash = 14695981039346656037ULL;
+		const Real* from = VECTOR(graph->from);
+		const Real* to = VECTOR(graph->to);
+		for (long eid = 0, m = igraph_vector_size(&graph->from); eid < m; ++ eid) {
+			hash = (hash ^ static_cast<uint64_t>(from[eid])) * 1099511628211ULL;
+			hash = (hash ^ static_cast<uint64_t>(to[eid])) * 1099511628211ULL;
+		}
+		return hash;
+	}
+	
+	Edge GraphBatch::commit() MAY_THROW_EXCEPTION {
+		if (igraph_vcount(_) != base_vcount || igraph_ecount(_) != base_ecount || XXINTRNL_edge_checksum(_) != base_checksum) {
+			// the graph was changed behind the batch, so the queued IDs may refer to other edges.
+			TRY(IGRAPH_EINVAL);
+			return -1;
+		}
+		
+		Edge first_added = base_ecount - static_cast<long>(deleted.size());
+		int errcode;
+		if (_->attr == NULL)
+			errcode = XXINTRNL_replace_edges(_, is_deleted, deleted.size(), &added._);
+		else
+			errcode = XXINTRNL_apply_with_attributes(_, &deleted._, &added._);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return -1;	// the batch is kept, so that it can be committed again.
+		}
+		discard();
+		return first_added;
+	}
+
+	GraphBatch& GraphBatch::discard() throw() {
+		added.clear();
+		deleted.clear();
+		is_deleted.clear();
+		base_vcount = igraph_vcount(_);
+		base_ecount = igraph_ecount(_);
+		base_checksum = XXINTRNL_edge_checksum(_);
+		return *this;
+	}
+}
+
+#endif
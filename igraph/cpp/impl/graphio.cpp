@@ -24,16 +24,56 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <igraph/cpp/graph.hpp>
 #include <igraph/cpp/graphio.hpp>
+#include <igraph/cpp/mappedfile.hpp>
+#include <igraph/cpp/outputbuffer.hpp>
+#include <igraph/cpp/vertexnames.hpp>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
+#include <new>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <thread>
+#if IGRAPH_CPP_WITH_ZLIB
+#include <zlib.h>
+#endif
+#if IGRAPH_CPP_WITH_ZSTD
+#include <zstd.h>
+#endif
+#if defined(__GLIBC__)
+#define XXINTRNL_HAVE_FOPENCOOKIE 1
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+#define XXINTRNL_HAVE_FUNOPEN 1
+#endif
 #if __MSVC__
 #define strcasecmp _stricmp
 #endif
 
 namespace igraph {
 	
+	static const char XXINTRNL_binary_magic[4] = {'I', 'G', 'B', 'N'};
+	static const unsigned XXINTRNL_binary_version = 1;
+	static const unsigned XXINTRNL_binary_header_size = 32;
+	
+	FileCompression identify_file_compression(const char* filename) {
+		const char* theDot = strrchr(filename, '.');
+		if (theDot != NULL) {
+			++ theDot;
+			if (strcasecmp("gz", theDot) == 0) return FileCompression_gzip;
+			else if (strcasecmp("zst", theDot) == 0) return FileCompression_zstd;
+			else if (strcasecmp("zstd", theDot) == 0) return FileCompression_zstd;
+		}
+		return FileCompression_none;
+	}
+	
 	GraphFormat identify_file_format(const char* filename, const bool open_file_to_check) {
+		// (0) look through the compression extension.
+		if (identify_file_compression(filename) != FileCompression_none) {
+			::std::string inner_filename (filename, strrchr(filename, '.'));
+			return identify_file_format(inner_filename.c_str(), false);
+		}
+		
 		// (1) find the dot.
 		const char* theDot = strrchr(filename, '.');
 		if (theDot != NULL) {
@@ -53,6 +93,7 @@ namespace igraph {
 			else if (strcasecmp("adj", theDot) == 0) return GraphFormat_adjlist;
 			else if (strcasecmp("adjlist", theDot) == 0) return GraphFormat_adjlist;
 			else if (strcasecmp("graphdb", theDot) == 0) return GraphFormat_graphdb;
+			else if (strcasecmp("igb", theDot) == 0) return GraphFormat_binary;
 			else if (!open_file_to_check) {
 				if (strcasecmp("txt", theDot) == 0) return GraphFormat_edgelist;
 				else if (strcasecmp("dat", theDot) == 0) return GraphFormat_edgelist;
@@ -61,11 +102,482 @@ namespace igraph {
 		
 		GraphFormat retval = GraphFormat_auto;
 		if (open_file_to_check) {
-			/// TODO: Fill in this part.
+			::std::FILE* f = ::std::fopen(filename, "rb");
+			if (f != NULL) {
+				char magic[sizeof(XXINTRNL_binary_magic)];
+				if (::std::fread(magic, sizeof(magic), 1, f) == 1 && ::std::memcmp(magic, XXINTRNL_binary_magic, sizeof(magic)) == 0)
+					retval = GraphFormat_binary;
+				::std::fclose(f);
+			}
 		}
 		return retval;
 	}
 	
+#pragma mark -
+#pragma mark Compression
+	
+#if (IGRAPH_CPP_WITH_ZLIB || IGRAPH_CPP_WITH_ZSTD) && (XXINTRNL_HAVE_FOPENCOOKIE || XXINTRNL_HAVE_FUNOPEN)
+	static const ::std::size_t XXINTRNL_compression_block_size = 1 << 16;
+	
+	/**
+	 \brief The state behind a FILE* which (de)compresses another file block by block.
+	 
+	 Only one block of compressed data is held in memory, whatever the size of
+	 the file.
+	 */
+	struct XXINTRNL_CompressedFile {
+		::std::FILE* file;
+		FileCompression compression;
+		bool for_writing;
+		bool failed;	// reading: a corrupt or truncated stream; writing: a failed write.
+		bool complete;	// reading: the input so far ends a gzip member or a zstd frame.
+		bool output_full;	// reading: the last block filled the output, so the decompressor may hold more.
+		unsigned char* block;
+#if IGRAPH_CPP_WITH_ZLIB
+		z_stream z;
+#endif
+#if IGRAPH_CPP_WITH_ZSTD
+		ZSTD_DStream* dstream;
+		ZSTD_CStream* cstream;
+		ZSTD_inBuffer zin;
+#endif
+	};
+	
+	/// Write what the compressor produced in the block to the file.
+	static bool XXINTRNL_write_block(XXINTRNL_CompressedFile* c, const ::std::size_t produced) throw() {
+		if (::std::fwrite(c->block, 1, produced, c->file) != produced)
+			c->failed = true;
+		return !c->failed;
+	}
+	
+	/// Decompress at most size bytes into dest. Return 0 at the end of the stream, and -1 if the stream is corrupt or truncated.
+	static long XXINTRNL_compressed_read(void* cookie, char* dest, const ::std::size_t size) throw() {
+		XXINTRNL_CompressedFile* c = reinterpret_cast<XXINTRNL_CompressedFile*>(cookie);
+		const ::std::size_t block = XXINTRNL_compression_block_size;
+		::std::size_t produced = 0;
+		
+		while (!c->failed && produced == 0) {
+#if IGRAPH_CPP_WITH_ZLIB
+			if (c->compression == FileCompression_gzip) {
+				// inflate() may hold more output even when the input is used up.
+				if (c->z.avail_in == 0 && !c->output_full) {
+					c->z.next_in = c->block;
+					c->z.avail_in = ::std::fread(c->block, 1, block, c->file);
+					if (c->z.avail_in == 0) {
+						c->failed = ::std::ferror(c->file) || !c->complete;
+						break;
+					}
+				}
+				c->z.next_out = reinterpret_cast<unsigned char*>(dest);
+				c->z.avail_out = size;
+				int ret = inflate(&c->z, Z_NO_FLUSH);
+				c->output_full = c->z.avail_out == 0;
+				produced = size - c->z.avail_out;
+				if (ret == Z_STREAM_END) {
+					// concatenated members are decompressed one after another, as gzip -d does.
+					c->complete = true;
+					inflateReset(&c->z);
+				} else if (ret == Z_OK)
+					c->complete = false;
+				else if (ret != Z_BUF_ERROR)
+					c->failed = true;
+				continue;
+			}
+#endif
+#if IGRAPH_CPP_WITH_ZSTD
+			if (c->zin.pos == c->zin.size && !c->output_full) {
+				c->zin.size = ::std::fread(c->block, 1, block, c->file);
+				c->zin.pos = 0;
+				if (c->zin.size == 0) {
+					c->failed = ::std::ferror(c->file) || !c->complete;
+					break;
+				}
+			}
+			::std::size_t consumed = c->zin.pos;
+			ZSTD_outBuffer zout = {dest, size, 0};
+			::std::size_t ret = ZSTD_decompressStream(c->dstream, &zout, &c->zin);
+			c->output_full = zout.pos == zout.size;
+			produced = zout.pos;
+			if (ZSTD_isError(ret))
+				c->failed = true;
+			else if (produced != 0 || c->zin.pos != consumed)
+				c->complete = ret == 0;	// 0 exactly at the end of a frame.
+#endif
+		}
+		return c->failed ? -1 : static_cast<long>(produced);
+	}
+	
+	/// Compress size bytes from src into the file. Return size, or -1 if the file cannot be written.
+	static long XXINTRNL_compressed_write(void* cookie, const char* src, const ::std::size_t size) throw() {
+		XXINTRNL_CompressedFile* c = reinterpret_cast<XXINTRNL_CompressedFile*>(cookie);
+		const ::std::size_t block = XXINTRNL_compression_block_size;
+		
+#if IGRAPH_CPP_WITH_ZLIB
+		if (c->compression == FileCompression_gzip) {
+			c->z.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(src));
+			c->z.avail_in = size;
+			do {
+				c->z.next_out = c->block;
+				c->z.avail_out = block;
+				deflate(&c->z, Z_NO_FLUSH);
+			} while (XXINTRNL_write_block(c, block - c->z.avail_out) && c->z.avail_out == 0);
+		}
+#endif
+#if IGRAPH_CPP_WITH_ZSTD
+		if (c->compression == FileCompression_zstd) {
+			ZSTD_inBuffer zin = {src, size, 0};
+			while (!c->failed && zin.pos < zin.size) {
+				ZSTD_outBuffer zout = {c->block, block, 0};
+				if (ZSTD_isError(ZSTD_compressStream(c->cstream, &zout, &zin)))
+					c->failed = true;
+				else
+					XXINTRNL_write_block(c, zout.pos);
+			}
+		}
+#endif
+		return c->failed ? -1 : static_cast<long>(size);
+	}
+	
+	/// Finish the compressed stream when writing, then close the file and free the state. Return -1 if anything failed.
+	static int XXINTRNL_compressed_close(void* cookie) throw() {
+		XXINTRNL_CompressedFile* c = reinterpret_cast<XXINTRNL_CompressedFile*>(cookie);
+		const ::std::size_t block = XXINTRNL_compression_block_size;
+		
+#if IGRAPH_CPP_WITH_ZLIB
+		if (c->compression == FileCompression_gzip) {
+			if (c->for_writing) {
+				int ret = Z_OK;
+				while (!c->failed && ret != Z_STREAM_END) {
+					c->z.next_out = c->block;
+					c->z.avail_out = block;
+					ret = deflate(&c->z, Z_FINISH);
+					XXINTRNL_write_block(c, block - c->z.avail_out);
+				}
+				deflateEnd(&c->z);
+			} else
+				inflateEnd(&c->z);
+		}
+#endif
+#if IGRAPH_CPP_WITH_ZSTD
+		if (c->compression == FileCompression_zstd) {
+			::std::size_t remaining = 1;
+			while (c->for_writing && !c->failed && remaining != 0) {
+				ZSTD_outBuffer zout = {c->block, block, 0};
+				remaining = ZSTD_endStream(c->cstream, &zout);
+				if (ZSTD_isError(remaining))
+					c->failed = true;
+				else
+					XXINTRNL_write_block(c, zout.pos);
+			}
+			ZSTD_freeCStream(c->cstream);
+			ZSTD_freeDStream(c->dstream);
+		}
+#endif
+		bool failed = c->failed && c->for_writing;	// a reader has already seen its error.
+		if (::std::fclose(c->file) != 0)
+			failed = true;
+		::std::free(c->block);
+		::std::free(c);
+		return failed ? -1 : 0;
+	}
+	
+#if XXINTRNL_HAVE_FOPENCOOKIE
+	static ssize_t XXINTRNL_cookie_read(void* cookie, char* dest, size_t size) { return XXINTRNL_compressed_read(cookie, dest, size); }
+	static ssize_t XXINTRNL_cookie_write(void* cookie, const char* src, size_t size) {
+		// fopencookie() treats anything short of size as an error.
+		long written = XXINTRNL_compressed_write(cookie, src, size);
+		return written < 0 ? 0 : written;
+	}
+#else
+	static int XXINTRNL_cookie_read(void* cookie, char* dest, int size) { return XXINTRNL_compressed_read(cookie, dest, size); }
+	static int XXINTRNL_cookie_write(void* cookie, const char* src, int size) { return XXINTRNL_compressed_write(cookie, src, size); }
+#endif
+	
+	/// Start (de)compressing the open file. On failure file is closed and NULL is returned.
+	static ::std::FILE* XXINTRNL_open_compressed(::std::FILE* file, const FileCompression compression, const bool for_writing, int& errcode) throw() {
+		XXINTRNL_CompressedFile* c = reinterpret_cast<XXINTRNL_CompressedFile*>(::std::calloc(1, sizeof(XXINTRNL_CompressedFile)));
+		unsigned char* block = reinterpret_cast<unsigned char*>(::std::malloc(XXINTRNL_compression_block_size));
+		bool started = false;
+		if (c != NULL && block != NULL) {
+			c->file = file;
+			c->compression = compression;
+			c->for_writing = for_writing;
+			c->block = block;
+#if IGRAPH_CPP_WITH_ZLIB
+			if (compression == FileCompression_gzip) {
+				if (for_writing)
+					started = deflateInit2(&c->z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+				else
+					started = inflateInit2(&c->z, 15 + 16) == Z_OK;
+			}
+#endif
+#if IGRAPH_CPP_WITH_ZSTD
+			if (compression == FileCompression_zstd) {
+				if (for_writing) {
+					c->cstream = ZSTD_createCStream();
+					started = c->cstream != NULL && !ZSTD_isError(ZSTD_initCStream(c->cstream, 3));	// zstd's default level.
+				} else {
+					c->dstream = ZSTD_createDStream();
+					started = c->dstream != NULL && !ZSTD_isError(ZSTD_initDStream(c->dstream));
+				}
+				c->zin.src = block;
+			}
+#endif
+		}
+		
+		::std::FILE* stream = NULL;
+		if (started) {
+#if XXINTRNL_HAVE_FOPENCOOKIE
+			cookie_io_functions_t functions = {XXINTRNL_cookie_read, XXINTRNL_cookie_write, NULL, XXINTRNL_compressed_close};
+			stream = fopencookie(c, for_writing ? "w" : "r", functions);
+#else
+			stream = funopen(c, for_writing ? NULL : XXINTRNL_cookie_read, for_writing ? XXINTRNL_cookie_write : NULL, NULL, XXINTRNL_compressed_close);
+#endif
+			if (stream == NULL) {
+				c->for_writing = false;	// nothing has been written to finish.
+				XXINTRNL_compressed_close(c);
+			}
+		} else {
+			if (c != NULL) {
+#if IGRAPH_CPP_WITH_ZLIB
+				if (compression == FileCompression_gzip) {
+					if (for_writing)
+						deflateEnd(&c->z);
+					else
+						inflateEnd(&c->z);
+				}
+#endif
+#if IGRAPH_CPP_WITH_ZSTD
+				ZSTD_freeCStream(c->cstream);
+				ZSTD_freeDStream(c->dstream);
+#endif
+			}
+			::std::free(block);
+			::std::free(c);
+			::std::fclose(file);
+		}
+		if (stream == NULL)
+			errcode = IGRAPH_ENOMEM;
+		return stream;
+	}
+#endif
+	
+	/**
+	 \brief Open a file, (de)compressing it on the fly if its extension says so.
+	 
+	 Compressed files are handled in this process by zlib or libzstd, through
+	 a FILE* which (de)compresses one block at a time. Such a stream cannot
+	 seek. A corrupt or truncated file sets the error indicator of the stream
+	 when the reading reaches the damage.
+	 
+	 A missing file gives NULL, as with fopen(). A compression built without
+	 its library (see identify_file_compression()) gives NULL and sets errcode
+	 to IGRAPH_UNIMPLEMENTED.
+	 */
+	static ::std::FILE* XXINTRNL_open_file(const char* filename, const bool for_writing, int& errcode) throw() {
+		errcode = IGRAPH_SUCCESS;
+		FileCompression compression = identify_file_compression(filename);
+		if (compression == FileCompression_none)
+			return ::std::fopen(filename, for_writing ? "w" : "r");
+		
+#if XXINTRNL_HAVE_FOPENCOOKIE || XXINTRNL_HAVE_FUNOPEN
+#if IGRAPH_CPP_WITH_ZLIB
+		bool supported = true;
+#else
+		bool supported = compression != FileCompression_gzip;
+#endif
+#if !IGRAPH_CPP_WITH_ZSTD
+		supported = supported && compression != FileCompression_zstd;
+#endif
+#else
+		bool supported = false;
+#endif
+		if (!supported) {
+			errcode = IGRAPH_UNIMPLEMENTED;
+			return NULL;
+		}
+		
+#if (IGRAPH_CPP_WITH_ZLIB || IGRAPH_CPP_WITH_ZSTD) && (XXINTRNL_HAVE_FOPENCOOKIE || XXINTRNL_HAVE_FUNOPEN)
+		::std::FILE* file = ::std::fopen(filename, for_writing ? "wb" : "rb");
+		if (file == NULL)
+			return NULL;
+		return XXINTRNL_open_compressed(file, compression, for_writing, errcode);
+#else
+		return NULL;
+#endif
+	}
+	
+	/// Close a file from XXINTRNL_open_file(). A compressed file is finished first.
+	static int XXINTRNL_close_file(::std::FILE* fptr) throw() {
+		if (fptr == NULL)
+			return IGRAPH_SUCCESS;
+		int errcode = ::std::fflush(fptr) == 0 && !::std::ferror(fptr) ? IGRAPH_SUCCESS : IGRAPH_EFILE;
+		if (::std::fclose(fptr) != 0 && errcode == IGRAPH_SUCCESS)
+			errcode = IGRAPH_EFILE;
+		return errcode;
+	}
+	
+#pragma mark -
+#pragma mark Tokenizer
+	
+	static inline bool XXINTRNL_is_digit(const char c) throw() { return static_cast<unsigned char>(c - '0') < 10; }
+	
+	/// Count the number of integers (maximal runs of digits) in [begin, end).
+	static ::std::size_t XXINTRNL_count_integers(const char* begin, const char* end) throw() {
+		::std::size_t count = 0;
+		bool prev_is_digit = false;
+		for (const char* p = begin; p != end; ++ p) {
+			bool is_digit = XXINTRNL_is_digit(*p);
+			count += is_digit & !prev_is_digit;
+			prev_is_digit = is_digit;
+		}
+		return count;
+	}
+	
+	/**
+	 \brief Parse all integers in [begin, end) into res, and return the end of the written range.
+	 
+	 Every byte which is not a digit is a separator, except that a '-' immediately
+	 before a digit negates the number. On edge lists this gives the same tokens
+	 as repeating fscanf("%d") and skipping one byte on failure.
+	 
+	 res must have room for at least XXINTRNL_count_integers(begin, end) items.
+	 */
+	template<typename T>
+	static T* XXINTRNL_parse_integers(const char* begin, const char* end, T* res) throw() {
+		const char* p = begin;
+		while (true) {
+			while (p != end && !XXINTRNL_is_digit(*p))
+				++ p;
+			if (p == end)
+				break;
+			bool negative = p != begin && p[-1] == '-';
+			long num = *p++ - '0';
+			while (p != end && XXINTRNL_is_digit(*p))
+				num = num * 10 + (*p++ - '0');
+			*res++ = static_cast<T>(negative ? -num : num);
+		}
+		return res;
+	}
+	
+	/// A newline-aligned piece of an edge list, tokenized by one thread.
+	struct XXINTRNL_EdgelistChunk {
+		const char* begin;
+		const char* end;
+		::std::size_t count;
+		Real* res;
+		
+		static void count_integers(XXINTRNL_EdgelistChunk* chunk) throw() { chunk->count = XXINTRNL_count_integers(chunk->begin, chunk->end); }
+		static void parse_integers(XXINTRNL_EdgelistChunk* chunk) throw() { XXINTRNL_parse_integers(chunk->begin, chunk->end, chunk->res); }
+	};
+	
+	/// Run func on every chunk, using one thread per chunk (the first chunk runs on the calling thread).
+	static void XXINTRNL_run_on_chunks(::std::vector<XXINTRNL_EdgelistChunk>& chunks, void (*func)(XXINTRNL_EdgelistChunk*)) {
+		::std::vector< ::std::thread> workers;
+		try {
+			workers.reserve(chunks.size());
+		} catch (const ::std::bad_alloc&) {
+			for (unsigned i = 0; i < chunks.size(); ++ i)
+				func(&chunks[i]);
+			return;
+		}
+		for (unsigned i = 1; i < chunks.size(); ++ i) {
+			try {
+				workers.push_back(::std::thread(func, &chunks[i]));
+			} catch (...) {
+				// out of threads; do the work here instead.
+				func(&chunks[i]);
+			}
+		}
+		func(&chunks[0]);
+		for (unsigned i = 0; i < workers.size(); ++ i)
+			workers[i].join();
+	}
+	
+	/**
+	 \brief Tokenize the whole content into a newly initialized vector.
+	 
+	 The content is split into thread_count newline-aligned chunks. Every chunk is
+	 first counted, then parsed directly into its slot of the result, so the
+	 result is identical to a single-threaded parse and no per-thread buffer has
+	 to be concatenated afterwards.
+	 */
+	static int XXINTRNL_parse_edgelist_chunks(const MappedFile& content, unsigned thread_count, igraph_vector_t* res) {
+		const char* begin = content.begin();
+		const char* end = content.end();
+		
+		::std::vector<XXINTRNL_EdgelistChunk> chunks;
+		chunks.reserve(thread_count);
+		const char* chunk_begin = begin;
+		for (unsigned i = 1; i <= thread_count && chunk_begin != end; ++ i) {
+			const char* chunk_end = end;
+			if (i != thread_count) {
+				chunk_end = begin + content.size() / thread_count * i;
+				if (chunk_end < chunk_begin)
+					chunk_end = chunk_begin;
+				const char* newline = reinterpret_cast<const char*>(::std::memchr(chunk_end, '\n', end - chunk_end));
+				chunk_end = newline != NULL ? newline + 1 : end;
+			}
+			XXINTRNL_EdgelistChunk chunk = {chunk_begin, chunk_end, 0, NULL};
+			chunks.push_back(chunk);
+			chunk_begin = chunk_end;
+		}
+		
+		if (chunks.empty())
+			return igraph_vector_init(res, 0);
+		
+		XXINTRNL_run_on_chunks(chunks, XXINTRNL_EdgelistChunk::count_integers);
+		
+		long total = 0;
+		for (unsigned i = 0; i < chunks.size(); ++ i)
+			total += chunks[i].count;
+		
+		int errcode = igraph_vector_init(res, total);
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		
+		Real* slot = VECTOR(*res);
+		for (unsigned i = 0; i < chunks.size(); ++ i) {
+			chunks[i].res = slot;
+			slot += chunks[i].count;
+		}
+		
+		XXINTRNL_run_on_chunks(chunks, XXINTRNL_EdgelistChunk::parse_integers);
+		
+		return IGRAPH_SUCCESS;
+	}
+	/// As XXINTRNL_parse_edgelist_chunks(), but a failed allocation of the chunk list is returned as IGRAPH_ENOMEM.
+	static int XXINTRNL_parse_edgelist(const MappedFile& content, unsigned thread_count, igraph_vector_t* res) {
+		try {
+			return XXINTRNL_parse_edgelist_chunks(content, thread_count, res);
+		} catch (const ::std::bad_alloc&) {
+			// only the chunk list allocates before res is initialized.
+			return IGRAPH_ENOMEM;
+		}
+	}
+	
+#pragma mark -
+#pragma mark Binary format
+	
+	static inline void XXINTRNL_store_index(unsigned char* dest, const Real value, const unsigned width) throw() {
+		if (width == sizeof(Real)) {
+			uint64_t bits;
+			::std::memcpy(&bits, &value, sizeof(bits));
+			XXINTRNL_store_le(dest, bits, width);
+		} else
+			XXINTRNL_store_le(dest, static_cast<uint32_t>(value), width);
+	}
+	
+	static inline Real XXINTRNL_load_index(const unsigned char* src, const unsigned width) throw() {
+		if (width == sizeof(Real)) {
+			uint64_t bits = XXINTRNL_load_le(src, width);
+			Real value;
+			::std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		} else
+			return static_cast<Real>(XXINTRNL_load_le(src, width));
+	}
+	
 #pragma mark -
 #pragma mark GraphReader
 	
@@ -75,27 +587,70 @@ namespace igraph {
 		fptr = ::std::move(other.fptr);
 	}
 	IMPLEMENT_DEALLOC_METHOD(GraphReader) {
-		::std::fclose(fptr);
+		XXINTRNL_close_file(fptr);
 	}
 	
-	GraphReader::GraphReader(const char* filename) : fptr(::std::fopen(filename, "r")) { XXINTRNL_DEBUG_CALL_INITIALIZER(GraphReader); }
+	GraphReader::GraphReader(const char* filename) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(GraphReader);
+		int errcode;
+		fptr = XXINTRNL_open_file(filename, false, errcode);
+		TRY(errcode);
+	}
 	GraphReader::GraphReader(std::FILE* filestream) throw() : fptr(filestream), COMMON_INIT_WITH(::tempobj::OwnershipTransferNoOwnership) { XXINTRNL_DEBUG_CALL_INITIALIZER(GraphReader); }
 	
-	::tempobj::temporary_class<Graph>::type GraphReader::edgelist(const Directedness directedness, EdgelistReadEngine engine) MAY_THROW_EXCEPTION {
+	/// A read error, e.g. a corrupt compressed file, looks like the end of the file to igraph's readers. Report it instead of the partial graph.
+	static void XXINTRNL_check_read_error(::std::FILE* fptr, igraph_t* graph) MAY_THROW_EXCEPTION {
+		if (::std::ferror(fptr)) {
+			igraph_bool_t directed = igraph_is_directed(graph);
+			igraph_destroy(graph);
+			igraph_empty(graph, 0, directed);
+			TRY(IGRAPH_EFILE);
+		}
+	}
+	
+	::tempobj::temporary_class<Graph>::type GraphReader::edgelist(const Directedness directedness, EdgelistReadEngine engine, unsigned thread_count) MAY_THROW_EXCEPTION {
 		igraph_t _;
 		
 		if (engine == EdgelistReadEngine_igraph) {
 			TRY(igraph_read_graph_edgelist(&_, fptr, 0, directedness));
+			XXINTRNL_check_read_error(fptr, &_);
+		} else if (engine == EdgelistReadEngine_mmap || engine == EdgelistReadEngine_parallel) {
+			MappedFile content (fptr);
+			
+			if (engine == EdgelistReadEngine_mmap)
+				thread_count = 1;
+			else if (thread_count == 0) {
+				thread_count = ::std::thread::hardware_concurrency();
+				unsigned max_thread_count = content.size() >> 20;
+				if (thread_count > max_thread_count)
+					thread_count = max_thread_count;
+				if (thread_count == 0)
+					thread_count = 1;
+			}
+			
+			// size the edge vector exactly once, then parse directly into it.
+			igraph_vector_t resvec;
+			int errcode = XXINTRNL_parse_edgelist(content, thread_count, &resvec);
+			if (errcode == IGRAPH_SUCCESS) {
+				if (igraph_vector_size(&resvec) % 2 != 0)
+					igraph_vector_pop_back(&resvec);
+				errcode = igraph_create(&_, &resvec, 0, directedness);
+				igraph_vector_destroy(&resvec);
+			}
+			TRY(errcode);
 		} else {
 			igraph_vector_t resvec;
 			igraph_vector_init(&resvec, 0);
 			
 			while (!feof(fptr)) {
 				int num;
-				if (fscanf(fptr, "%d", &num) != 0)
+				int scanned = fscanf(fptr, "%d", &num);
+				if (scanned == 1)
 					igraph_vector_push_back(&resvec, num);
+				else if (scanned == 0)
+					fgetc(fptr);	// skip one byte; unlike fseek() this works on pipes too.
 				else
-					fseek(fptr, 1, SEEK_CUR);
+					break;
 			}
 			
 			if (igraph_vector_size(&resvec) % 2 != 0)
@@ -103,86 +658,264 @@ namespace igraph {
 			
 			igraph_create(&_, &resvec, 0, directedness);
 			igraph_vector_destroy(&resvec);
+			XXINTRNL_check_read_error(fptr, &_);
 		}
 		
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
 	
-	::tempobj::temporary_class<Graph>::type GraphReader::adjlist(const Directedness directedness, const EdgeMultiplicity multiplicity, const char* line_separator) MAY_THROW_EXCEPTION {
-		int linesep_len = strlen(line_separator);
-		long linesep_rewind = 0;
-		for (int i = 1; i < linesep_len; ++ i)
-			if (line_separator[i] == line_separator[0]) {
-				linesep_rewind = i - linesep_len;
-				break;
-			}
+	/**
+	 \brief Tokenize an adjacency list into (head, neighbor) pairs in file order.
+	 
+	 The first number after each line separator is the head vertex, the other
+	 numbers on the line are its neighbors. Any other non-digit byte separates
+	 numbers. When only_larger is set, neighbors smaller than the head are
+	 dropped, like the "duplicate" mode of igraph_adjlist(). Self-loops are
+	 kept; XXINTRNL_sort_pairs_by_head() halves them.
+	 */
+	static int XXINTRNL_parse_adjlist(const MappedFile& content, const char* line_separator, const bool only_larger, igraph_vector_t* pairs, long& vertex_count) {
+		const char* p = content.begin();
+		const char* const end = content.end();
+		const ::std::size_t linesep_len = ::std::strlen(line_separator);
 		
-		char* linesep_checker = reinterpret_cast<char*>(alloca(linesep_len+1));
-		linesep_checker[linesep_len] = '\0';
-		
-		// Problem: We're managing the adjlist ourselves. Is it OK to do so?
-		int capacity = 16;
-		int length = 0;
-		igraph_adjlist_t adjlist;
-		adjlist.length = length;
-		adjlist.adjs = reinterpret_cast<igraph_vector_t*>(::std::calloc(capacity, sizeof(igraph_vector_t)));
-		
-		igraph_vector_t resvec;
-		igraph_vector_init(&resvec, 0);
-		int num;
-		int head_vertex = -1;
-		
-		while (!feof(fptr)) {
-			if (fscanf(fptr, "%d", &num) != 0) {
-				if (num > length) {
-					length = num;
-					if (num > capacity) {
-						unsigned old_capacity = capacity;
-						capacity *= 2;	// TODO: Nonlinear scaling.
-						adjlist.adjs = reinterpret_cast<igraph_vector_t*>(::std::realloc(adjlist.adjs, sizeof(igraph_vector_t) * capacity));
-						::std::memset(adjlist.adjs - capacity + old_capacity, 0, sizeof(igraph_vector_t) * (capacity - old_capacity));
-					}
+		int errcode = igraph_vector_init(pairs, 2 * XXINTRNL_count_integers(p, end));
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		
+		Real* res = VECTOR(*pairs);
+		long head = -1;
+		long max_vertex = -1;
+		while (p != end) {
+			if (XXINTRNL_is_digit(*p)) {
+				long num = *p++ - '0';
+				while (p != end && XXINTRNL_is_digit(*p))
+					num = num * 10 + (*p++ - '0');
+				if (num > max_vertex)
+					max_vertex = num;
+				if (head < 0)
+					head = num;
+				else if (!only_larger || num >= head) {
+					*res++ = head;
+					*res++ = num;
 				}
-				if (head_vertex == -1)
-					head_vertex = num;
-				else 
-					igraph_vector_push_back(&resvec, num);
-			} else {
-				fread(linesep_checker, linesep_len, 1, fptr);
-				if (strcmp(linesep_checker, line_separator) == 0) {
-					if (head_vertex != -1) {
-						igraph_vector_t* target_vector = adjlist.adjs + head_vertex;
-						if (target_vector->stor_begin == NULL && target_vector->stor_end == NULL && target_vector->end == NULL) {
-							*target_vector = ::std::move(resvec);
-							igraph_vector_init(&resvec, 0);
-						} else {
-							igraph_vector_append(target_vector, &resvec);
-							igraph_vector_clear(&resvec);
-						}
-						head_vertex = -1;
-					}
-				} else if (linesep_rewind != 0)
-					fseek(fptr, SEEK_CUR, linesep_rewind);
+			} else if (linesep_len != 0 && static_cast< ::std::size_t>(end - p) >= linesep_len && ::std::memcmp(p, line_separator, linesep_len) == 0) {
+				head = -1;
+				p += linesep_len;
+			} else
+				++ p;
+		}
+		
+		vertex_count = max_vertex + 1;
+		return igraph_vector_resize(pairs, res - VECTOR(*pairs));	// shrinking never fails.
+	}
+	
+	/**
+	 \brief Stable counting sort of (head, neighbor) pairs by head, giving the edge order of igraph_adjlist().
+	 
+	 Each head gets its other neighbors in file order, then its self-loops.
+	 With halve_loops, as in the "duplicate" mode of igraph_adjlist(), a
+	 self-loop listed twice gives one edge.
+	 */
+	static int XXINTRNL_sort_pairs_by_head(const igraph_vector_t* pairs, const long vertex_count, const bool halve_loops, igraph_vector_t* res) {
+		long pair_count = igraph_vector_size(pairs) / 2;
+		const Real* src = VECTOR(*pairs);
+		
+		// offset[v+1] first counts the other neighbors of v, loops[v] its self-loops.
+		igraph_vector_t counts;
+		int errcode = igraph_vector_init(&counts, 2 * vertex_count + 1);
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		Real* offset = VECTOR(counts);
+		Real* loops = offset + vertex_count + 1;
+		
+		for (long i = 0; i < pair_count; ++ i) {
+			long head = static_cast<long>(src[2*i]);
+			if (head == static_cast<long>(src[2*i+1]))
+				++ loops[head];
+			else
+				++ offset[head + 1];
+		}
+		for (long v = 0; v < vertex_count; ++ v) {
+			if (halve_loops)
+				loops[v] = static_cast<long>(loops[v]) / 2;
+			offset[v+1] += offset[v] + loops[v];
+		}
+		
+		errcode = igraph_vector_init(res, 2 * static_cast<long>(offset[vertex_count]));
+		if (errcode != IGRAPH_SUCCESS) {
+			igraph_vector_destroy(&counts);
+			return errcode;
+		}
+		
+		Real* dest = VECTOR(*res);
+		for (long i = 0; i < pair_count; ++ i) {
+			if (src[2*i] == src[2*i+1])
+				continue;
+			long slot = static_cast<long>(offset[static_cast<long>(src[2*i])]++);
+			dest[2*slot] = src[2*i];
+			dest[2*slot+1] = src[2*i+1];
+		}
+		// the slots after the other neighbors of each head are left for its loops.
+		for (long v = 0; v < vertex_count; ++ v) {
+			for (long k = 0; k < loops[v]; ++ k) {
+				long slot = static_cast<long>(offset[v]++);
+				dest[2*slot] = dest[2*slot+1] = v;
 			}
 		}
 		
-		igraph_vector_destroy(&resvec);
+		igraph_vector_destroy(&counts);
+		return IGRAPH_SUCCESS;
+	}
+	
+	::tempobj::temporary_class<Graph>::type GraphReader::adjlist(const Directedness directedness, const EdgeMultiplicity multiplicity, const char* line_separator) MAY_THROW_EXCEPTION {
+		MappedFile content (fptr);
+		
+		// as igraph_adjlist(), undirected edges listed at both ends are kept once.
+		bool only_larger = multiplicity == EdgeMultiplicity_Multiple && directedness == Undirected;
 		
 		igraph_t _;
-		TRY(igraph_adjlist(&_, &adjlist, directedness, multiplicity));
+		igraph_vector_t pairs, edges;
+		long vertex_count;
+		int errcode = XXINTRNL_parse_adjlist(content, line_separator, only_larger, &pairs, vertex_count);
+		if (errcode == IGRAPH_SUCCESS) {
+			errcode = XXINTRNL_sort_pairs_by_head(&pairs, vertex_count, only_larger, &edges);
+			igraph_vector_destroy(&pairs);
+			if (errcode == IGRAPH_SUCCESS) {
+				errcode = igraph_create(&_, &edges, vertex_count, directedness);
+				igraph_vector_destroy(&edges);
+			}
+		}
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			igraph_empty(&_, 0, directedness);
+		}
+		
+		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
+	}
+	
+	static inline bool XXINTRNL_is_ncol_space(const char c) throw() { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+	
+	/**
+	 \brief Parse the whole NCOL file in one pass, interning the names into names and writing the ID pairs into edges.
+	 
+	 As in igraph_read_graph_ncol(), a non-empty line must hold two names and
+	 an optional numeric weight; anything else gives IGRAPH_PARSEERROR.
+	 */
+	static int XXINTRNL_parse_ncol(const MappedFile& content, VertexNames& names, igraph_vector_t* edges, Vector* weights) {
+		const char* p = content.begin();
+		const char* const end = content.end();
 		
-		for (unsigned i = 0; i < adjlist.length; ++ i)
-			igraph_vector_destroy(adjlist.adjs + i);
-		::std::free(adjlist.adjs);
+		long line_count = 1;
+		for (const char* q = p; (q = reinterpret_cast<const char*>(::std::memchr(q, '\n', end - q))) != NULL; ++ q)
+			++ line_count;
+		int errcode = igraph_vector_reserve(edges, 2 * line_count);
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		if (weights != NULL) {
+			weights->resize(line_count);
+			if (weights->size() != static_cast<unsigned>(line_count))
+				return IGRAPH_ENOMEM;
+		}
 		
+		Real* edge = VECTOR(*edges);
+		Real* weight = weights != NULL ? weights->begin() : NULL;
+		while (p != end) {
+			const char* line_end = reinterpret_cast<const char*>(::std::memchr(p, '\n', end - p));
+			if (line_end == NULL)
+				line_end = end;
+			
+			const char* tokens[4];
+			::std::size_t lengths[4];
+			int token_count = 0;
+			while (token_count < 4) {
+				while (p != line_end && XXINTRNL_is_ncol_space(*p))
+					++ p;
+				if (p == line_end)
+					break;
+				tokens[token_count] = p;
+				while (p != line_end && !XXINTRNL_is_ncol_space(*p))
+					++ p;
+				lengths[token_count] = p - tokens[token_count];
+				++ token_count;
+			}
+			
+			if (token_count == 1 || token_count == 4)
+				return IGRAPH_PARSEERROR;
+			if (token_count != 0) {
+				Real w = 0;
+				if (token_count == 3) {
+					// the mapped content is not NUL-terminated.
+					char number[64];
+					if (lengths[2] >= sizeof(number))
+						return IGRAPH_PARSEERROR;
+					::std::memcpy(number, tokens[2], lengths[2]);
+					number[lengths[2]] = '\0';
+					char* number_end;
+					w = ::std::strtod(number, &number_end);
+					if (number_end != number + lengths[2])
+						return IGRAPH_PARSEERROR;
+				}
+				*edge++ = names.intern(tokens[0], lengths[0]);
+				*edge++ = names.intern(tokens[1], lengths[1]);
+				if (weight != NULL)
+					*weight++ = w;
+			}
+			
+			p = line_end == end ? end : line_end + 1;
+		}
+		
+		edges->end = edge;
+		if (weights != NULL)
+			weights->resize(weight - weights->begin());	// shrinking never fails.
+		return IGRAPH_SUCCESS;
+	}
+	
+	static int XXINTRNL_read_ncol(::std::FILE* fptr, igraph_t* graph, VertexNames& names, Vector* weights, const Directedness directedness) {
+		MappedFile content (fptr);
+		
+		igraph_vector_t edges;
+		int errcode = igraph_vector_init(&edges, 0);
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		try {
+			errcode = XXINTRNL_parse_ncol(content, names, &edges, weights);
+		} catch (const ::std::bad_alloc&) {
+			// the names could not grow; report it like any other igraph allocation.
+			errcode = IGRAPH_ENOMEM;
+		}
+		
+		if (errcode == IGRAPH_SUCCESS)
+			errcode = igraph_create(graph, &edges, names.size(), directedness);
+		else if (weights != NULL)
+			weights->clear();
+		igraph_vector_destroy(&edges);
+		return errcode;
+	}
+	
+	::tempobj::temporary_class<Graph>::type GraphReader::ncol(VertexNames& names, const Directedness directedness) MAY_THROW_EXCEPTION {
+		igraph_t _;
+		int errcode = XXINTRNL_read_ncol(fptr, &_, names, NULL, directedness);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			igraph_empty(&_, 0, directedness);
+		}
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
 	
-	// TODO: ncol, after StringVector is implemented.
+	::tempobj::temporary_class<Graph>::type GraphReader::ncol(VertexNames& names, Vector& weights, const Directedness directedness) MAY_THROW_EXCEPTION {
+		igraph_t _;
+		int errcode = XXINTRNL_read_ncol(fptr, &_, names, &weights, directedness);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			igraph_empty(&_, 0, directedness);
+		}
+		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
+	}
 	
 	::tempobj::temporary_class<Graph>::type GraphReader::lgl(const lglNames names, const lglWeights weights) MAY_THROW_EXCEPTION {
 		igraph_t _;
 		TRY(igraph_read_graph_lgl(&_, fptr, names, weights));
+		XXINTRNL_check_read_error(fptr, &_);
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
 	
@@ -191,27 +924,233 @@ namespace igraph {
 	::tempobj::temporary_class<Graph>::type GraphReader::graphml(const int index) MAY_THROW_EXCEPTION {
 		igraph_t _;
 		TRY(igraph_read_graph_graphml(&_, fptr, index));
+		XXINTRNL_check_read_error(fptr, &_);
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
 	
 	::tempobj::temporary_class<Graph>::type GraphReader::gml() MAY_THROW_EXCEPTION {
 		igraph_t _;
 		TRY(igraph_read_graph_gml(&_, fptr));
+		XXINTRNL_check_read_error(fptr, &_);
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
 	
 	::tempobj::temporary_class<Graph>::type GraphReader::pajek() MAY_THROW_EXCEPTION {
 		igraph_t _;
 		TRY(igraph_read_graph_pajek(&_, fptr));
+		XXINTRNL_check_read_error(fptr, &_);
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
 	
 	::tempobj::temporary_class<Graph>::type GraphReader::graphdb(const Directedness directedness) MAY_THROW_EXCEPTION {
 		igraph_t _;
 		TRY(igraph_read_graph_graphdb(&_, fptr, directedness));
+		XXINTRNL_check_read_error(fptr, &_);
+		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
+	}
+	
+	/// Whether every vertex ID in the payload is an integer in [0, vcount).
+	static bool XXINTRNL_binary_ids_are_valid(const unsigned char* payload, const long count, const unsigned width, const uint64_t vcount) throw() {
+		const Real limit = static_cast<Real>(vcount);
+		for (long i = 0; i < count; ++ i) {
+			Real id = XXINTRNL_load_index(payload + i * width, width);
+			if (!(id >= 0 && id < limit) || id != static_cast<Real>(static_cast<long>(id)))
+				return false;
+		}
+		return true;
+	}
+	
+	static int XXINTRNL_read_binary(const MappedFile& content, igraph_t* graph) {
+		const unsigned char* header = reinterpret_cast<const unsigned char*>(content.begin());
+		if (content.size() < XXINTRNL_binary_header_size || ::std::memcmp(header, XXINTRNL_binary_magic, sizeof(XXINTRNL_binary_magic)) != 0)
+			return IGRAPH_PARSEERROR;
+		if (header[4] != XXINTRNL_binary_version)
+			return IGRAPH_UNIMPLEMENTED;
+		
+		Directedness directedness = header[5] ? Directed : Undirected;
+		unsigned width = header[6];
+		if (width != GraphWriter::BinaryIndexWidth_32 && width != GraphWriter::BinaryIndexWidth_Native)
+			return IGRAPH_UNIMPLEMENTED;
+		
+		uint64_t vcount = XXINTRNL_load_le(header + 8, 8);
+		uint64_t ecount = XXINTRNL_load_le(header + 16, 8);
+		if ((content.size() - XXINTRNL_binary_header_size) / width / 2 < ecount)
+			return IGRAPH_PARSEERROR;
+		
+		const unsigned char* payload = header + XXINTRNL_binary_header_size;
+		long count = 2 * ecount;
+		// igraph_create() trusts the IDs, so a corrupt file must not reach it.
+		if (!XXINTRNL_binary_ids_are_valid(payload, count, width, vcount))
+			return IGRAPH_EINVVID;
+		
+		if (width == sizeof(Vertex) && XXINTRNL_is_little_endian() && reinterpret_cast<uintptr_t>(payload) % sizeof(Vertex) == 0) {
+			// the mapped edge list already has the layout of an igraph vector.
+			igraph_vector_t edges;
+			igraph_vector_view(&edges, reinterpret_cast<const Real*>(payload), count);
+			return igraph_create(graph, &edges, vcount, directedness);
+		}
+		
+		igraph_vector_t edges;
+		int errcode = igraph_vector_init(&edges, count);
+		if (errcode != IGRAPH_SUCCESS)
+			return errcode;
+		for (long i = 0; i < count; ++ i)
+			VECTOR(edges)[i] = XXINTRNL_load_index(payload + i * width, width);
+		errcode = igraph_create(graph, &edges, vcount, directedness);
+		igraph_vector_destroy(&edges);
+		return errcode;
+	}
+	
+	::tempobj::temporary_class<Graph>::type GraphReader::binary() MAY_THROW_EXCEPTION {
+		MappedFile content (fptr);
+		igraph_t _;
+		int errcode = XXINTRNL_read_binary(content, &_);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			igraph_empty(&_, 0, Undirected);
+		}
 		return ::tempobj::force_move(Graph(&_, ::tempobj::OwnershipTransferMove));
 	}
 	
+#pragma mark -
+#pragma mark Parallel formatting
+	
+	/// A block of items formatted into memory by one thread.
+	template <typename F>
+	struct XXINTRNL_FormatJob {
+		const F* format;
+		OutputBuffer* out;
+		long begin;
+		long end;
+		
+		// memory buffers only record failures, so this does not throw.
+		void operator()() const throw() {
+			out->clear();
+			(*format)(*out, begin, end);
+		}
+	};
+	
+	/// The number of threads which format count items in blocks of block_size, when thread_count are asked for.
+	static unsigned XXINTRNL_effective_thread_count(unsigned thread_count, const long count, const long block_size) throw() {
+		if (thread_count == 0)
+			thread_count = ::std::thread::hardware_concurrency();
+		long block_count = (count + block_size - 1) / block_size;
+		if (thread_count > block_count)
+			thread_count = block_count;
+		return thread_count;
+	}
+	
+	/**
+	 \brief Write the items [0, count) to a stream, where format(out, begin, end) formats the items [begin, end).
+	 
+	 With more than one thread, each round formats thread_count consecutive
+	 blocks of block_size items into per-thread memory buffers, and then writes
+	 the buffers in order. Thus the output is byte-identical to formatting all
+	 items sequentially, and memory use is bounded by the size of a round.
+	 */
+	template <typename F>
+	static void XXINTRNL_format_items(::std::FILE* fptr, const long count, unsigned thread_count, const long block_size, const F& format) {
+		thread_count = XXINTRNL_effective_thread_count(thread_count, count, block_size);
+		if (thread_count <= 1) {
+			OutputBuffer out (fptr);
+			format(out, 0, count);
+			out.flush();
+			return;
+		}
+		
+		::std::vector<OutputBuffer*> buffers;
+		buffers.reserve(thread_count);
+		try {
+			for (unsigned i = 0; i < thread_count; ++ i)
+				buffers.push_back(new OutputBuffer());
+			
+			::std::vector<XXINTRNL_FormatJob<F> > jobs (thread_count);
+			::std::vector< ::std::thread> workers;
+			workers.reserve(thread_count);
+			for (long first = 0; first < count; first += block_size * thread_count) {
+				unsigned job_count = 0;
+				for (; job_count < thread_count && first + job_count * block_size < count; ++ job_count) {
+					XXINTRNL_FormatJob<F>& job = jobs[job_count];
+					job.format = &format;
+					job.out = buffers[job_count];
+					job.begin = first + job_count * block_size;
+					job.end = job.begin + block_size < count ? job.begin + block_size : count;
+				}
+				
+				for (unsigned i = 1; i < job_count; ++ i) {
+					try {
+						workers.push_back(::std::thread(jobs[i]));
+					} catch (...) {
+						// out of threads; do the work here instead.
+						jobs[i]();
+					}
+				}
+				jobs[0]();
+				for (unsigned i = 0; i < workers.size(); ++ i)
+					workers[i].join();
+				workers.clear();
+				
+				for (unsigned i = 0; i < job_count; ++ i) {
+					if (buffers[i]->good())
+						buffers[i]->write_to(fptr);
+					else {
+						// the memory buffer could not grow; format this block straight into the stream.
+						OutputBuffer out (fptr);
+						format(out, jobs[i].begin, jobs[i].end);
+						out.flush();
+					}
+				}
+			}
+		} catch (...) {
+			for (unsigned i = 0; i < buffers.size(); ++ i)
+				delete buffers[i];
+			throw;
+		}
+		for (unsigned i = 0; i < buffers.size(); ++ i)
+			delete buffers[i];
+	}
+	
+	/// Format edges by ID: "from separator to line_separator".
+	struct XXINTRNL_EdgelistFormatter {
+		const igraph_t* graph;
+		const igraph_vector_t* order;	// edge IDs to write in turn, or NULL for all edges in ID order.
+		const char* separator;
+		const char* line_separator;
+		
+		void operator()(OutputBuffer& out, const long begin, const long end) const {
+			for (long i = begin; i < end; ++ i) {
+				Vertex from, to;
+				igraph_edge(graph, order != NULL ? VECTOR(*order)[i] : i, &from, &to);
+				out.put_id(from).put(separator).put_id(to).put(line_separator);
+			}
+		}
+	};
+	
+	/// Format the rows of an adjacency list by vertex.
+	struct XXINTRNL_AdjlistFormatter {
+		igraph_adjlist_t* adjlist;
+		const char* first_separator;
+		const char* separator;
+		const char* line_separator;
+		
+		void operator()(OutputBuffer& out, const long begin, const long end) const {
+			for (long i = begin; i < end; ++ i) {
+				igraph_vector_t* pList = igraph_adjlist_get(adjlist, i);
+				out.put_id(i).put(first_separator);
+				long deg = igraph_vector_size(pList);
+				for (long j = 0; j < deg; ++ j) {
+					if (j != 0)
+						out.put(separator);
+					out.put_id(VECTOR(*pList)[j]);
+				}
+				out.put(line_separator);
+			}
+		}
+	};
+	
+	static const long XXINTRNL_edges_per_block = 1 << 16;
+	static const long XXINTRNL_vertices_per_block = 1 << 14;
+	
 #pragma mark -
 #pragma mark GraphWriter
 	
@@ -222,50 +1161,98 @@ namespace igraph {
 		fptr = ::std::move(other.fptr);
 	}
 	IMPLEMENT_DEALLOC_METHOD(GraphWriter) {
-		::std::fclose(fptr);
+		XXINTRNL_close_file(fptr);
 	}
 	
 	GraphWriter::GraphWriter(const igraph_t* graph, const char* filename)
-		: _(graph), fptr(::std::fopen(filename, "w")), COMMON_INIT_WITH(::tempobj::OwnershipTransferMove) { XXINTRNL_DEBUG_CALL_INITIALIZER(GraphWriter); }
+		: _(graph), COMMON_INIT_WITH(::tempobj::OwnershipTransferMove) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(GraphWriter);
+		int errcode;
+		fptr = XXINTRNL_open_file(filename, true, errcode);
+		TRY(errcode);
+		// the formats written by igraph itself go through stdio; let it flush in big blocks too.
+		if (fptr != NULL)
+			::std::setvbuf(fptr, NULL, _IOFBF, 1 << 20);
+	}
 	GraphWriter::GraphWriter(const igraph_t* graph, std::FILE* filestream) throw() : _(graph), fptr(filestream), COMMON_INIT_WITH(::tempobj::OwnershipTransferNoOwnership) { }
+	
+	bool GraphWriter::close() MAY_THROW_EXCEPTION {
+		if (fptr == NULL)
+			return false;
+		int errcode;
+		if (mm_dont_dealloc)	// the caller's stream stays open.
+			errcode = ::std::fflush(fptr) == 0 && !::std::ferror(fptr) ? IGRAPH_SUCCESS : IGRAPH_EFILE;
+		else {
+			errcode = XXINTRNL_close_file(fptr);
+			fptr = NULL;
+		}
+		TRY(errcode);
+		return errcode == IGRAPH_SUCCESS;
+	}
 
-	void GraphWriter::edgelist(const char* separator, const char* line_separator) MAY_THROW_EXCEPTION {
+	/// Write "from separator to line_separator" for every edge in the order of IGRAPH_EDGEORDER_FROM, as igraph's own edge list and ncol writers do.
+	static void XXINTRNL_write_edges_by_source(::std::FILE* fptr, const igraph_t* graph, const char* separator, const char* line_separator, const unsigned thread_count) MAY_THROW_EXCEPTION {
+		igraph_eit_t it;
+		int errcode = igraph_eit_create(graph, igraph_ess_all(IGRAPH_EDGEORDER_FROM), &it);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return;
+		}
+		igraph_vector_t order;
+		errcode = igraph_vector_init(&order, IGRAPH_EIT_SIZE(it));
+		if (errcode == IGRAPH_SUCCESS) {
+			for (long i = 0; !IGRAPH_EIT_END(it); ++ i, IGRAPH_EIT_NEXT(it))
+				VECTOR(order)[i] = IGRAPH_EIT_GET(it);
+		}
+		igraph_eit_destroy(&it);
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return;
+		}
+		
+		XXINTRNL_EdgelistFormatter formatter = {graph, &order, separator, line_separator};
+		try {
+			XXINTRNL_format_items(fptr, igraph_vector_size(&order), thread_count, XXINTRNL_edges_per_block, formatter);
+		} catch (...) {
+			igraph_vector_destroy(&order);
+			throw;
+		}
+		igraph_vector_destroy(&order);
+	}
+	
+	void GraphWriter::edgelist(const char* separator, const char* line_separator, const unsigned thread_count) MAY_THROW_EXCEPTION {
+		// the defaults produce the same output as igraph_write_graph_edgelist(), which is not in edge ID order.
 		if (separator == NULL && line_separator == NULL) {
-			TRY(igraph_write_graph_edgelist(_, fptr));
-		} else {
-			if (separator == NULL) separator = " ";
-			if (line_separator == NULL) line_separator = "\n";
-			
-			Integer ecount = igraph_ecount(_);
-			
-			for (Edge i = 0; i < ecount; ++ i) {
-				Vertex from, to;
-				TRY(igraph_edge(_, i, &from, &to));
-				fprintf(fptr, "%lg%s%lg%s", from, separator, to, line_separator);
-			}
+			XXINTRNL_write_edges_by_source(fptr, _, " ", "\n", thread_count);
+			return;
 		}
+		if (separator == NULL) separator = " ";
+		if (line_separator == NULL) line_separator = "\n";
+		
+		XXINTRNL_EdgelistFormatter formatter = {_, NULL, separator, line_separator};
+		XXINTRNL_format_items(fptr, igraph_ecount(_), thread_count, XXINTRNL_edges_per_block, formatter);
 	}
 	
-	void GraphWriter::adjlist(const char* first_separator, const char* separator, const char* line_separator) MAY_THROW_EXCEPTION {
+	void GraphWriter::adjlist(const char* first_separator, const char* separator, const char* line_separator, const unsigned thread_count) MAY_THROW_EXCEPTION {
 		igraph_adjlist_t al;
 		TRY(igraph_adjlist_init(_, &al, IGRAPH_OUT));
-		long vcount = (long)igraph_vcount(_);
-		for (long i = 0; i < vcount; ++ i) {
-			igraph_vector_t* pList = igraph_adjlist_get(&al, i);
-			fprintf(fptr, "%ld%s", i, first_separator);
-			long deg = igraph_vector_size(pList);
-			for (long j = 0; j < deg; ++ j) {
-				if (j != 0)
-					fprintf(fptr, "%s", separator);
-				fprintf(fptr, "%lg", VECTOR(*pList)[j]);
-			}
-			fprintf(fptr, "%s", line_separator);
+		XXINTRNL_AdjlistFormatter formatter = {&al, first_separator, separator, line_separator};
+		try {
+			XXINTRNL_format_items(fptr, igraph_vcount(_), thread_count, XXINTRNL_vertices_per_block, formatter);
+		} catch (...) {
+			igraph_adjlist_destroy(&al);
+			throw;
 		}
 		igraph_adjlist_destroy(&al);
 	}
 	
-	void GraphWriter::ncol(const char* names, const char* weights) MAY_THROW_EXCEPTION {
-		TRY(igraph_write_graph_ncol(_, fptr, names, weights));
+	void GraphWriter::ncol(const char* names, const char* weights, const unsigned thread_count) MAY_THROW_EXCEPTION {
+		if (names != NULL || weights != NULL) {
+			TRY(igraph_write_graph_ncol(_, fptr, names, weights));
+		} else {
+			// without names and weights, igraph writes the same lines as the edge list writer.
+			XXINTRNL_write_edges_by_source(fptr, _, " ", "\n", thread_count);
+		}
 	}
 	
 	void GraphWriter::lgl(const char* names, const char* weights, const lglIsolatedVertices isolates) MAY_THROW_EXCEPTION {
@@ -295,6 +1282,57 @@ namespace igraph {
 	void GraphWriter::dot() MAY_THROW_EXCEPTION {
 		TRY(igraph_write_graph_dot(_, fptr));
 	}
+	
+	void GraphWriter::binary(const BinaryIndexWidth index_width) MAY_THROW_EXCEPTION {
+		const unsigned width = index_width;
+		// vertex IDs are below vcount, so they fit in 32 bits if vcount does.
+		if (width < sizeof(Vertex) && static_cast<uint64_t>(igraph_vcount(_)) > 0xFFFFFFFFULL + 1) {
+			TRY(IGRAPH_EINVAL);
+			return;
+		}
+		
+		unsigned char header[XXINTRNL_binary_header_size];
+		::std::memset(header, 0, sizeof(header));
+		::std::memcpy(header, XXINTRNL_binary_magic, sizeof(XXINTRNL_binary_magic));
+		header[4] = XXINTRNL_binary_version;
+		header[5] = igraph_is_directed(_) ? 1 : 0;
+		header[6] = width;
+		XXINTRNL_store_le(header + 8, static_cast<uint64_t>(igraph_vcount(_)), 8);
+		XXINTRNL_store_le(header + 16, static_cast<uint64_t>(igraph_ecount(_)), 8);
+		if (::std::fwrite(header, sizeof(header), 1, fptr) != 1) {
+			TRY(IGRAPH_EFILE);
+			return;
+		}
+		
+		igraph_vector_t edges;
+		TRY(igraph_vector_init(&edges, 0));
+		int errcode = igraph_get_edgelist(_, &edges, 0);
+		if (errcode != IGRAPH_SUCCESS) {
+			igraph_vector_destroy(&edges);
+			TRY(errcode);
+			return;
+		}
+		
+		long count = igraph_vector_size(&edges);
+		bool written;
+		if (width == sizeof(Vertex) && XXINTRNL_is_little_endian())
+			written = ::std::fwrite(VECTOR(edges), sizeof(Vertex), count, fptr) == static_cast< ::std::size_t>(count);
+		else {
+			written = true;
+			unsigned char buffer[1 << 15];
+			const long per_buffer = sizeof(buffer) / width;
+			for (long i = 0; written && i < count; i += per_buffer) {
+				long n = count - i < per_buffer ? count - i : per_buffer;
+				for (long j = 0; j < n; ++ j)
+					XXINTRNL_store_index(buffer + j * width, VECTOR(edges)[i + j], width);
+				written = ::std::fwrite(buffer, width, n, fptr) == static_cast< ::std::size_t>(n);
+			}
+		}
+		
+		igraph_vector_destroy(&edges);
+		if (!written)
+			TRY(IGRAPH_EFILE);
+	}
 }
 
 #endif
@@ -0,0 +1,312 @@
+/*
+
+graphview.cpp ... A graph with some vertices and edges hidden, without copying it.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_GRAPHVIEW_CPP
+#define IGRAPH_GRAPHVIEW_CPP
+
+#include <igraph/cpp/graphview.hpp>
+#include <igraph/cpp/graph.hpp>
+#include <utility>
+
+namespace igraph {
+	GraphView::GraphView(const Graph& g) throw() : graph(g.get()), vertex_mask(NULL), edge_mask(NULL) {}
+
+	GraphView& GraphView::set_vertex_mask(const BoolVector& mask) MAY_THROW_EXCEPTION {
+		if (mask.size() != size()) {
+			TRY(IGRAPH_EINVAL);
+			return *this;
+		}
+		vertex_mask = mask.begin();
+		return *this;
+	}
+	GraphView& GraphView::set_edge_mask(const BoolVector& mask) MAY_THROW_EXCEPTION {
+		if (mask.size() != static_cast<long>(igraph_ecount(graph))) {
+			TRY(IGRAPH_EINVAL);
+			return *this;
+		}
+		edge_mask = mask.begin();
+		return *this;
+	}
+
+	bool GraphView::check_vertex(const Vertex vid) const MAY_THROW_EXCEPTION {
+		if (vid < 0 || vid >= size()) {
+			TRY(IGRAPH_EINVVID);
+			return false;
+		}
+		return true;
+	}
+
+	bool GraphView::has_edge(const Edge eid) const throw() {
+		if (eid < 0 || eid >= igraph_ecount(graph))
+			return false;
+		long e = static_cast<long>(eid);
+		return keeps(e, static_cast<long>(VECTOR(graph->from)[e])) && (vertex_mask == NULL || vertex_mask[static_cast<long>(VECTOR(graph->to)[e])]);
+	}
+
+	long GraphView::vertex_count() const throw() {
+		if (vertex_mask == NULL)
+			return size();
+		long count = 0;
+		for (long v = size() - 1; v >= 0; -- v)
+			count += vertex_mask[v] ? 1 : 0;
+		return count;
+	}
+	long GraphView::edge_count() const throw() {
+		long count = 0;
+		for (long eid = static_cast<long>(igraph_ecount(graph)) - 1; eid >= 0; -- eid)
+			count += has_edge(eid) ? 1 : 0;
+		return count;
+	}
+
+	/// Call f(eid, neighbor) for each kept edge at v, in the order of the IncidentEdgeView. v itself is not checked.
+	template <typename F>
+	void GraphView::for_each_incident(const long v, const NeighboringMode mode, F& f) const {
+		IncidentEdgeView edges (graph, v, mode);
+		for (IncidentEdgeView::iterator it = edges.begin(); it != edges.end(); ++ it) {
+			long eid = static_cast<long>(*it);
+			long u = other_end(eid, v);
+			if (keeps(eid, u))
+				f(eid, u);
+		}
+	}
+
+#pragma mark -
+#pragma mark Neighbors and Degrees
+
+	struct XXINTRNL_CollectNeighbors {
+		igraph_vector_t* res;
+		bool edges;
+		int errcode;
+		void operator() (const long eid, const long u) throw() {
+			if (errcode == IGRAPH_SUCCESS)
+				errcode = igraph_vector_push_back(res, edges ? eid : u);
+		}
+	};
+
+	::tempobj::force_temporary_class<VertexVector>::type GraphView::neighbors(const Vertex vid, NeighboringMode neimode) const MAY_THROW_EXCEPTION {
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, 0));
+		if (check_vertex(vid) && has_vertex(vid)) {
+			XXINTRNL_CollectNeighbors f = {&res, false, IGRAPH_SUCCESS};
+			for_each_incident(static_cast<long>(vid), neimode, f);
+			TRY(f.errcode);
+		}
+		return ::tempobj::force_move(VertexVector(&res, ::tempobj::OwnershipTransferMove));
+	}
+	::tempobj::force_temporary_class<EdgeVector>::type GraphView::adjacent(const Vertex vid, NeighboringMode neimode) const MAY_THROW_EXCEPTION {
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, 0));
+		if (check_vertex(vid) && has_vertex(vid)) {
+			XXINTRNL_CollectNeighbors f = {&res, true, IGRAPH_SUCCESS};
+			for_each_incident(static_cast<long>(vid), neimode, f);
+			TRY(f.errcode);
+		}
+		return ::tempobj::force_move(EdgeVector(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	struct XXINTRNL_CountNeighbors {
+		long v;
+		bool loops;
+		long count;
+		void operator() (const long, const long u) throw() {
+			if (loops || u != v)
+				++ count;
+		}
+	};
+
+	Integer GraphView::degree_of(const Vertex vid, NeighboringMode neimode, SelfLoops countLoops) const MAY_THROW_EXCEPTION {
+		if (!check_vertex(vid) || !has_vertex(vid))
+			return 0;
+		XXINTRNL_CountNeighbors f = {static_cast<long>(vid), countLoops == ContainSelfLoops, 0};
+		for_each_incident(f.v, neimode, f);
+		return f.count;
+	}
+
+	::tempobj::force_temporary_class<Vector>::type GraphView::degree(NeighboringMode neimode, SelfLoops countLoops) const MAY_THROW_EXCEPTION {
+		long n = size();
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, n));
+		for (long v = 0; v < n; ++ v)
+			if (has_vertex(v)) {
+				XXINTRNL_CountNeighbors f = {v, countLoops == ContainSelfLoops, 0};
+				for_each_incident(v, neimode, f);
+				VECTOR(res)[v] = f.count;
+			}
+		return ::tempobj::force_move(Vector(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+#pragma mark -
+#pragma mark Traversals
+
+	/// Appends the unvisited neighbors to the queue, marking them with the next label.
+	struct XXINTRNL_VisitNeighbors {
+		::std::vector<long>* label;
+		::std::vector<long>* queue;
+		long value;
+		void operator() (const long, const long u) {
+			if ((*label)[u] < 0) {
+				(*label)[u] = value;
+				queue->push_back(u);
+			}
+		}
+	};
+
+	::tempobj::force_temporary_class<Vector>::type GraphView::bfs_distances(const Vertex source, NeighboringMode mode) const MAY_THROW_EXCEPTION {
+		long n = size();
+		::std::vector<long> distance (n, -1), queue;
+		if (check_vertex(source) && has_vertex(source)) {
+			long s = static_cast<long>(source);
+			distance[s] = 0;
+			queue.push_back(s);
+			XXINTRNL_VisitNeighbors f = {&distance, &queue, 0};
+			for (::std::size_t head = 0; head < queue.size(); ++ head) {
+				long v = queue[head];
+				f.value = distance[v] + 1;
+				for_each_incident(v, mode, f);
+			}
+		}
+
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, n));
+		for (long v = 0; v < n; ++ v)
+			VECTOR(res)[v] = distance[v];
+		return ::tempobj::force_move(Vector(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	long GraphView::label_weak_components(::std::vector<long>& membership, ::std::vector<long>& csize) const {
+		long n = size();
+		membership.assign(n, -1);
+		csize.clear();
+		::std::vector<long> queue;
+		XXINTRNL_VisitNeighbors f = {&membership, &queue, 0};
+		for (long s = 0; s < n; ++ s) {
+			if (membership[s] >= 0 || !has_vertex(s))
+				continue;
+			f.value = csize.size();
+			membership[s] = f.value;
+			queue.clear();
+			queue.push_back(s);
+			for (::std::size_t head = 0; head < queue.size(); ++ head)
+				for_each_incident(queue[head], AllNeighbors, f);
+			csize.push_back(queue.size());
+		}
+		return csize.size();
+	}
+
+	/**
+	 \internal
+	 Kosaraju's algorithm: a depth-first search along the out-edges records
+	 the vertices in the order they finish, then each vertex which is not yet
+	 labeled, taken in reverse finishing order, labels what it reaches along
+	 the in-edges.
+	 */
+	long GraphView::label_strong_components(::std::vector<long>& membership, ::std::vector<long>& csize) const {
+		long n = size();
+		::std::vector<char> visited (n, 0);
+		::std::vector<long> finished;
+		finished.reserve(n);
+		::std::vector< ::std::pair<long, IncidentEdgeView::iterator> > stack;
+		for (long s = 0; s < n; ++ s) {
+			if (visited[s] || !has_vertex(s))
+				continue;
+			visited[s] = 1;
+			stack.push_back(::std::make_pair(s, IncidentEdgeView(graph, s, OutNeighbors).begin()));
+			while (!stack.empty()) {
+				long v = stack.back().first;
+				IncidentEdgeView::iterator& it = stack.back().second;
+				IncidentEdgeView::iterator end = IncidentEdgeView(graph, v, OutNeighbors).end();
+				long next = -1;
+				for (; it != end && next < 0; ++ it) {
+					long eid = static_cast<long>(*it);
+					long u = static_cast<long>(VECTOR(graph->to)[eid]);
+					if (!visited[u] && keeps(eid, u))
+						next = u;
+				}
+				if (next < 0) {
+					finished.push_back(v);
+					stack.pop_back();
+				} else {
+					visited[next] = 1;
+					stack.push_back(::std::make_pair(next, IncidentEdgeView(graph, next, OutNeighbors).begin()));
+				}
+			}
+		}
+
+		membership.assign(n, -1);
+		csize.clear();
+		::std::vector<long> queue;
+		XXINTRNL_VisitNeighbors f = {&membership, &queue, 0};
+		for (long i = static_cast<long>(finished.size()) - 1; i >= 0; -- i) {
+			long s = finished[i];
+			if (membership[s] >= 0)
+				continue;
+			f.value = csize.size();
+			membership[s] = f.value;
+			queue.clear();
+			queue.push_back(s);
+			for (::std::size_t head = 0; head < queue.size(); ++ head)
+				for_each_incident(queue[head], InNeighbors, f);
+			csize.push_back(queue.size());
+		}
+		return csize.size();
+	}
+
+	void GraphView::cluster(Vector& cluster_id_each_vertex_belongs_to, Vector& size_of_each_cluster, Graph::Connectedness connectedness) const MAY_THROW_EXCEPTION {
+		::std::vector<long> membership, csize;
+		if (connectedness == Graph::StronglyConnected && igraph_is_directed(graph))
+			label_strong_components(membership, csize);
+		else
+			label_weak_components(membership, csize);
+
+		igraph_vector_t membership_vector, csize_vector;
+		int errcode = igraph_vector_init(&membership_vector, membership.size());
+		if (errcode != IGRAPH_SUCCESS) {
+			TRY(errcode);
+			return;
+		}
+		errcode = igraph_vector_init(&csize_vector, csize.size());
+		if (errcode != IGRAPH_SUCCESS) {
+			igraph_vector_destroy(&membership_vector);
+			TRY(errcode);
+			return;
+		}
+		for (::std::size_t i = 0; i < membership.size(); ++ i)
+			VECTOR(membership_vector)[i] = membership[i];
+		for (::std::size_t i = 0; i < csize.size(); ++ i)
+			VECTOR(csize_vector)[i] = csize[i];
+		cluster_id_each_vertex_belongs_to = ::tempobj::force_move(Vector(&membership_vector, ::tempobj::OwnershipTransferMove));
+		size_of_each_cluster = ::tempobj::force_move(Vector(&csize_vector, ::tempobj::OwnershipTransferMove));
+	}
+
+	Integer GraphView::cluster_count(const Graph::Connectedness connectedness) const MAY_THROW_EXCEPTION {
+		::std::vector<long> membership, csize;
+		if (connectedness == Graph::StronglyConnected && igraph_is_directed(graph))
+			return label_strong_components(membership, csize);
+		else
+			return label_weak_components(membership, csize);
+	}
+
+	bool GraphView::is_connected(const Graph::Connectedness connectedness) const MAY_THROW_EXCEPTION {
+		return cluster_count(connectedness) <= 1;
+	}
+}
+
+#endif
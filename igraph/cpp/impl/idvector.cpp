@@ -0,0 +1,123 @@
+/*
+
+idvector.cpp ... Compact integer vectors of vertex and edge IDs.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_IDVECTOR_CPP
+#define IGRAPH_IDVECTOR_CPP
+
+#include <igraph/cpp/idvector.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace igraph {
+	MEMORY_MANAGER_IMPLEMENTATION_WITH_TEMPLATE(template<typename T>, IdVector, <T>);
+
+	template<typename T>
+	IMPLEMENT_COPY_METHOD_WITH_TEMPLATE(IdVector, <T>) {
+		array = NULL;
+		count = capacity = 0;
+		resize(other.count);
+		// without exceptions, a failed resize leaves the vector empty.
+		if (count == other.count && count > 0)
+			::std::memcpy(array, other.array, other.count * sizeof(T));
+	}
+
+	template<typename T>
+	IMPLEMENT_MOVE_METHOD_WITH_TEMPLATE(IdVector, <T>) {
+		array = ::std::move(other.array);
+		count = ::std::move(other.count);
+		capacity = ::std::move(other.capacity);
+	}
+
+	template<typename T>
+	IMPLEMENT_DEALLOC_METHOD_WITH_TEMPLATE(IdVector, <T>) {
+		::std::free(array);
+	}
+
+	template<typename T>
+	IdVector<T>::IdVector() throw() : array(NULL), count(0), capacity(0) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(IdVector, <T>);
+	}
+
+	template<typename T>
+	IdVector<T>::IdVector(const long size) MAY_THROW_EXCEPTION : array(NULL), count(0), capacity(0) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(IdVector, <T>);
+		resize(size);
+		if (count > 0)
+			::std::memset(array, 0, count * sizeof(T));
+	}
+
+	template<typename T>
+	IdVector<T>::IdVector(const BasicVector<Real>& vec) MAY_THROW_EXCEPTION : array(NULL), count(0), capacity(0) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(IdVector, <T>);
+		const Real* src = vec.begin();
+		// the exclusive upper bound, so that it is exact even when the largest T is not.
+		const Real lowest = static_cast<Real>(::std::numeric_limits<T>::min());
+		const Real end = static_cast<Real>(::std::numeric_limits<T>::max()) + 1;
+		for (long i = 0; i < vec.size(); ++ i) {
+			if (!(src[i] >= lowest && src[i] < end)) {
+				TRY(IGRAPH_EINVAL);
+				return;
+			}
+		}
+		resize(vec.size());
+		for (long i = 0; i < count; ++ i)
+			array[i] = static_cast<T>(src[i]);
+	}
+
+	template<typename T>
+	::tempobj::force_temporary_class<BasicVector<Real> >::type IdVector<T>::as_vector() const MAY_THROW_EXCEPTION {
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, count));
+		for (long i = 0; i < count; ++ i)
+			VECTOR(res)[i] = array[i];
+		return ::tempobj::force_move(BasicVector<Real>(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	template<typename T>
+	IdVector<T>& IdVector<T>::reserve(const long new_capacity) MAY_THROW_EXCEPTION {
+		if (new_capacity <= capacity)
+			return *this;
+		T* new_array = reinterpret_cast<T*>(::std::realloc(array, new_capacity * sizeof(T)));
+		if (new_array == NULL) {
+			TRY(IGRAPH_ENOMEM);
+			return *this;
+		}
+		array = new_array;
+		capacity = new_capacity;
+		return *this;
+	}
+
+	template<typename T>
+	IdVector<T>& IdVector<T>::resize(const long new_size) MAY_THROW_EXCEPTION {
+		reserve(new_size);
+		if (new_size <= capacity)
+			count = new_size;
+		return *this;
+	}
+
+	template<typename T>
+	bool IdVector<T>::operator== (const IdVector<T>& other) const throw() {
+		return count == other.count && (count == 0 || ::std::memcmp(array, other.array, count * sizeof(T)) == 0);
+	}
+}
+
+#endif
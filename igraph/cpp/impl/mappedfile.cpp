@@ -0,0 +1,122 @@
+/*
+
+mappedfile.cpp ... Read-only memory mapped files.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_MAPPEDFILE_CPP
+#define IGRAPH_MAPPEDFILE_CPP
+
+#include <igraph/cpp/mappedfile.hpp>
+#include <cstdlib>
+#if XXINTRNL_HAVE_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace igraph {
+	MEMORY_MANAGER_IMPLEMENTATION_NO_COPYING(MappedFile);
+	
+	IMPLEMENT_MOVE_METHOD(MappedFile) {
+		data = ::std::move(other.data);
+		length = ::std::move(other.length);
+		offset = ::std::move(other.offset);
+		mapped = ::std::move(other.mapped);
+	}
+	IMPLEMENT_DEALLOC_METHOD(MappedFile) {
+#if XXINTRNL_HAVE_MMAP
+		if (mapped) {
+			munmap(data, length);
+			return;
+		}
+#endif
+		::std::free(data);
+	}
+	
+	MappedFile::MappedFile(::std::FILE* filestream) MAY_THROW_EXCEPTION : data(NULL), length(0), offset(0), mapped(false) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(MappedFile);
+		TRY(map_stream(filestream));
+	}
+	
+	MappedFile::MappedFile(const char* filename) MAY_THROW_EXCEPTION : data(NULL), length(0), offset(0), mapped(false) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(MappedFile);
+		::std::FILE* filestream = ::std::fopen(filename, "rb");
+		if (filestream == NULL) {
+			TRY(IGRAPH_EFILE);
+			return;
+		}
+		int errcode = map_stream(filestream);
+		// the mapping stays valid after the descriptor is closed.
+		::std::fclose(filestream);
+		TRY(errcode);
+	}
+	
+	int MappedFile::map_stream(::std::FILE* filestream) throw() {
+#if XXINTRNL_HAVE_MMAP
+		int fd = fileno(filestream);
+		long position = ::std::ftell(filestream);
+		struct stat st;
+		if (fd >= 0 && position >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+			void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (addr != MAP_FAILED) {
+				madvise(addr, st.st_size, MADV_SEQUENTIAL);
+				data = reinterpret_cast<char*>(addr);
+				length = st.st_size;
+				offset = static_cast< ::std::size_t>(position) < length ? position : length;
+				mapped = true;
+				::std::fseek(filestream, 0, SEEK_END);
+				return IGRAPH_SUCCESS;
+			}
+		}
+#endif
+		return read_stream(filestream);
+	}
+	
+	int MappedFile::read_stream(::std::FILE* filestream) throw() {
+		::std::size_t capacity = 1 << 16;
+		data = reinterpret_cast<char*>(::std::malloc(capacity));
+		if (data == NULL)
+			return IGRAPH_ENOMEM;
+		
+		while (true) {
+			length += ::std::fread(data + length, 1, capacity - length, filestream);
+			if (length < capacity)
+				break;
+			capacity *= 2;
+			char* new_data = reinterpret_cast<char*>(::std::realloc(data, capacity));
+			if (new_data == NULL) {
+				::std::free(data);
+				data = NULL;
+				length = 0;
+				return IGRAPH_ENOMEM;
+			}
+			data = new_data;
+		}
+		if (::std::ferror(filestream)) {
+			::std::free(data);
+			data = NULL;
+			length = 0;
+			return IGRAPH_EFILE;
+		}
+		return IGRAPH_SUCCESS;
+	}
+}
+
+#endif
@@ -39,29 +39,68 @@ template<> ::tempobj::force_temporary_class<BasicMatrix<BASE> >::type BasicMatri
 
 template<> BasicMatrix<BASE>::BasicMatrix(const char* stringized_elements, const char* row_separator) MAY_THROW_EXCEPTION {
 	XXINTRNL_DEBUG_CALL_INITIALIZER(BasicMatrix, <BASE>);
-	TRY(FUNC(init)(&_, 1, 1));
-	long i = 0, j = 0, cols = 1;
-	size_t rowsep_len = ::std::strlen(row_separator);
-	const char* end_of_string = ::std::strchr(stringized_elements, '\0');
-	while (stringized_elements < end_of_string) {
-		BASE res;
-		if (XXINTRNL_sscanf(stringized_elements, res)) {
-			if (j >= cols) {
-				TRY(FUNC(add_cols)(&_, 1));
-				++ cols;
-			}
-			MATRIX(_, i, j) = res;
-			++ j;
-		} else if (::std::memcmp(stringized_elements-1, row_separator, rowsep_len) == 0) {
-			TRY(FUNC(add_rows)(&_, 1));
-			j = 0;
-			++ i;
-			stringized_elements += rowsep_len-1;
-		}
-	}
-	if (j == 0) {
-		TRY(FUNC(remove_row)(&_, i));
+	// collect the numbers and the end of each row first, so the matrix is allocated only once.
+	XXINTRNL_NumberScanner<BASE> scanner (stringized_elements, row_separator);
+	::std::vector<BASE> elements;
+	elements.reserve(scanner.count_estimate());
+	::std::vector<long> row_ends;
+	BASE res;
+	typename XXINTRNL_NumberScanner<BASE>::Token token;
+	while ((token = scanner.next(res)) != XXINTRNL_NumberScanner<BASE>::Token_End) {
+		if (token == XXINTRNL_NumberScanner<BASE>::Token_Number)
+			elements.push_back(res);
+		else
+			row_ends.push_back(elements.size());
 	}
+	// an empty last row is dropped.
+	long last_row_begin = row_ends.empty() ? 0 : row_ends.back();
+	if (static_cast<long>(elements.size()) > last_row_begin)
+		row_ends.push_back(elements.size());
+	
+	long rows = row_ends.size(), cols = 1;
+	for (long i = 0, row_begin = 0; i < rows; row_begin = row_ends[i], ++ i)
+		if (row_ends[i] - row_begin > cols)
+			cols = row_ends[i] - row_begin;
+	
+	TRY(FUNC(init)(&_, rows, cols));
+	for (long i = 0, row_begin = 0; i < rows; row_begin = row_ends[i], ++ i)
+		for (long j = 0; row_begin + j < row_ends[i]; ++ j)
+			MATRIX(_, i, j) = elements[row_begin + j];
+}
+
+#pragma mark -
+#pragma mark Saving and loading
+
+template<> void BasicMatrix<BASE>::save(::std::FILE* filestream) const MAY_THROW_EXCEPTION {
+	TRY(XXINTRNL_save_array(filestream, XXINTRNL_matrix_magic, VECTOR(_.data), _.nrow, _.ncol, _.nrow * _.ncol));
+}
+template<> void BasicMatrix<BASE>::save(const char* filename) const MAY_THROW_EXCEPTION {
+	XXINTRNL_save_array_to_file(filename, XXINTRNL_matrix_magic, VECTOR(_.data), _.nrow, _.ncol, _.nrow * _.ncol);
+}
+
+template<> ::tempobj::force_temporary_class<BasicMatrix<BASE> >::type BasicMatrix<BASE>::load(const MappedFile& file) MAY_THROW_EXCEPTION {
+	XXINTRNL_SavedArray<BASE> saved (file, true);
+	TYPE _;
+	TRY(FUNC(init)(&_, saved.rows, saved.cols));
+	saved.copy_to(VECTOR(_.data));
+	return ::tempobj::force_move(BasicMatrix<BASE>(&_, ::tempobj::OwnershipTransferMove));
+}
+template<> ::tempobj::force_temporary_class<BasicMatrix<BASE> >::type BasicMatrix<BASE>::load(::std::FILE* filestream) MAY_THROW_EXCEPTION {
+	MappedFile content (filestream);
+	return ::tempobj::force_move(load(content));
+}
+template<> ::tempobj::force_temporary_class<BasicMatrix<BASE> >::type BasicMatrix<BASE>::load(const char* filename) MAY_THROW_EXCEPTION {
+	MappedFile content (filename);
+	return ::tempobj::force_move(load(content));
+}
+
+template<> ::tempobj::force_temporary_class<BasicMatrix<BASE> >::type BasicMatrix<BASE>::view(const MappedFile& file) MAY_THROW_EXCEPTION {
+	XXINTRNL_SavedArray<BASE> saved (file, true);
+	if (!saved.can_view())
+		return ::tempobj::force_move(load(file));
+	TYPE _;
+	FUNC(view)(&_, reinterpret_cast<const BASE*>(saved.payload), saved.rows, saved.cols);
+	return ::tempobj::force_move(BasicMatrix<BASE>(&_, ::tempobj::OwnershipTransferNoOwnership));
 }
 
 #pragma mark -
@@ -24,6 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <igraph/cpp/matrix.hpp>
 #include <cstring>
+#include <vector>
 
 namespace igraph {
 	
@@ -0,0 +1,82 @@
+/*
+
+sharedgraph.cpp ... Graphs shared between owners until one of them changes it.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_SHAREDGRAPH_CPP
+#define IGRAPH_SHAREDGRAPH_CPP
+
+#include <igraph/cpp/sharedgraph.hpp>
+#include <igraph/cpp/graph.hpp>
+
+namespace igraph {
+	struct SharedGraph::Block {
+		Graph graph;
+		long references;
+
+		Block(const Graph& g) : graph(g), references(1) {}
+		Block(XXINTRNL_PARAMTYPE(, Graph) g) : graph(::std::move(g)), references(1) {}
+	};
+
+	MEMORY_MANAGER_IMPLEMENTATION(SharedGraph);
+
+	IMPLEMENT_COPY_METHOD(SharedGraph) {
+		shared = other.shared;
+		__sync_add_and_fetch(&shared->references, 1);
+	}
+	IMPLEMENT_MOVE_METHOD(SharedGraph) {
+		shared = ::std::move(other.shared);
+	}
+	IMPLEMENT_DEALLOC_METHOD(SharedGraph) {
+		release();
+	}
+
+	void SharedGraph::release() throw() {
+		if (__sync_sub_and_fetch(&shared->references, 1) == 0)
+			delete shared;
+	}
+
+	SharedGraph::SharedGraph(const Graph& g) : shared(new Block(g)) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(SharedGraph);
+	}
+	SharedGraph::SharedGraph(XXINTRNL_PARAMTYPE(, Graph) g) : shared(new Block(::std::move(g))) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(SharedGraph);
+	}
+
+	const Graph& SharedGraph::graph() const throw() {
+		return shared->graph;
+	}
+
+	long SharedGraph::use_count() const throw() {
+		// an atomic read.
+		return __sync_add_and_fetch(&shared->references, 0);
+	}
+
+	Graph& SharedGraph::mutate() {
+		// once this is the only reference, no other can appear except by copying this object.
+		if (use_count() != 1) {
+			Block* copy = new Block(shared->graph);
+			release();
+			shared = copy;
+		}
+		return shared->graph;
+	}
+}
+
+#endif
@@ -0,0 +1,199 @@
+/*
+
+simd.4.cpp ... Macro-parametrized vector kernels for each instruction set.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+// Included by simd.cpp once for each instruction set, with these macros:
+//   SIMD(x)       the name of kernel x for this instruction set
+//   TARGET        the target attribute, e.g. "avx2"
+//   RV, RW        the vector type of Real and its number of lanes
+//   R_*           the Real operations
+//   LV, LW, L_*   the same for long
+//   L_HAS_MINMAX  whether L_MIN and L_MAX exist
+
+#define ATTR static __attribute__((target(TARGET)))
+
+#define XXINTRNL_SIMD_REAL_BINARY(name, op, vop) \
+ATTR void SIMD(name)(Real* a, const Real* b, const long n) throw() { \
+	long i = 0; \
+	for (; i + RW <= n; i += RW) \
+		R_STOREU(a + i, vop(R_LOADU(a + i), R_LOADU(b + i))); \
+	for (; i < n; ++ i) \
+		a[i] op##= b[i]; \
+}
+
+#define XXINTRNL_SIMD_REAL_CONSTANT(name, op, vop) \
+ATTR void SIMD(name)(Real* a, const long n, const Real k) throw() { \
+	RV kk = R_SET1(k); \
+	long i = 0; \
+	for (; i + RW <= n; i += RW) \
+		R_STOREU(a + i, vop(R_LOADU(a + i), kk)); \
+	for (; i < n; ++ i) \
+		a[i] op##= k; \
+}
+
+XXINTRNL_SIMD_REAL_BINARY(add, +, R_ADD)
+XXINTRNL_SIMD_REAL_BINARY(sub, -, R_SUB)
+XXINTRNL_SIMD_REAL_BINARY(mul, *, R_MUL)
+XXINTRNL_SIMD_REAL_BINARY(div, /, R_DIV)
+XXINTRNL_SIMD_REAL_CONSTANT(add_constant, +, R_ADD)
+XXINTRNL_SIMD_REAL_CONSTANT(scale, *, R_MUL)
+
+/// Reduce the lanes and the elements after the last full vector with op.
+#define XXINTRNL_SIMD_REDUCE(T, W, STOREU, acc, res, op, a, i, n) \
+	T lanes[W]; \
+	STOREU(lanes, acc); \
+	res = lanes[0]; \
+	for (int j = 1; j < W; ++ j) \
+		res = res op lanes[j]; \
+	for (; i < n; ++ i) \
+		res = res op a[i];
+
+ATTR Real SIMD(sum)(const Real* a, const long n) throw() {
+	RV acc = R_SET1(0);
+	long i = 0;
+	for (; i + RW <= n; i += RW)
+		acc = R_ADD(acc, R_LOADU(a + i));
+	Real res;
+	XXINTRNL_SIMD_REDUCE(Real, RW, R_STOREU, acc, res, +, a, i, n);
+	return res;
+}
+
+ATTR Real SIMD(prod)(const Real* a, const long n) throw() {
+	RV acc = R_SET1(1);
+	long i = 0;
+	for (; i + RW <= n; i += RW)
+		acc = R_MUL(acc, R_LOADU(a + i));
+	Real res;
+	XXINTRNL_SIMD_REDUCE(Real, RW, R_STOREU, acc, res, *, a, i, n);
+	return res;
+}
+
+/**
+ n must be positive. Like igraph, a[i] replaces the minimum only if it is
+ smaller, so NaN elements are skipped unless a[0] is NaN, which is then
+ the result. R_MIN(x, m) returns m unless x < m, which keeps this.
+ */
+ATTR void SIMD(minmax)(const Real* a, const long n, Real& min, Real& max) throw() {
+	min = max = a[0];
+	long i = 0;
+	if (n >= RW) {
+		RV vmin = R_SET1(a[0]), vmax = vmin;
+		for (; i + RW <= n; i += RW) {
+			RV x = R_LOADU(a + i);
+			vmin = R_MIN(x, vmin);
+			vmax = R_MAX(x, vmax);
+		}
+		Real lanes[RW];
+		R_STOREU(lanes, vmin);
+		for (int j = 0; j < RW; ++ j)
+			min = lanes[j] < min ? lanes[j] : min;
+		R_STOREU(lanes, vmax);
+		for (int j = 0; j < RW; ++ j)
+			max = lanes[j] > max ? lanes[j] : max;
+	}
+	for (; i < n; ++ i) {
+		min = a[i] < min ? a[i] : min;
+		max = a[i] > max ? a[i] : max;
+	}
+}
+
+/// The largest |a[i] - b[i]|, or 0.
+ATTR Real SIMD(maxdifference)(const Real* a, const Real* b, const long n) throw() {
+	RV zero = R_SET1(0), acc = zero;
+	long i = 0;
+	for (; i + RW <= n; i += RW) {
+		RV d = R_SUB(R_LOADU(a + i), R_LOADU(b + i));
+		acc = R_MAX(R_MAX(d, R_SUB(zero, d)), acc);	// a NaN difference keeps acc, as in igraph.
+	}
+	Real lanes[RW];
+	R_STOREU(lanes, acc);
+	Real res = 0;
+	for (int j = 0; j < RW; ++ j)
+		res = lanes[j] > res ? lanes[j] : res;
+	for (; i < n; ++ i) {
+		Real d = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+		res = d > res ? d : res;
+	}
+	return res;
+}
+
+#define XXINTRNL_SIMD_LONG_BINARY(name, op, vop) \
+ATTR void SIMD(name)(long* a, const long* b, const long n) throw() { \
+	long i = 0; \
+	for (; i + LW <= n; i += LW) \
+		L_STOREU(a + i, vop(L_LOADU(a + i), L_LOADU(b + i))); \
+	for (; i < n; ++ i) \
+		a[i] op##= b[i]; \
+}
+
+XXINTRNL_SIMD_LONG_BINARY(add_long, +, L_ADD)
+XXINTRNL_SIMD_LONG_BINARY(sub_long, -, L_SUB)
+
+ATTR void SIMD(add_constant_long)(long* a, const long n, const long k) throw() {
+	LV kk = L_SET1(k);
+	long i = 0;
+	for (; i + LW <= n; i += LW)
+		L_STOREU(a + i, L_ADD(L_LOADU(a + i), kk));
+	for (; i < n; ++ i)
+		a[i] += k;
+}
+
+ATTR long SIMD(sum_long)(const long* a, const long n) throw() {
+	LV acc = L_SET1(0);
+	long i = 0;
+	for (; i + LW <= n; i += LW)
+		acc = L_ADD(acc, L_LOADU(a + i));
+	long res;
+	XXINTRNL_SIMD_REDUCE(long, LW, L_STOREU, acc, res, +, a, i, n);
+	return res;
+}
+
+#if L_HAS_MINMAX
+/// n must be positive.
+ATTR void SIMD(minmax_long)(const long* a, const long n, long& min, long& max) throw() {
+	min = max = a[0];
+	long i = 0;
+	if (n >= LW) {
+		LV vmin = L_LOADU(a), vmax = vmin;
+		for (i = LW; i + LW <= n; i += LW) {
+			LV x = L_LOADU(a + i);
+			vmin = L_MIN(vmin, x);
+			vmax = L_MAX(vmax, x);
+		}
+		long lanes[LW];
+		L_STOREU(lanes, vmin);
+		for (int j = 0; j < LW; ++ j)
+			min = lanes[j] < min ? lanes[j] : min;
+		L_STOREU(lanes, vmax);
+		for (int j = 0; j < LW; ++ j)
+			max = lanes[j] > max ? lanes[j] : max;
+	}
+	for (; i < n; ++ i) {
+		min = a[i] < min ? a[i] : min;
+		max = a[i] > max ? a[i] : max;
+	}
+}
+#endif
+
+#undef XXINTRNL_SIMD_LONG_BINARY
+#undef XXINTRNL_SIMD_REDUCE
+#undef XXINTRNL_SIMD_REAL_CONSTANT
+#undef XXINTRNL_SIMD_REAL_BINARY
+#undef ATTR
@@ -0,0 +1,284 @@
+/*
+
+simd.cpp ... Vectorized kernels for Real and long vectors, chosen at run time.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_SIMD_CPP
+#define IGRAPH_SIMD_CPP
+
+#include <igraph/cpp/common.hpp>
+
+// The kernels need the target attribute with intrinsics (gcc 5 or clang 4), and a 64-bit long.
+#if !IGRAPH_NO_SIMD && defined(__x86_64__) && defined(__LP64__) && ((defined(__clang__) && __clang_major__ >= 4) || (!defined(__clang__) && __GNUC__ >= 5))
+#define XXINTRNL_HAVE_SIMD 1
+#else
+#define XXINTRNL_HAVE_SIMD 0
+#endif
+
+#if XXINTRNL_HAVE_SIMD
+#include <immintrin.h>
+#endif
+
+namespace igraph {
+	/**
+	 \internal
+	 \brief Kernels for the arithmetic and reductions of BasicVector.
+
+	 Each XXINTRNL_simd_x() returns false if there is no kernel for the type
+	 or the machine, and the caller then uses the igraph function. The
+	 kernels for Real and long exist for SSE2, AVX2 and AVX-512F, and the
+	 widest one the processor supports is used.
+
+	 Sums and products add or multiply the lanes separately, so they may
+	 differ from igraph in the last bits. Minima and maxima skip NaN elements
+	 as igraph does, and are NaN if the first element is. The largest
+	 difference skips NaN differences.
+
+	 Define IGRAPH_NO_SIMD to use igraph everywhere.
+	 */
+	template <typename T> static inline bool XXINTRNL_simd_add_constant(T*, const long, const T) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_scale(T*, const long, const T) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_add(T*, const T*, const long) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_sub(T*, const T*, const long) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_mul(T*, const T*, const long) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_div(T*, const T*, const long) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_sum(const T*, const long, Real&) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_prod(const T*, const long, Real&) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_minmax(const T*, const long, T&, T&) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_simd_maxdifference(const T*, const T*, const long, T&) throw() { return false; }
+	template <typename T> static inline bool XXINTRNL_is_nan(const T) throw() { return false; }
+	static inline bool XXINTRNL_is_nan(const Real x) throw() { return x != x; }
+
+#if XXINTRNL_HAVE_SIMD
+#define TARGET "sse2"
+#define SIMD(x) XXINTRNL_sse2_##x
+#define RV __m128d
+#define RW 2
+#define R_LOADU _mm_loadu_pd
+#define R_STOREU _mm_storeu_pd
+#define R_SET1 _mm_set1_pd
+#define R_ADD _mm_add_pd
+#define R_SUB _mm_sub_pd
+#define R_MUL _mm_mul_pd
+#define R_DIV _mm_div_pd
+#define R_MIN _mm_min_pd
+#define R_MAX _mm_max_pd
+#define LV __m128i
+#define LW 2
+#define L_LOADU(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+#define L_STOREU(p, v) _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v)
+#define L_SET1 _mm_set1_epi64x
+#define L_ADD _mm_add_epi64
+#define L_SUB _mm_sub_epi64
+#define L_HAS_MINMAX 0	// 64-bit comparisons need SSE4.2.
+#include <igraph/cpp/impl/simd.4.cpp>
+#undef L_HAS_MINMAX
+#undef L_SUB
+#undef L_ADD
+#undef L_SET1
+#undef L_STOREU
+#undef L_LOADU
+#undef LW
+#undef LV
+#undef R_MAX
+#undef R_MIN
+#undef R_DIV
+#undef R_MUL
+#undef R_SUB
+#undef R_ADD
+#undef R_SET1
+#undef R_STOREU
+#undef R_LOADU
+#undef RW
+#undef RV
+#undef SIMD
+#undef TARGET
+
+	/// The smaller and the larger of a and b, compared as signed 64-bit integers.
+	static __attribute__((target("avx2"))) inline __m256i XXINTRNL_avx2_min_epi64(const __m256i a, const __m256i b) throw() {
+		return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+	}
+	static __attribute__((target("avx2"))) inline __m256i XXINTRNL_avx2_max_epi64(const __m256i a, const __m256i b) throw() {
+		return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+	}
+
+#define TARGET "avx2"
+#define SIMD(x) XXINTRNL_avx2_##x
+#define RV __m256d
+#define RW 4
+#define R_LOADU _mm256_loadu_pd
+#define R_STOREU _mm256_storeu_pd
+#define R_SET1 _mm256_set1_pd
+#define R_ADD _mm256_add_pd
+#define R_SUB _mm256_sub_pd
+#define R_MUL _mm256_mul_pd
+#define R_DIV _mm256_div_pd
+#define R_MIN _mm256_min_pd
+#define R_MAX _mm256_max_pd
+#define LV __m256i
+#define LW 4
+#define L_LOADU(p) _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+#define L_STOREU(p, v) _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v)
+#define L_SET1 _mm256_set1_epi64x
+#define L_ADD _mm256_add_epi64
+#define L_SUB _mm256_sub_epi64
+#define L_MIN XXINTRNL_avx2_min_epi64
+#define L_MAX XXINTRNL_avx2_max_epi64
+#define L_HAS_MINMAX 1
+#include <igraph/cpp/impl/simd.4.cpp>
+#undef L_HAS_MINMAX
+#undef L_MAX
+#undef L_MIN
+#undef L_SUB
+#undef L_ADD
+#undef L_SET1
+#undef L_STOREU
+#undef L_LOADU
+#undef LW
+#undef LV
+#undef R_MAX
+#undef R_MIN
+#undef R_DIV
+#undef R_MUL
+#undef R_SUB
+#undef R_ADD
+#undef R_SET1
+#undef R_STOREU
+#undef R_LOADU
+#undef RW
+#undef RV
+#undef SIMD
+#undef TARGET
+
+// gcc 12 warns about the undefined vectors which the AVX-512 min and max intrinsics start from.
+#if !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#define TARGET "avx512f"
+#define SIMD(x) XXINTRNL_avx512_##x
+#define RV __m512d
+#define RW 8
+#define R_LOADU _mm512_loadu_pd
+#define R_STOREU _mm512_storeu_pd
+#define R_SET1 _mm512_set1_pd
+#define R_ADD _mm512_add_pd
+#define R_SUB _mm512_sub_pd
+#define R_MUL _mm512_mul_pd
+#define R_DIV _mm512_div_pd
+#define R_MIN _mm512_min_pd
+#define R_MAX _mm512_max_pd
+#define LV __m512i
+#define LW 8
+#define L_LOADU _mm512_loadu_si512
+#define L_STOREU _mm512_storeu_si512
+#define L_SET1 _mm512_set1_epi64
+#define L_ADD _mm512_add_epi64
+#define L_SUB _mm512_sub_epi64
+#define L_MIN _mm512_min_epi64
+#define L_MAX _mm512_max_epi64
+#define L_HAS_MINMAX 1
+#include <igraph/cpp/impl/simd.4.cpp>
+#undef L_HAS_MINMAX
+#undef L_MAX
+#undef L_MIN
+#undef L_SUB
+#undef L_ADD
+#undef L_SET1
+#undef L_STOREU
+#undef L_LOADU
+#undef LW
+#undef LV
+#undef R_MAX
+#undef R_MIN
+#undef R_DIV
+#undef R_MUL
+#undef R_SUB
+#undef R_ADD
+#undef R_SET1
+#undef R_STOREU
+#undef R_LOADU
+#undef RW
+#undef RV
+#undef SIMD
+#undef TARGET
+#if !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+	enum XXINTRNL_SimdLevel {
+		XXINTRNL_SimdLevel_SSE2 = 1,
+		XXINTRNL_SimdLevel_AVX2,
+		XXINTRNL_SimdLevel_AVX512,
+	};
+
+	/// The widest instruction set of this processor, detected once.
+	static inline XXINTRNL_SimdLevel XXINTRNL_simd_level() throw() {
+		// every thread stores the same value, so the race is harmless.
+		static int level = 0;
+		if (level == 0) {
+			__builtin_cpu_init();
+			level = __builtin_cpu_supports("avx512f") ? XXINTRNL_SimdLevel_AVX512 : __builtin_cpu_supports("avx2") ? XXINTRNL_SimdLevel_AVX2 : XXINTRNL_SimdLevel_SSE2;
+		}
+		return static_cast<XXINTRNL_SimdLevel>(level);
+	}
+
+/// Call the kernel of the widest instruction set, and assign its result to res if given.
+#define XXINTRNL_SIMD_DISPATCH(res, name, ...) \
+	switch (XXINTRNL_simd_level()) { \
+		case XXINTRNL_SimdLevel_AVX512: res XXINTRNL_avx512_##name(__VA_ARGS__); break; \
+		case XXINTRNL_SimdLevel_AVX2: res XXINTRNL_avx2_##name(__VA_ARGS__); break; \
+		default: res XXINTRNL_sse2_##name(__VA_ARGS__); break; \
+	}
+
+	static inline bool XXINTRNL_simd_add_constant(Real* a, const long n, const Real k) throw() { XXINTRNL_SIMD_DISPATCH(, add_constant, a, n, k); return true; }
+	static inline bool XXINTRNL_simd_scale(Real* a, const long n, const Real k) throw() { XXINTRNL_SIMD_DISPATCH(, scale, a, n, k); return true; }
+	static inline bool XXINTRNL_simd_add(Real* a, const Real* b, const long n) throw() { XXINTRNL_SIMD_DISPATCH(, add, a, b, n); return true; }
+	static inline bool XXINTRNL_simd_sub(Real* a, const Real* b, const long n) throw() { XXINTRNL_SIMD_DISPATCH(, sub, a, b, n); return true; }
+	static inline bool XXINTRNL_simd_mul(Real* a, const Real* b, const long n) throw() { XXINTRNL_SIMD_DISPATCH(, mul, a, b, n); return true; }
+	static inline bool XXINTRNL_simd_div(Real* a, const Real* b, const long n) throw() { XXINTRNL_SIMD_DISPATCH(, div, a, b, n); return true; }
+	static inline bool XXINTRNL_simd_sum(const Real* a, const long n, Real& res) throw() { XXINTRNL_SIMD_DISPATCH(res =, sum, a, n); return true; }
+	static inline bool XXINTRNL_simd_prod(const Real* a, const long n, Real& res) throw() { XXINTRNL_SIMD_DISPATCH(res =, prod, a, n); return true; }
+	static inline bool XXINTRNL_simd_minmax(const Real* a, const long n, Real& min, Real& max) throw() {
+		if (n == 0)
+			return false;
+		XXINTRNL_SIMD_DISPATCH(, minmax, a, n, min, max);
+		return true;
+	}
+	static inline bool XXINTRNL_simd_maxdifference(const Real* a, const Real* b, const long n, Real& res) throw() { XXINTRNL_SIMD_DISPATCH(res =, maxdifference, a, b, n); return true; }
+
+	static inline bool XXINTRNL_simd_add_constant(long* a, const long n, const long k) throw() { XXINTRNL_SIMD_DISPATCH(, add_constant_long, a, n, k); return true; }
+	static inline bool XXINTRNL_simd_add(long* a, const long* b, const long n) throw() { XXINTRNL_SIMD_DISPATCH(, add_long, a, b, n); return true; }
+	static inline bool XXINTRNL_simd_sub(long* a, const long* b, const long n) throw() { XXINTRNL_SIMD_DISPATCH(, sub_long, a, b, n); return true; }
+	static inline bool XXINTRNL_simd_sum(const long* a, const long n, Real& res) throw() { XXINTRNL_SIMD_DISPATCH(res =, sum_long, a, n); return true; }
+	static inline bool XXINTRNL_simd_minmax(const long* a, const long n, long& min, long& max) throw() {
+		if (n == 0)
+			return false;
+		switch (XXINTRNL_simd_level()) {
+			case XXINTRNL_SimdLevel_AVX512: XXINTRNL_avx512_minmax_long(a, n, min, max); return true;
+			case XXINTRNL_SimdLevel_AVX2: XXINTRNL_avx2_minmax_long(a, n, min, max); return true;
+			default: return false;
+		}
+	}
+
+#undef XXINTRNL_SIMD_DISPATCH
+#endif
+}
+
+#endif
@@ -0,0 +1,301 @@
+/*
+
+sparsematrix.cpp ... Real matrices in compressed sparse row form.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_SPARSEMATRIX_CPP
+#define IGRAPH_SPARSEMATRIX_CPP
+
+#include <igraph/cpp/sparsematrix.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace igraph {
+	MEMORY_MANAGER_IMPLEMENTATION(SparseMatrix);
+
+	IMPLEMENT_COPY_METHOD(SparseMatrix) {
+		row_count = other.row_count;
+		col_count = other.col_count;
+		offset_array = other.offset_array;
+		column_array = other.column_array;
+		value_array = other.value_array;
+	}
+	IMPLEMENT_MOVE_METHOD(SparseMatrix) {
+		row_count = ::std::move(other.row_count);
+		col_count = ::std::move(other.col_count);
+		offset_array.swap(other.offset_array);
+		column_array.swap(other.column_array);
+		value_array.swap(other.value_array);
+	}
+	IMPLEMENT_DEALLOC_METHOD(SparseMatrix) {
+		::std::vector<long>().swap(offset_array);
+		::std::vector<long>().swap(column_array);
+		::std::vector<Real>().swap(value_array);
+	}
+
+	SparseMatrix::SparseMatrix() throw() : row_count(0), col_count(0), offset_array(1, 0) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(SparseMatrix);
+	}
+
+	SparseMatrix::SparseMatrix(const long nrow, const long ncol) : row_count(nrow), col_count(ncol), offset_array(nrow + 1, 0) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(SparseMatrix);
+	}
+
+	SparseMatrix::SparseMatrix(const Matrix& dense) {
+		XXINTRNL_DEBUG_CALL_INITIALIZER(SparseMatrix);
+		reset(dense.nrow(), dense.ncol());
+		for (long i = 0; i < row_count; ++ i) {
+			for (long j = 0; j < col_count; ++ j)
+				if (dense(i, j) != 0)
+					push(j, dense(i, j));
+			end_row();
+		}
+	}
+
+	void SparseMatrix::reset(const long nrow, const long ncol) {
+		row_count = nrow;
+		col_count = ncol;
+		offset_array.assign(1, 0);
+		offset_array.reserve(nrow + 1);
+		column_array.clear();
+		value_array.clear();
+	}
+
+	/// Sort by row with a counting sort, then sort each row by column and add up the entries at the same position.
+	void SparseMatrix::assign_triplets(const long nrow, const long ncol, const ::std::vector<long>& rows, const ::std::vector<long>& cols, const ::std::vector<Real>& values) {
+		long count = static_cast<long>(rows.size());
+		::std::vector<long> position (nrow + 1, 0);
+		for (long k = 0; k < count; ++ k)
+			++ position[rows[k] + 1];
+		for (long i = 0; i < nrow; ++ i)
+			position[i+1] += position[i];
+		::std::vector< ::std::pair<long, Real> > entries (count);
+		::std::vector<long> next (position.begin(), position.end() - 1);
+		for (long k = 0; k < count; ++ k)
+			entries[next[rows[k]]++] = ::std::make_pair(cols[k], values[k]);
+
+		reset(nrow, ncol);
+		for (long i = 0; i < nrow; ++ i) {
+			::std::vector< ::std::pair<long, Real> >::iterator first = entries.begin() + position[i], last = entries.begin() + position[i+1];
+			::std::sort(first, last);
+			while (first != last) {
+				long column = first->first;
+				Real total = 0;
+				for (; first != last && first->first == column; ++ first)
+					total += first->second;
+				if (total != 0)
+					push(column, total);
+			}
+			end_row();
+		}
+	}
+
+	::tempobj::force_temporary_class<SparseMatrix>::type SparseMatrix::from_triplets(const long nrow, const long ncol, const Vector& rows, const Vector& cols, const Vector& values) MAY_THROW_EXCEPTION {
+		SparseMatrix res (nrow, ncol);
+		long count = rows.size();
+		if (cols.size() != count || values.size() != count) {
+			TRY(IGRAPH_EINVAL);
+			return ::tempobj::force_move(res);
+		}
+		::std::vector<long> row_ids (count), col_ids (count);
+		for (long k = 0; k < count; ++ k) {
+			// checked before the conversion, which is undefined for NaN.
+			if (!(rows[k] >= 0 && rows[k] < nrow && cols[k] >= 0 && cols[k] < ncol)) {
+				TRY(IGRAPH_EINVAL);
+				return ::tempobj::force_move(res);
+			}
+			row_ids[k] = static_cast<long>(rows[k]);
+			col_ids[k] = static_cast<long>(cols[k]);
+		}
+		res.assign_triplets(nrow, ncol, row_ids, col_ids, ::std::vector<Real>(values.begin(), values.end()));
+		return ::tempobj::force_move(res);
+	}
+
+	Real SparseMatrix::operator() (const long i, const long j) const throw() {
+		const long* first = columns() + offset_array[i];
+		const long* last = columns() + offset_array[i+1];
+		const long* p = ::std::lower_bound(first, last, j);
+		return (p != last && *p == j) ? value_array[p - columns()] : 0;
+	}
+
+	/// A counting sort by column. Walking the rows in order leaves each row of the result sorted.
+	::tempobj::force_temporary_class<SparseMatrix>::type SparseMatrix::transpose() const {
+		SparseMatrix res;
+		res.row_count = col_count;
+		res.col_count = row_count;
+		long m = nonzeros();
+		res.offset_array.assign(col_count + 1, 0);
+		res.column_array.resize(m);
+		res.value_array.resize(m);
+		for (long k = 0; k < m; ++ k)
+			++ res.offset_array[column_array[k] + 1];
+		for (long j = 0; j < col_count; ++ j)
+			res.offset_array[j+1] += res.offset_array[j];
+		::std::vector<long> next (res.offset_array.begin(), res.offset_array.end() - 1);
+		for (long i = 0; i < row_count; ++ i)
+			for (long k = offset_array[i]; k < offset_array[i+1]; ++ k) {
+				long pos = next[column_array[k]]++;
+				res.column_array[pos] = i;
+				res.value_array[pos] = value_array[k];
+			}
+		return ::tempobj::force_move(res);
+	}
+
+	::tempobj::force_temporary_class<Matrix>::type SparseMatrix::to_dense() const MAY_THROW_EXCEPTION {
+		igraph_matrix_t res;
+		TRY(igraph_matrix_init(&res, row_count, col_count));
+		for (long i = 0; i < row_count; ++ i)
+			for (long k = offset_array[i]; k < offset_array[i+1]; ++ k)
+				MATRIX(res, i, column_array[k]) = value_array[k];
+		return ::tempobj::force_move(Matrix(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+#pragma mark -
+#pragma mark Sums
+
+	::tempobj::force_temporary_class<Vector>::type SparseMatrix::rowsum() const MAY_THROW_EXCEPTION {
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, row_count));
+		for (long i = 0; i < row_count; ++ i) {
+			Real total = 0;
+			for (long k = offset_array[i]; k < offset_array[i+1]; ++ k)
+				total += value_array[k];
+			VECTOR(res)[i] = total;
+		}
+		return ::tempobj::force_move(Vector(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	::tempobj::force_temporary_class<Vector>::type SparseMatrix::colsum() const MAY_THROW_EXCEPTION {
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, col_count));
+		long m = nonzeros();
+		for (long k = 0; k < m; ++ k)
+			VECTOR(res)[column_array[k]] += value_array[k];
+		return ::tempobj::force_move(Vector(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	Real SparseMatrix::sum() const throw() {
+		Real total = 0;
+		for (::std::vector<Real>::const_iterator it = value_array.begin(); it != value_array.end(); ++ it)
+			total += *it;
+		return total;
+	}
+
+	SparseMatrix& SparseMatrix::operator*= (const Real k) throw() {
+		for (::std::vector<Real>::iterator it = value_array.begin(); it != value_array.end(); ++ it)
+			*it *= k;
+		return *this;
+	}
+	SparseMatrix& SparseMatrix::operator/= (const Real k) throw() {
+		for (::std::vector<Real>::iterator it = value_array.begin(); it != value_array.end(); ++ it)
+			*it /= k;
+		return *this;
+	}
+
+#pragma mark -
+#pragma mark Products
+
+	::tempobj::force_temporary_class<Vector>::type SparseMatrix::multiply(const Vector& x) const MAY_THROW_EXCEPTION {
+		if (x.size() != col_count) {
+			TRY(IGRAPH_EINVAL);
+			return Vector::n();
+		}
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, row_count));
+		const Real* xs = x.begin();
+		for (long i = 0; i < row_count; ++ i) {
+			Real total = 0;
+			for (long k = offset_array[i]; k < offset_array[i+1]; ++ k)
+				total += value_array[k] * xs[column_array[k]];
+			VECTOR(res)[i] = total;
+		}
+		return ::tempobj::force_move(Vector(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	::tempobj::force_temporary_class<Vector>::type SparseMatrix::multiply_transposed(const Vector& x) const MAY_THROW_EXCEPTION {
+		if (x.size() != row_count) {
+			TRY(IGRAPH_EINVAL);
+			return Vector::n();
+		}
+		igraph_vector_t res;
+		TRY(igraph_vector_init(&res, col_count));
+		for (long i = 0; i < row_count; ++ i) {
+			Real xi = x[i];
+			for (long k = offset_array[i]; k < offset_array[i+1]; ++ k)
+				VECTOR(res)[column_array[k]] += value_array[k] * xi;
+		}
+		return ::tempobj::force_move(Vector(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	::tempobj::force_temporary_class<Matrix>::type SparseMatrix::multiply(const Matrix& m) const MAY_THROW_EXCEPTION {
+		long p = m.ncol();
+		if (m.nrow() != col_count) {
+			TRY(IGRAPH_EINVAL);
+			return Matrix::n();
+		}
+		igraph_matrix_t res;
+		TRY(igraph_matrix_init(&res, row_count, p));
+		// one column of the result at a time, so that both m and the result are read in memory order.
+		for (long q = 0; q < p; ++ q)
+			for (long i = 0; i < row_count; ++ i) {
+				Real total = 0;
+				for (long k = offset_array[i]; k < offset_array[i+1]; ++ k)
+					total += value_array[k] * m(column_array[k], q);
+				MATRIX(res, i, q) = total;
+			}
+		return ::tempobj::force_move(Matrix(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	::tempobj::force_temporary_class<Matrix>::type SparseMatrix::left_multiply(const Matrix& m) const MAY_THROW_EXCEPTION {
+		long p = m.nrow();
+		if (m.ncol() != row_count) {
+			TRY(IGRAPH_EINVAL);
+			return Matrix::n();
+		}
+		igraph_matrix_t res;
+		TRY(igraph_matrix_init(&res, p, col_count));
+		// (M A)(:, j) += M(:, i) A(i, j): whole columns, which are contiguous.
+		for (long i = 0; i < row_count; ++ i)
+			for (long k = offset_array[i]; k < offset_array[i+1]; ++ k) {
+				Real a = value_array[k];
+				Real* dest = &MATRIX(res, 0, column_array[k]);
+				for (long r = 0; r < p; ++ r)
+					dest[r] += m(r, i) * a;
+			}
+		return ::tempobj::force_move(Matrix(&res, ::tempobj::OwnershipTransferMove));
+	}
+
+	void XXINTRNL_SparseAccumulator::flush(SparseMatrix& res) {
+		::std::sort(touched.begin(), touched.end());
+		for (::std::vector<long>::const_iterator it = touched.begin(); it != touched.end(); ++ it) {
+			if (total[*it] != 0)
+				res.push(*it, total[*it]);
+			total[*it] = 0;
+			used[*it] = 0;
+		}
+		touched.clear();
+		res.end_row();
+	}
+	
+	bool SparseMatrix::operator== (const SparseMatrix& other) const throw() {
+		return row_count == other.row_count && col_count == other.col_count && offset_array == other.offset_array && column_array == other.column_array && value_array == other.value_array;
+	}
+}
+
+#endif
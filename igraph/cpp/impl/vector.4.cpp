@@ -48,13 +48,12 @@ template<> BasicVector<BASE>::BasicVector(::std::initializer_list<BASE> elements
 
 template<> BasicVector<BASE>::BasicVector(const char* stringized_elements) MAY_THROW_EXCEPTION {
 	XXINTRNL_DEBUG_CALL_INITIALIZER(BasicVector, <BASE>);
+	XXINTRNL_NumberScanner<BASE> scanner (stringized_elements);
 	TRY(FUNC(init)(&_, 0));
-	const char* end_of_string = ::std::strchr(stringized_elements, '\0');
-	while (stringized_elements < end_of_string) {
-		BASE res;
-		if (XXINTRNL_sscanf(stringized_elements, res))
-			TRY(FUNC(push_back)(&_, res));
-	}
+	TRY(FUNC(reserve)(&_, scanner.count_estimate()));
+	BASE res;
+	while (scanner.next(res) == XXINTRNL_NumberScanner<BASE>::Token_Number)
+		TRY(FUNC(push_back)(&_, res));
 }
 
 template<> ::tempobj::force_temporary_class<BasicVector<BASE> >::type BasicVector<BASE>::seq(const BASE from, const BASE to) MAY_THROW_EXCEPTION {
@@ -96,6 +95,41 @@ template<> RETRIEVE_TEMPORARY_CLASS(BasicVector<BASE>) BasicVector<BASE>::view(c
 	return ::tempobj::force_move(BasicVector<BASE>(&_, ::tempobj::OwnershipTransferNoOwnership));
 }
 
+#pragma mark -
+#pragma mark Saving and loading
+
+template<> void BasicVector<BASE>::save(::std::FILE* filestream) const MAY_THROW_EXCEPTION {
+	long count = FUNC(size)(&_);
+	TRY(XXINTRNL_save_array(filestream, XXINTRNL_vector_magic, VECTOR(_), count, 0, count));
+}
+template<> void BasicVector<BASE>::save(const char* filename) const MAY_THROW_EXCEPTION {
+	long count = FUNC(size)(&_);
+	XXINTRNL_save_array_to_file(filename, XXINTRNL_vector_magic, VECTOR(_), count, 0, count);
+}
+
+template<> RETRIEVE_TEMPORARY_CLASS(BasicVector<BASE>) BasicVector<BASE>::load(const MappedFile& file) MAY_THROW_EXCEPTION {
+	XXINTRNL_SavedArray<BASE> saved (file, false);
+	TYPE _;
+	TRY(FUNC(init)(&_, saved.count));
+	saved.copy_to(VECTOR(_));
+	return ::tempobj::force_move(BasicVector<BASE>(&_, ::tempobj::OwnershipTransferMove));
+}
+template<> RETRIEVE_TEMPORARY_CLASS(BasicVector<BASE>) BasicVector<BASE>::load(::std::FILE* filestream) MAY_THROW_EXCEPTION {
+	MappedFile content (filestream);
+	return ::tempobj::force_move(load(content));
+}
+template<> RETRIEVE_TEMPORARY_CLASS(BasicVector<BASE>) BasicVector<BASE>::load(const char* filename) MAY_THROW_EXCEPTION {
+	MappedFile content (filename);
+	return ::tempobj::force_move(load(content));
+}
+
+template<> RETRIEVE_TEMPORARY_CLASS(BasicVector<BASE>) BasicVector<BASE>::view(const MappedFile& file) MAY_THROW_EXCEPTION {
+	XXINTRNL_SavedArray<BASE> saved (file, false);
+	if (saved.can_view())
+		return ::tempobj::force_move(view(reinterpret_cast<const BASE*>(saved.payload), saved.count));
+	return ::tempobj::force_move(load(file));
+}
+
 #pragma mark -
 #pragma mark Copying vectors
 
@@ -113,15 +147,49 @@ template<> BasicVector<BASE>& BasicVector<BASE>::reverse() MAY_THROW_EXCEPTION {
 #pragma mark -
 #pragma mark BasicVector<BASE> operations
 
-template<> BasicVector<BASE>& BasicVector<BASE>::operator+= (const BASE k) throw() { FUNC(add_constant)(&_, k); return *this; }
-template<> BasicVector<BASE>& BasicVector<BASE>::operator-= (const BASE k) throw() { FUNC(add_constant)(&_, -k); return *this; }
-template<> BasicVector<BASE>& BasicVector<BASE>::operator*= (const BASE k) throw() { FUNC(scale)(&_, k); return *this; }
-template<> BasicVector<BASE>& BasicVector<BASE>::operator/= (const BASE k) throw() { FUNC(scale)(&_, 1/k); return *this; }
+// The XXINTRNL_simd_ kernels (simd.cpp) return false when igraph has to do the work.
+template<> BasicVector<BASE>& BasicVector<BASE>::operator+= (const BASE k) throw() {
+	if (!XXINTRNL_simd_add_constant(VECTOR(_), FUNC(size)(&_), k))
+		FUNC(add_constant)(&_, k);
+	return *this;
+}
+template<> BasicVector<BASE>& BasicVector<BASE>::operator-= (const BASE k) throw() {
+	if (!XXINTRNL_simd_add_constant(VECTOR(_), FUNC(size)(&_), static_cast<BASE>(-k)))
+		FUNC(add_constant)(&_, -k);
+	return *this;
+}
+template<> BasicVector<BASE>& BasicVector<BASE>::operator*= (const BASE k) throw() {
+	if (!XXINTRNL_simd_scale(VECTOR(_), FUNC(size)(&_), k))
+		FUNC(scale)(&_, k);
+	return *this;
+}
+template<> BasicVector<BASE>& BasicVector<BASE>::operator/= (const BASE k) throw() {
+	if (!XXINTRNL_simd_scale(VECTOR(_), FUNC(size)(&_), static_cast<BASE>(1/k)))
+		FUNC(scale)(&_, 1/k);
+	return *this;
+}
 
-template<> BasicVector<BASE>& BasicVector<BASE>::operator+= (const BasicVector<BASE>& k) MAY_THROW_EXCEPTION { TRY(FUNC(add)(&_, &k._)); return *this; }
-template<> BasicVector<BASE>& BasicVector<BASE>::operator-= (const BasicVector<BASE>& k) MAY_THROW_EXCEPTION { TRY(FUNC(sub)(&_, &k._)); return *this; }
-template<> BasicVector<BASE>& BasicVector<BASE>::operator*= (const BasicVector<BASE>& k) MAY_THROW_EXCEPTION { TRY(FUNC(mul)(&_, &k._)); return *this; }
-template<> BasicVector<BASE>& BasicVector<BASE>::operator/= (const BasicVector<BASE>& k) MAY_THROW_EXCEPTION { TRY(FUNC(div)(&_, &k._)); return *this; }
+// igraph reports vectors of different sizes.
+template<> BasicVector<BASE>& BasicVector<BASE>::operator+= (const BasicVector<BASE>& k) MAY_THROW_EXCEPTION {
+	if (FUNC(size)(&_) != FUNC(size)(&k._) || !XXINTRNL_simd_add(VECTOR(_), VECTOR(k._), FUNC(size)(&_)))
+		TRY(FUNC(add)(&_, &k._));
+	return *this;
+}
+template<> BasicVector<BASE>& BasicVector<BASE>::operator-= (const BasicVector<BASE>& k) MAY_THROW_EXCEPTION {
+	if (FUNC(size)(&_) != FUNC(size)(&k._) || !XXINTRNL_simd_sub(VECTOR(_), VECTOR(k._), FUNC(size)(&_)))
+		TRY(FUNC(sub)(&_, &k._));
+	return *this;
+}
+template<> BasicVector<BASE>& BasicVector<BASE>::operator*= (const BasicVector<BASE>& k) MAY_THROW_EXCEPTION {
+	if (FUNC(size)(&_) != FUNC(size)(&k._) || !XXINTRNL_simd_mul(VECTOR(_), VECTOR(k._), FUNC(size)(&_)))
+		TRY(FUNC(mul)(&_, &k._));
+	return *this;
+}
+template<> BasicVector<BASE>& BasicVector<BASE>::operator/= (const BasicVector<BASE>& k) MAY_THROW_EXCEPTION {
+	if (FUNC(size)(&_) != FUNC(size)(&k._) || !XXINTRNL_simd_div(VECTOR(_), VECTOR(k._), FUNC(size)(&_)))
+		TRY(FUNC(div)(&_, &k._));
+	return *this;
+}
 
 IMMEDIATE_OPERATOR_IMPLEMENTATION_COMMUTATIVE(BasicVector<BASE>, +, BASE);
 IMMEDIATE_OPERATOR_IMPLEMENTATION_RHS(BasicVector<BASE>, -, BASE);
@@ -139,8 +207,24 @@ template<> Real BasicVector<BASE>::min() const throw() { return FUNC(min)(&_); }
 template<> Real BasicVector<BASE>::max() const throw() { return FUNC(max)(&_); }
 template<> long BasicVector<BASE>::which_min() const throw() { return FUNC(which_min)(&_); }
 template<> long BasicVector<BASE>::which_max() const throw() { return FUNC(which_max)(&_); }
-template<> void BasicVector<BASE>::minmax(BASE& minStore, BASE& maxStore) const MAY_THROW_EXCEPTION { TRY(FUNC(minmax)(&_, &minStore, &maxStore)); }
-template<> void BasicVector<BASE>::which_minmax(long& minStore, long& maxStore) const MAY_THROW_EXCEPTION { TRY(FUNC(which_minmax)(&_, &minStore, &maxStore)); }
+template<> void BasicVector<BASE>::minmax(BASE& minStore, BASE& maxStore) const MAY_THROW_EXCEPTION {
+	if (!XXINTRNL_simd_minmax(VECTOR(_), FUNC(size)(&_), minStore, maxStore))
+		TRY(FUNC(minmax)(&_, &minStore, &maxStore));
+}
+// igraph returns the first minimum and the first maximum, which are found again after the values.
+// They are NaN if the first element is, and then no element equals them, so igraph handles that.
+template<> void BasicVector<BASE>::which_minmax(long& minStore, long& maxStore) const MAY_THROW_EXCEPTION {
+	BASE min, max;
+	long n = FUNC(size)(&_);
+	if (XXINTRNL_simd_minmax(VECTOR(_), n, min, max)) {
+		const BASE* p = VECTOR(_);
+		for (minStore = 0; minStore < n && p[minStore] != min; ++ minStore) {}
+		for (maxStore = 0; maxStore < n && p[maxStore] != max; ++ maxStore) {}
+		if (minStore < n && maxStore < n)
+			return;
+	}
+	TRY(FUNC(which_minmax)(&_, &minStore, &maxStore));
+}
 
 #pragma mark -
 #pragma mark Vector properties
@@ -149,13 +233,29 @@ template<> bool BasicVector<BASE>::empty() const throw() { return FUNC(empty)(&_
 template<> long BasicVector<BASE>::size() const throw() { return FUNC(size)(&_); }
 template<> bool BasicVector<BASE>::isnull() const throw() { return FUNC(isnull)(&_); }
 
-template<> Real BasicVector<BASE>::sum() const throw() { return FUNC(sum)(&_); }
-template<> Real BasicVector<BASE>::prod() const throw() { return FUNC(prod)(&_); }
-template<> bool BasicVector<BASE>::isininterval(BASE low, BASE high) const throw() { return FUNC(isininterval)(&_, low, high); }
+template<> Real BasicVector<BASE>::sum() const throw() {
+	Real res;
+	return XXINTRNL_simd_sum(VECTOR(_), FUNC(size)(&_), res) ? res : FUNC(sum)(&_);
+}
+template<> Real BasicVector<BASE>::prod() const throw() {
+	Real res;
+	return XXINTRNL_simd_prod(VECTOR(_), FUNC(size)(&_), res) ? res : FUNC(prod)(&_);
+}
+template<> bool BasicVector<BASE>::isininterval(BASE low, BASE high) const throw() {
+	BASE min, max;
+	// a NaN first element seeds min and max, while igraph skips it.
+	if (XXINTRNL_simd_minmax(VECTOR(_), FUNC(size)(&_), min, max) && !XXINTRNL_is_nan(min))
+		return low <= min && max <= high;
+	return FUNC(isininterval)(&_, low, high);
+}
 template<> bool BasicVector<BASE>::any_smaller(BASE upper_limit) const throw() { return FUNC(any_smaller)(&_, upper_limit); }
 template<> bool BasicVector<BASE>::operator== (const BasicVector<BASE>& other) const throw() { return FUNC(is_equal)(&_, &other._); }
 template<> bool BasicVector<BASE>::operator!= (const BasicVector<BASE>& other) const throw() { return !(*this == other); }
-template<> BASE BasicVector<BASE>::maxdifference(const BasicVector<BASE>& other) const throw() { return FUNC(maxdifference)(&_, &other._); }
+template<> BASE BasicVector<BASE>::maxdifference(const BasicVector<BASE>& other) const throw() {
+	BASE res;
+	long n = FUNC(size)(&_) < FUNC(size)(&other._) ? FUNC(size)(&_) : FUNC(size)(&other._);
+	return XXINTRNL_simd_maxdifference(VECTOR(_), VECTOR(other._), n, res) ? res : FUNC(maxdifference)(&_, &other._);
+}
 
 #pragma mark -
 #pragma mark Searching for elements
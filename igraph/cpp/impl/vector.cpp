@@ -23,13 +23,165 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define IGRAPH_VECTOR_CPP
 
 #include <igraph/cpp/vector.hpp>
+#include <igraph/cpp/impl/simd.cpp>
 #include <cstring>
 #include <cassert>
+#include <climits>
 
 namespace igraph {
 	
 	MEMORY_MANAGER_IMPLEMENTATION_WITH_TEMPLATE(template<typename T>, BasicVector, <T>);
 	
+#pragma mark -
+#pragma mark Binary layout of vectors and matrices
+	
+	static const char XXINTRNL_vector_magic[4] = {'I', 'G', 'V', 'C'};
+	static const char XXINTRNL_matrix_magic[4] = {'I', 'G', 'M', 'X'};
+	static const unsigned XXINTRNL_array_version = 1;
+	static const unsigned XXINTRNL_array_header_size = 32;
+	
+	template<typename T> unsigned char XXINTRNL_array_type_code() throw();
+	template<> unsigned char XXINTRNL_array_type_code<Real>() throw() { return 'r'; }
+	template<> unsigned char XXINTRNL_array_type_code<long>() throw() { return 'l'; }
+	template<> unsigned char XXINTRNL_array_type_code<char>() throw() { return 'c'; }
+	template<> unsigned char XXINTRNL_array_type_code<Boolean>() throw() { return 'b'; }
+	
+	template<typename T> static inline void XXINTRNL_store_element(unsigned char* dest, const T value) throw() {
+		XXINTRNL_store_le(dest, static_cast<uint64_t>(static_cast<int64_t>(value)), sizeof(T));
+	}
+	template<> inline void XXINTRNL_store_element<Real>(unsigned char* dest, const Real value) throw() {
+		uint64_t bits;
+		::std::memcpy(&bits, &value, sizeof(bits));
+		XXINTRNL_store_le(dest, bits, sizeof(bits));
+	}
+	
+	/// Load an integer of any width from 1 to 8 bytes, with sign extension.
+	template<typename T> static inline T XXINTRNL_load_element(const unsigned char* src, const unsigned width) throw() {
+		uint64_t bits = XXINTRNL_load_le(src, width);
+		if (width < 8 && (bits >> (8*width - 1)) & 1)
+			bits |= ~static_cast<uint64_t>(0) << (8*width);
+		return static_cast<T>(static_cast<int64_t>(bits));
+	}
+	template<> inline Real XXINTRNL_load_element<Real>(const unsigned char* src, const unsigned width) throw() {
+		uint64_t bits = XXINTRNL_load_le(src, width);
+		Real value;
+		::std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+	
+	/// Write the header of a saved vector (rows = size, cols = 0) or matrix, followed by the elements. A short write gives IGRAPH_EFILE.
+	template<typename T>
+	static int XXINTRNL_save_array(::std::FILE* f, const char* magic, const T* elements, const long rows, const long cols, const long count) throw() {
+		unsigned char header[XXINTRNL_array_header_size];
+		::std::memset(header, 0, sizeof(header));
+		::std::memcpy(header, magic, 4);
+		header[4] = XXINTRNL_array_version;
+		header[5] = XXINTRNL_array_type_code<T>();
+		header[6] = sizeof(T);
+		XXINTRNL_store_le(header + 8, static_cast<uint64_t>(rows), 8);
+		XXINTRNL_store_le(header + 16, static_cast<uint64_t>(cols), 8);
+		if (::std::fwrite(header, sizeof(header), 1, f) != 1)
+			return IGRAPH_EFILE;
+		
+		if (XXINTRNL_is_little_endian())
+			return ::std::fwrite(elements, sizeof(T), count, f) == static_cast< ::std::size_t>(count) ? IGRAPH_SUCCESS : IGRAPH_EFILE;
+		unsigned char buffer[1 << 15];
+		const long per_buffer = sizeof(buffer) / sizeof(T);
+		for (long i = 0; i < count; i += per_buffer) {
+			long n = count - i < per_buffer ? count - i : per_buffer;
+			for (long j = 0; j < n; ++ j)
+				XXINTRNL_store_element(buffer + j * sizeof(T), elements[i + j]);
+			if (::std::fwrite(buffer, sizeof(T), n, f) != static_cast< ::std::size_t>(n))
+				return IGRAPH_EFILE;
+		}
+		return IGRAPH_SUCCESS;
+	}
+	
+	/// Save into a new file, and check that everything was written when it is closed.
+	template<typename T>
+	static void XXINTRNL_save_array_to_file(const char* filename, const char* magic, const T* elements, const long rows, const long cols, const long count) MAY_THROW_EXCEPTION {
+		::std::FILE* f = ::std::fopen(filename, "wb");
+		if (f == NULL) {
+			TRY(IGRAPH_EFILE);
+			return;
+		}
+		int errcode = XXINTRNL_save_array(f, magic, elements, rows, cols, count);
+		if (::std::fclose(f) != 0 && errcode == IGRAPH_SUCCESS)
+			errcode = IGRAPH_EFILE;
+		TRY(errcode);
+	}
+	
+	/**
+	 \brief A validated saved vector or matrix.
+	 
+	 The elements can be used in place if they have the width and byte order
+	 of T and are suitably aligned, otherwise they must be converted with
+	 copy_to(). Content which is not a saved array of T gives
+	 IGRAPH_PARSEERROR (IGRAPH_UNIMPLEMENTED for a newer version), as
+	 GraphReader::binary() does; without exceptions the array is then empty.
+	 */
+	template<typename T>
+	struct XXINTRNL_SavedArray {
+		const unsigned char* payload;
+		unsigned width;
+		long rows;
+		long cols;
+		long count;
+		
+		XXINTRNL_SavedArray(const MappedFile& file, const bool is_matrix) MAY_THROW_EXCEPTION {
+			const unsigned char* header = reinterpret_cast<const unsigned char*>(file.begin());
+			const char* magic = is_matrix ? XXINTRNL_matrix_magic : XXINTRNL_vector_magic;
+			if (file.size() < XXINTRNL_array_header_size || ::std::memcmp(header, magic, 4) != 0) {
+				reject(IGRAPH_PARSEERROR);
+				return;
+			}
+			if (header[4] != XXINTRNL_array_version) {
+				reject(IGRAPH_UNIMPLEMENTED);
+				return;
+			}
+			width = header[6];
+			if (header[5] != XXINTRNL_array_type_code<T>() || width < 1 || width > 8 || (header[5] == 'r' && width != sizeof(Real))) {
+				reject(IGRAPH_PARSEERROR);	// the element type does not match.
+				return;
+			}
+			
+			uint64_t r = XXINTRNL_load_le(header + 8, 8);
+			uint64_t c = XXINTRNL_load_le(header + 16, 8);
+			uint64_t capacity = (file.size() - XXINTRNL_array_header_size) / width;
+			uint64_t n = is_matrix ? r * c : r;
+			if (r > static_cast<uint64_t>(LONG_MAX) || c > static_cast<uint64_t>(LONG_MAX) || (is_matrix && c != 0 && r > capacity / c) || n > capacity) {
+				reject(IGRAPH_PARSEERROR);	// truncated.
+				return;
+			}
+			
+			payload = header + XXINTRNL_array_header_size;
+			rows = r;
+			cols = c;
+			count = n;
+		}
+		
+		void reject(const int errcode) MAY_THROW_EXCEPTION {
+			payload = NULL;
+			width = sizeof(T);
+			rows = cols = count = 0;
+			TRY(errcode);
+		}
+		
+		bool can_view() const throw() {
+			return width == sizeof(T) && XXINTRNL_is_little_endian() && reinterpret_cast<uintptr_t>(payload) % sizeof(T) == 0;
+		}
+		
+		void copy_to(T* dest) const throw() {
+			if (count == 0)
+				return;
+			if (can_view())
+				::std::memcpy(dest, payload, count * sizeof(T));
+			else
+				for (long i = 0; i < count; ++ i)
+					dest[i] = XXINTRNL_load_element<T>(payload + i * width, width);
+		}
+	};
+	
 #define BASE Real
 #define FUNC(x) igraph_vector_##x
 #define TYPE FUNC(t)
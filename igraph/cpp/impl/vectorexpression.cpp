@@ -0,0 +1,111 @@
+/*
+
+vectorexpression.cpp ... Lazy element-wise arithmetic of vectors and matrices, evaluated in one pass.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_VECTOREXPRESSION_CPP
+#define IGRAPH_VECTOREXPRESSION_CPP
+
+#include <igraph/cpp/vectorexpression.hpp>
+
+namespace igraph {
+	template <typename C, typename E>
+	typename ::tempobj::force_temporary_class<C>::type LazyExpression<C, E>::evaluate() const MAY_THROW_EXCEPTION {
+		C res = C::n();
+		res = *this;
+		return ::tempobj::force_move(res);
+	}
+	
+	/// \internal dest[i] = Op(dest[i], node[i]). The loop reads each operand once, so the destination may be one of them.
+	template <typename T, typename Op, typename E>
+	static inline void XXINTRNL_lazy_update(T* dest, const long n, const E& node) throw() {
+		for (long i = 0; i < n; ++ i)
+			dest[i] = Op::apply(dest[i], node[i]);
+	}
+	
+#pragma mark -
+#pragma mark BasicVector
+	
+	template <typename T> template <typename E>
+	BasicVector<T>& BasicVector<T>::operator= (const LazyExpression<BasicVector<T>, E>& expr) MAY_THROW_EXCEPTION {
+		if (!expr.is_valid()) {
+			TRY(IGRAPH_EINVAL);
+			return *this;
+		}
+		long n = expr.nrow();
+		resize(n);	// no reallocation if this vector is an operand.
+		T* dest = begin();
+		for (long i = 0; i < n; ++ i)
+			dest[i] = expr[i];
+		return *this;
+	}
+	
+#define XXINTRNL_LAZY_UPDATE(op, Op) \
+	template <typename T> template <typename E> \
+	BasicVector<T>& BasicVector<T>::operator op##= (const LazyExpression<BasicVector<T>, E>& expr) MAY_THROW_EXCEPTION { \
+		if (!expr.is_valid() || expr.nrow() != size()) { \
+			TRY(IGRAPH_EINVAL); \
+			return *this; \
+		} \
+		XXINTRNL_lazy_update<T, Op>(begin(), size(), expr.node); \
+		return *this; \
+	}
+	
+	XXINTRNL_LAZY_UPDATE(+, XXINTRNL_ExprPlus)
+	XXINTRNL_LAZY_UPDATE(-, XXINTRNL_ExprMinus)
+	XXINTRNL_LAZY_UPDATE(*, XXINTRNL_ExprTimes)
+	XXINTRNL_LAZY_UPDATE(/, XXINTRNL_ExprDivide)
+	
+#undef XXINTRNL_LAZY_UPDATE
+	
+#pragma mark -
+#pragma mark BasicMatrix
+	
+	template <typename T> template <typename E>
+	BasicMatrix<T>& BasicMatrix<T>::operator= (const LazyExpression<BasicMatrix<T>, E>& expr) MAY_THROW_EXCEPTION {
+		if (!expr.is_valid()) {
+			TRY(IGRAPH_EINVAL);
+			return *this;
+		}
+		resize(expr.nrow(), expr.ncol());
+		long n = size();
+		T* dest = VECTOR(_.data);
+		for (long i = 0; i < n; ++ i)
+			dest[i] = expr[i];
+		return *this;
+	}
+	
+#define XXINTRNL_LAZY_UPDATE(op, Op) \
+	template <typename T> template <typename E> \
+	BasicMatrix<T>& BasicMatrix<T>::operator op##= (const LazyExpression<BasicMatrix<T>, E>& expr) MAY_THROW_EXCEPTION { \
+		if (!expr.is_valid() || expr.nrow() != nrow() || expr.ncol() != ncol()) { \
+			TRY(IGRAPH_EINVAL); \
+			return *this; \
+		} \
+		XXINTRNL_lazy_update<T, Op>(VECTOR(_.data), size(), expr.node); \
+		return *this; \
+	}
+	
+	XXINTRNL_LAZY_UPDATE(+, XXINTRNL_ExprPlus)
+	XXINTRNL_LAZY_UPDATE(-, XXINTRNL_ExprMinus)
+	
+#undef XXINTRNL_LAZY_UPDATE
+}
+
+#endif
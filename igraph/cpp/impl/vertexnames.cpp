@@ -0,0 +1,136 @@
+/*
+
+vertexnames.cpp ... Interned table of vertex names.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_VERTEXNAMES_CPP
+#define IGRAPH_VERTEXNAMES_CPP
+
+#include <igraph/cpp/vertexnames.hpp>
+#include <cstdlib>
+#include <new>
+#include <stdint.h>
+
+namespace igraph {
+	static const ::std::size_t XXINTRNL_name_block_size = 1 << 16;
+
+	VertexNames::VertexNames() : block_cursor(NULL), block_limit(NULL), slots(16) {
+		for (::std::size_t i = 0; i < slots.size(); ++ i)
+			slots[i].id = -1;
+	}
+
+	VertexNames::~VertexNames() throw() {
+		for (::std::size_t i = 0; i < blocks.size(); ++ i)
+			::std::free(blocks[i]);
+	}
+
+	void VertexNames::clear() throw() {
+		for (::std::size_t i = 0; i < blocks.size(); ++ i)
+			::std::free(blocks[i]);
+		blocks.clear();
+		block_cursor = block_limit = NULL;
+		names.clear();
+		lengths.clear();
+		for (::std::size_t i = 0; i < slots.size(); ++ i)
+			slots[i].id = -1;
+	}
+
+	/// FNV-1a.
+	::std::size_t VertexNames::hash(const char* str, const ::std::size_t length) throw() {
+		uint64_t h = 14695981039346656037ULL;
+		for (::std::size_t i = 0; i < length; ++ i) {
+			h ^= static_cast<unsigned char>(str[i]);
+			h *= 1099511628211ULL;
+		}
+		return static_cast< ::std::size_t>(h ^ (h >> 32));
+	}
+
+	/// Copy the name into the current arena block, starting a new block when it is full.
+	const char* VertexNames::store(const char* str, const ::std::size_t length) {
+		if (static_cast< ::std::size_t>(block_limit - block_cursor) < length + 1) {
+			::std::size_t block_size = length + 1 > XXINTRNL_name_block_size ? length + 1 : XXINTRNL_name_block_size;
+			char* block = reinterpret_cast<char*>(::std::malloc(block_size));
+			if (block == NULL)
+				throw ::std::bad_alloc();
+			blocks.push_back(block);
+			block_cursor = block;
+			block_limit = block + block_size;
+		}
+		char* res = block_cursor;
+		::std::memcpy(res, str, length);
+		res[length] = '\0';
+		block_cursor += length + 1;
+		return res;
+	}
+
+	void VertexNames::rehash(const ::std::size_t new_slot_count) {
+		::std::vector<Slot> new_slots (new_slot_count);
+		for (::std::size_t i = 0; i < new_slot_count; ++ i)
+			new_slots[i].id = -1;
+		::std::size_t mask = new_slot_count - 1;
+		for (::std::size_t i = 0; i < slots.size(); ++ i)
+			if (slots[i].id >= 0) {
+				::std::size_t j = slots[i].hash & mask;
+				while (new_slots[j].id >= 0)
+					j = (j + 1) & mask;
+				new_slots[j] = slots[i];
+			}
+		slots.swap(new_slots);
+	}
+
+	long VertexNames::find(const char* str, const ::std::size_t length, const ::std::size_t h) const throw() {
+		::std::size_t mask = slots.size() - 1;
+		for (::std::size_t j = h & mask; slots[j].id >= 0; j = (j + 1) & mask) {
+			const Slot& slot = slots[j];
+			if (slot.hash == h && lengths[slot.id] == length && ::std::memcmp(names[slot.id], str, length) == 0)
+				return slot.id;
+		}
+		return -1;
+	}
+
+	Vertex VertexNames::intern(const char* str, const ::std::size_t length) {
+		::std::size_t h = hash(str, length);
+		long id = find(str, length, h);
+		if (id >= 0)
+			return id;
+
+		// keep the load factor at most 1/2.
+		if (2 * (names.size() + 1) > slots.size())
+			rehash(2 * slots.size());
+
+		id = names.size();
+		lengths.push_back(length);
+		try {
+			names.push_back(store(str, length));
+		} catch (...) {
+			lengths.pop_back();
+			throw;
+		}
+
+		::std::size_t mask = slots.size() - 1;
+		::std::size_t j = h & mask;
+		while (slots[j].id >= 0)
+			j = (j + 1) & mask;
+		slots[j].hash = h;
+		slots[j].id = id;
+		return id;
+	}
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+
+mappedfile.hpp ... Read-only memory mapped files.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_MAPPEDFILE_HPP
+#define IGRAPH_MAPPEDFILE_HPP
+
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/exception.hpp>
+#include <cstdio>
+#include <cstddef>
+
+#if !defined(_WIN32)
+#define XXINTRNL_HAVE_MMAP 1
+#else
+#define XXINTRNL_HAVE_MMAP 0
+#endif
+
+namespace igraph {
+	/**
+	 \class MappedFile
+	 \brief The read-only content of a file, mapped into memory.
+
+	 The file is mapped with mmap() when possible. Streams which cannot be
+	 mapped (pipes, sockets, or platforms without mmap()) are read into a heap
+	 buffer instead, so the content is always available as a contiguous range
+	 of bytes.
+
+	 If the file cannot be opened or read and exceptions are disabled, the
+	 content is empty.
+	 */
+	class MappedFile {
+	private:
+		char* data;
+		::std::size_t length;
+		::std::size_t offset;
+		bool mapped;
+
+		int map_stream(::std::FILE* filestream) throw();
+		int read_stream(::std::FILE* filestream) throw();
+
+	public:
+		MEMORY_MANAGER_INTERFACE_NO_COPYING(MappedFile);
+
+		/**
+		 \brief Map the remaining content of a stream.
+
+		 The content starts at the current position of the stream. After the
+		 call, the stream is positioned at its end.
+		 */
+		explicit MappedFile(::std::FILE* filestream) MAY_THROW_EXCEPTION;
+
+		/// Map the whole content of the file with the specified name.
+		explicit MappedFile(const char* filename) MAY_THROW_EXCEPTION;
+
+		const char* begin() const throw() { return data + offset; }
+		const char* end() const throw() { return data + length; }
+		::std::size_t size() const throw() { return length - offset; }
+
+		/// Whether the content is really mapped (true) or copied into memory (false).
+		bool is_mapped() const throw() { return mapped; }
+	};
+
+	MEMORY_MANAGER_INTERFACE_EX_NO_COPYING(MappedFile);
+}
+
+#endif
@@ -57,6 +57,8 @@ namespace igraph {
 		MEMORY_MANAGER_INTERFACE_WITH_TEMPLATE(BasicMatrix, <T>);
 		XXINTRNL_WRAPPER_CONSTRUCTOR_INTERFACE(BasicMatrix, XXINTRNL_UNDERLYING_TYPE(BasicMatrix));
 		
+		typedef T value_type;
+		
 		/// Create a matrix with specified dimensions 
 		BasicMatrix(const long nrow, const long ncol) MAY_THROW_EXCEPTION;
 		
@@ -75,6 +77,44 @@ namespace igraph {
 		 */
 		BasicMatrix(const char* stringized_elements, const char* row_separator = ";") MAY_THROW_EXCEPTION;
 		
+		/**
+		 \brief Wrap a matrix saved with save() as a read-only BasicMatrix.
+		 
+		 If the file was saved on a little-endian machine with the same element
+		 width, the result is a view into the mapped content, so reloading even a
+		 very large matrix takes O(1) time and no extra memory. Otherwise the
+		 elements are converted into a new matrix.
+		 
+		 In either case the result must not outlive \p file, and must not be
+		 modified or resized.
+		 
+		 \throw Exception IGRAPH_PARSEERROR if the file is not a saved matrix of type T.
+		 */
+		static typename ::tempobj::force_temporary_class<BasicMatrix<T> >::type view(const MappedFile& file) MAY_THROW_EXCEPTION;
+		
+		/**
+		 \brief Read a matrix saved with save().
+		 \throw Exception IGRAPH_EFILE if the file cannot be opened, IGRAPH_PARSEERROR if it is not a saved matrix of type T.
+		 */
+		static typename ::tempobj::force_temporary_class<BasicMatrix<T> >::type load(const char* filename) MAY_THROW_EXCEPTION;
+		/// Read a matrix saved with save(), starting at the current position of the stream.
+		static typename ::tempobj::force_temporary_class<BasicMatrix<T> >::type load(::std::FILE* filestream) MAY_THROW_EXCEPTION;
+		/// Read a matrix saved with save() from mapped content, always copying the elements.
+		static typename ::tempobj::force_temporary_class<BasicMatrix<T> >::type load(const MappedFile& file) MAY_THROW_EXCEPTION;
+		
+		/**
+		 \brief Write the matrix in a raw binary format.
+		 
+		 The layout is the same as BasicVector::save(), with the magic "IGMX" and
+		 the number of rows and columns in the header. The elements are stored in
+		 column-major order, as in memory.
+		 
+		 \throw Exception IGRAPH_EFILE if the file cannot be written.
+		 */
+		void save(const char* filename) const MAY_THROW_EXCEPTION;
+		/// Write the matrix in a raw binary format to a stream. A short write raises IGRAPH_EFILE.
+		void save(::std::FILE* filestream) const MAY_THROW_EXCEPTION;
+		
 		BasicMatrix<T>& null() throw();
 		BasicMatrix<T>& fill(const T e) throw();
 		
@@ -111,6 +151,13 @@ namespace igraph {
 		BasicMatrix<T>& mul_elements(const BasicMatrix<T>& k) MAY_THROW_EXCEPTION;
 		BasicMatrix<T>& div_elements(const BasicMatrix<T>& k) MAY_THROW_EXCEPTION;
 		
+		/// Evaluate a LazyExpression into this matrix in one pass, resizing it to the shape of the expression.
+		template <typename E> BasicMatrix<T>& operator= (const LazyExpression<BasicMatrix<T>, E>& expr) MAY_THROW_EXCEPTION;
+		/// Add a LazyExpression of the same shape element-wise, in one pass.
+		template <typename E> BasicMatrix<T>& operator+= (const LazyExpression<BasicMatrix<T>, E>& expr) MAY_THROW_EXCEPTION;
+		/// Subtract a LazyExpression of the same shape element-wise, in one pass.
+		template <typename E> BasicMatrix<T>& operator-= (const LazyExpression<BasicMatrix<T>, E>& expr) MAY_THROW_EXCEPTION;
+		
 		Real sum() const throw();
 		Real prod() const throw();
 		::tempobj::force_temporary_class<Vector>::type rowsum() const MAY_THROW_EXCEPTION;
@@ -152,18 +199,20 @@ namespace igraph {
 		BasicMatrix<T>& remove_col(long j) MAY_THROW_EXCEPTION;
 				
 		/// Print content of the Matrix.
-		void print(const char* row_separator = "; ", const char* separator = " ", std::FILE* f = stdout) const throw() {
+		void print(const char* row_separator = "; ", const char* separator = " ", std::FILE* f = stdout) const MAY_THROW_EXCEPTION {
+			OutputBuffer out (f);
 			long m = nrow(), n = ncol();
 			for (long i = 0; i < m; ++ i) {
 				if (i != 0)
-					::std::fprintf(f, "%s", row_separator);
+					out.put(row_separator);
 				for (long j = 0; j < n; ++ j) {
 					if (j != 0)
-						::std::fprintf(f, "%s", separator);
-					XXINTRNL_fprintf(f, MATRIX(_, i, j));
+						out.put(separator);
+					out.put_number(MATRIX(_, i, j));
 				}
 			}
-			::std::fprintf(f, "\n");
+			out.put('\n');
+			out.flush();
 		}
 		friend class Community;
 		friend class Graph;
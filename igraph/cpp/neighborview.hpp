@@ -0,0 +1,173 @@
+/*
+
+neighborview.hpp ... Views of the neighbors and incident edges of a vertex, without copying.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_NEIGHBORVIEW_HPP
+#define IGRAPH_NEIGHBORVIEW_HPP
+
+#include <igraph/igraph.h>
+#include <igraph/cpp/common.hpp>
+#include <iterator>
+
+namespace igraph {
+	/**
+	 \internal
+	 \brief The edges around a vertex, read from igraph's own index.
+
+	 igraph keeps the edges sorted by source (oi, os) and by target (ii, is).
+	 The out-edges of v are oi[os[v]] to oi[os[v+1]-1], and the in-edges are
+	 found the same way in ii and is. A view covers the out-edges, the
+	 in-edges, or the out-edges followed by the in-edges.
+
+	 If \p Edges is true the elements are the edge IDs, otherwise the vertices
+	 at the other end of the edges.
+	 */
+	template <bool Edges>
+	class XXINTRNL_IncidenceView {
+	private:
+		// segment 0 is walked first, then segment 1.
+		const Real* first[2];
+		const Real* last[2];
+		const Real* endpoints[2];	// "to" for out-edges, "from" for in-edges.
+
+	public:
+		/// The iterator does not refer to the view, so it stays valid after the view is gone.
+		class iterator {
+		private:
+			const Real* position;
+			const Real* segment_end;	// NULL in segment 1.
+			const Real* next_first;
+			const Real* endpoints;
+			const Real* next_endpoints;
+
+			void skip_empty() throw() {
+				if (position == segment_end) {
+					position = next_first;
+					endpoints = next_endpoints;
+					segment_end = NULL;
+				}
+			}
+
+		public:
+			typedef ::std::forward_iterator_tag iterator_category;
+			typedef Real value_type;
+			typedef long difference_type;
+			typedef const Real* pointer;
+			typedef Real reference;
+
+			iterator() throw() : position(NULL), segment_end(NULL), next_first(NULL), endpoints(NULL), next_endpoints(NULL) {}
+			iterator(const XXINTRNL_IncidenceView& view, const int segment) throw() {
+				if (segment == 0) {
+					position = view.first[0];
+					segment_end = view.last[0];
+					endpoints = view.endpoints[0];
+				} else {
+					position = view.last[1];
+					segment_end = NULL;
+					endpoints = view.endpoints[1];
+				}
+				next_first = view.first[1];
+				next_endpoints = view.endpoints[1];
+				skip_empty();
+			}
+
+			Real operator*() const throw() { return Edges ? *position : endpoints[static_cast<long>(*position)]; }
+			iterator& operator++() throw() { ++ position; skip_empty(); return *this; }
+			iterator operator++(int) throw() { iterator res = *this; ++ *this; return res; }
+
+			// the segment is compared too, because the end of one index array may be the start of the other.
+			bool operator==(const iterator& other) const throw() { return position == other.position && (segment_end == NULL) == (other.segment_end == NULL); }
+			bool operator!=(const iterator& other) const throw() { return !(*this == other); }
+		};
+		typedef iterator const_iterator;
+		typedef Real value_type;
+
+		XXINTRNL_IncidenceView(const igraph_t* graph, const long v, NeighboringMode mode) throw() {
+			const Real* oi = VECTOR(graph->oi);
+			const Real* ii = VECTOR(graph->ii);
+			const Real* os = VECTOR(graph->os);
+			const Real* is = VECTOR(graph->is);
+			if (!igraph_is_directed(graph))
+				mode = AllNeighbors;
+
+			// the unused segment is an empty range at the end of the used one, so that end() is the same either way.
+			if (mode == InNeighbors) {
+				first[0] = ii + static_cast<long>(is[v]);
+				last[0] = ii + static_cast<long>(is[v+1]);
+				endpoints[0] = VECTOR(graph->from);
+			} else {
+				first[0] = oi + static_cast<long>(os[v]);
+				last[0] = oi + static_cast<long>(os[v+1]);
+				endpoints[0] = VECTOR(graph->to);
+			}
+			if (mode == OutNeighbors || mode == InNeighbors) {
+				first[1] = last[1] = last[0];
+				endpoints[1] = endpoints[0];
+			} else {
+				first[1] = ii + static_cast<long>(is[v]);
+				last[1] = ii + static_cast<long>(is[v+1]);
+				endpoints[1] = VECTOR(graph->from);
+			}
+		}
+
+		iterator begin() const throw() { return iterator(*this, 0); }
+		iterator end() const throw() { return iterator(*this, 1); }
+
+		long size() const throw() { return (last[0] - first[0]) + (last[1] - first[1]); }
+		bool empty() const throw() { return size() == 0; }
+
+		Real operator[](long index) const throw() {
+			int segment = 0;
+			if (index >= last[0] - first[0]) {
+				index -= last[0] - first[0];
+				segment = 1;
+			}
+			const Real* position = first[segment] + index;
+			return Edges ? *position : endpoints[segment][static_cast<long>(*position)];
+		}
+	};
+
+	/**
+	 \class NeighborView
+	 \brief The neighbors of a vertex, read directly from the graph without allocating.
+
+	 The neighbors are in the same order as Graph::neighbors(), except that
+	 for AllNeighbors on a directed graph the out-neighbors come first, then
+	 the in-neighbors, instead of being merged. Each element of the view is
+	 looked up when it is read, so the view is invalid once the graph changes.
+
+	 \code
+	 for (Vertex u : g.neighbor_view(v))
+	     visit(v, u);
+	 \endcode
+	 */
+	typedef XXINTRNL_IncidenceView<false> NeighborView;
+
+	/**
+	 \class IncidentEdgeView
+	 \brief The IDs of the edges at a vertex, read directly from the graph without allocating.
+
+	 The edges are in the same order as the vertices of the NeighborView of
+	 the same vertex and mode.
+	 */
+	typedef XXINTRNL_IncidenceView<true> IncidentEdgeView;
+}
+
+#endif
@@ -0,0 +1,225 @@
+/*
+
+outputbuffer.hpp ... Buffered formatting of numbers into a file stream.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_OUTPUTBUFFER_HPP
+#define IGRAPH_OUTPUTBUFFER_HPP
+
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/exception.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace igraph {
+	/**
+	 \class OutputBuffer
+	 \brief Format numbers and strings into a large buffer, and write it to a stream in big blocks.
+
+	 The output is byte-identical to XXINTRNL_fprintf(), i.e. "%lg" for Real
+	 and "%ld" / "%d" for the integer types, but integers (and integral Reals
+	 which "%lg" prints without an exponent) are formatted without going through
+	 printf. The buffer is flushed when it is full and on destruction. A failed
+	 write is reported as IGRAPH_EFILE, except on destruction, so call flush()
+	 at the end to see it.
+
+	 Without a stream, the content is kept in a growing memory buffer instead,
+	 to be written out later with write_to().
+
+	 \code
+	 OutputBuffer out (stdout);
+	 out.put_number(3.0).put(", ").put_number(2.5).put('\n');	// prints "3, 2.5"
+	 \endcode
+	 */
+	class OutputBuffer {
+	private:
+		::std::FILE* fptr;
+		char* buffer;
+		char* cursor;
+		char* limit;
+		bool failed;
+
+		/// Longest output of a single number, including "%lg" of a negative denormal.
+		enum { MaxNumberLength = 32 };
+
+		OutputBuffer(const OutputBuffer&);
+		OutputBuffer& operator=(const OutputBuffer&);
+
+		int allocate(const ::std::size_t capacity) throw() {
+			buffer = reinterpret_cast<char*>(::std::malloc(capacity));
+			// without memory we can still work with a tiny buffer.
+			::std::size_t actual_capacity = capacity;
+			if (buffer == NULL || capacity < 4 * MaxNumberLength) {
+				::std::free(buffer);
+				actual_capacity = 4 * MaxNumberLength;
+				buffer = reinterpret_cast<char*>(::std::malloc(actual_capacity));
+			}
+			if (buffer == NULL) {
+				// every put() is then lost.
+				cursor = limit = NULL;
+				failed = true;
+				return IGRAPH_ENOMEM;
+			}
+			cursor = buffer;
+			limit = buffer + actual_capacity;
+			return IGRAPH_SUCCESS;
+		}
+
+		bool grow(const ::std::size_t length) throw() {
+			if (buffer == NULL)
+				return false;
+			::std::size_t used = cursor - buffer;
+			::std::size_t capacity = 2 * (limit - buffer);
+			if (capacity < used + length)
+				capacity = used + length;
+			char* new_buffer = reinterpret_cast<char*>(::std::realloc(buffer, capacity));
+			if (new_buffer == NULL)
+				return false;
+			buffer = new_buffer;
+			cursor = buffer + used;
+			limit = buffer + capacity;
+			return true;
+		}
+
+		bool reserve(const ::std::size_t length) MAY_THROW_EXCEPTION {
+			if (static_cast< ::std::size_t>(limit - cursor) >= length)
+				return true;
+			if (fptr != NULL)
+				flush();
+			else if (!grow(length)) {
+				// out of memory: keep accepting output, but remember that it is lost.
+				failed = true;
+				cursor = buffer;
+			}
+			if (static_cast< ::std::size_t>(limit - cursor) >= length)
+				return true;
+			failed = true;
+			return false;
+		}
+		
+		/// Write the whole of [data, data+length) to the stream, or return IGRAPH_EFILE.
+		int write(::std::FILE* f, const char* data, const ::std::size_t length) throw() {
+			if (length == 0 || ::std::fwrite(data, 1, length, f) == length)
+				return IGRAPH_SUCCESS;
+			failed = true;
+			return IGRAPH_EFILE;
+		}
+		int write_buffer() throw() {
+			if (fptr == NULL)
+				return IGRAPH_SUCCESS;
+			char* end = cursor;
+			cursor = buffer;
+			return write(fptr, buffer, end - buffer);
+		}
+
+		static char* format(char* dest, long value) throw() {
+			char digits[24];
+			char* p = digits + sizeof(digits);
+			unsigned long magnitude = value < 0 ? -static_cast<unsigned long>(value) : value;
+			do {
+				*--p = static_cast<char>('0' + magnitude % 10);
+				magnitude /= 10;
+			} while (magnitude != 0);
+			if (value < 0)
+				*--p = '-';
+			::std::size_t length = digits + sizeof(digits) - p;
+			::std::memcpy(dest, p, length);
+			return dest + length;
+		}
+		static char* format(char* dest, int value) throw() { return format(dest, static_cast<long>(value)); }
+		static char* format(char* dest, double value) throw() {
+			// "%g" prints integers below 10^6 exactly like "%ld", except for negative zero.
+			if (value > -1e6 && value < 1e6 && value == static_cast<double>(static_cast<long>(value)) && (value != 0 || 1/value > 0))
+				return format(dest, static_cast<long>(value));
+			else
+				return dest + ::std::sprintf(dest, "%g", value);
+		}
+
+	public:
+		explicit OutputBuffer(::std::FILE* f, const ::std::size_t capacity = 1 << 20) MAY_THROW_EXCEPTION : fptr(f), failed(false) {
+			TRY(allocate(capacity));
+		}
+		/// Format into memory. The buffer starts with the specified capacity and grows as needed.
+		explicit OutputBuffer(const ::std::size_t capacity = 1 << 16) MAY_THROW_EXCEPTION : fptr(NULL), failed(false) {
+			TRY(allocate(capacity));
+		}
+		~OutputBuffer() throw() {
+			write_buffer();
+			::std::free(buffer);
+		}
+
+		/// Write the buffered content to the stream. Does nothing when formatting into memory.
+		void flush() MAY_THROW_EXCEPTION {
+			TRY(write_buffer());
+		}
+
+		/// The content formatted into memory so far.
+		const char* data() const throw() { return buffer; }
+		::std::size_t size() const throw() { return cursor - buffer; }
+		/// Whether nothing was lost because the buffer could not grow or a write failed.
+		bool good() const throw() { return !failed; }
+
+		/// Write the content formatted into memory to a stream, and empty the buffer.
+		void write_to(::std::FILE* f) MAY_THROW_EXCEPTION {
+			int errcode = write(f, buffer, cursor - buffer);
+			clear();
+			TRY(errcode);
+		}
+		void clear() throw() {
+			cursor = buffer;
+			failed = false;
+		}
+
+		OutputBuffer& put(const char c) MAY_THROW_EXCEPTION {
+			if (reserve(1))
+				*cursor++ = c;
+			return *this;
+		}
+
+		OutputBuffer& put(const char* str) MAY_THROW_EXCEPTION {
+			::std::size_t length = ::std::strlen(str);
+			if (fptr != NULL && length > static_cast< ::std::size_t>(limit - buffer)) {
+				flush();
+				TRY(write(fptr, str, length));
+			} else if (reserve(length)) {
+				::std::memcpy(cursor, str, length);
+				cursor += length;
+			}
+			return *this;
+		}
+
+		/// Format a number in the same way as XXINTRNL_fprintf().
+		template <typename T>
+		OutputBuffer& put_number(const T value) MAY_THROW_EXCEPTION {
+			if (reserve(MaxNumberLength))
+				cursor = format(cursor, value);
+			return *this;
+		}
+
+		/// Format a Vertex or Edge ID as an integer.
+		OutputBuffer& put_id(const Integer value) MAY_THROW_EXCEPTION {
+			if (reserve(MaxNumberLength))
+				cursor = format(cursor, static_cast<long>(value));
+			return *this;
+		}
+	};
+}
+
+#endif
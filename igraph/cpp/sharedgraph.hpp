@@ -0,0 +1,88 @@
+/*
+
+sharedgraph.hpp ... Graphs shared between owners until one of them changes it.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_SHAREDGRAPH_HPP
+#define IGRAPH_SHAREDGRAPH_HPP
+
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/graph.hpp>
+
+namespace igraph {
+	/**
+	 \class SharedGraph
+	 \brief A graph whose copies share one igraph_t until one of them is changed.
+
+	 Copying a Graph copies all its vertices and edges. Copying a SharedGraph
+	 only adds a reference, in O(1). The graph is copied the first time
+	 mutate() is called on a SharedGraph which is not the only reference, so
+	 the other references never see the change.
+
+	 All const Graph functions are reached through ->, or by passing the
+	 SharedGraph where a const Graph& is expected. The reference count is
+	 updated atomically, so copies of one SharedGraph can be read, copied and
+	 destroyed on different threads.
+
+	 \code
+	 SharedGraph base (Graph::famous("Zachary"));
+	 SharedGraph variant = base;                  // O(1)
+	 Vector bc = variant->betweenness(VertexSelector::all());
+	 variant.mutate().add_edge(0, 9);             // base is unchanged.
+	 \endcode
+
+	 The Graph references returned by mutate() and graph() are invalid once
+	 the SharedGraph is copied into or assigned from.
+	 */
+	class SharedGraph {
+	private:
+		struct Block;
+		Block* shared;
+
+		void release() throw();
+
+	public:
+		MEMORY_MANAGER_INTERFACE(SharedGraph);
+
+		/// Share a copy of \p g.
+		explicit SharedGraph(const Graph& g);
+		/// Share \p g itself, in O(1).
+		explicit SharedGraph(XXINTRNL_PARAMTYPE(, Graph) g);
+
+		const Graph& graph() const throw();
+		const Graph& operator*() const throw() { return graph(); }
+		const Graph* operator->() const throw() { return &graph(); }
+		operator const Graph&() const throw() { return graph(); }
+
+		/**
+		 \brief The graph, for changing it.
+
+		 - \b Complexity: O(|V|+|E|) if the graph is shared, otherwise O(1).
+		 */
+		Graph& mutate();
+
+		/// The number of SharedGraphs referring to this graph.
+		long use_count() const throw();
+		bool unique() const throw() { return use_count() == 1; }
+	};
+
+	MEMORY_MANAGER_INTERFACE_EX(SharedGraph);
+}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+
+sparsematrix.hpp ... Real matrices in compressed sparse row form.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_SPARSEMATRIX_HPP
+#define IGRAPH_SPARSEMATRIX_HPP
+
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/vector.hpp>
+#include <igraph/cpp/matrix.hpp>
+#include <vector>
+
+namespace igraph {
+	class Graph;
+
+	/**
+	 \class SparseMatrix
+	 \brief A Real matrix which stores only its nonzero entries, in compressed sparse row form.
+
+	 The entries of row i are at positions offsets()[i] to offsets()[i+1]-1
+	 of columns() and values(), sorted by column. The memory used is
+	 O(nrow + nonzeros), instead of O(nrow * ncol) for a Matrix.
+
+	 A column-oriented (CSC) form of a matrix is the CSR form of its
+	 transpose, so algorithms which walk over columns should use
+	 transpose() once, then walk over its rows.
+
+	 The Graph functions which return a |V| by |V| Matrix, such as
+	 Graph::get_adjacency() and Graph::laplacian(), have _sparse variants
+	 which return a SparseMatrix instead. They compute the same values
+	 without ever allocating the dense matrix.
+
+	 Entries which are zero are not stored, so the products skip them: a NaN
+	 or infinite element of a vector or matrix only reaches the rows of the
+	 result which have an entry in its column, where the dense product would
+	 give NaN everywhere (0 * NaN is NaN). A NaN entry is stored, since it is
+	 not zero.
+
+	 \code
+	 SparseMatrix a = g.get_adjacency_sparse();
+	 Vector x = Vector::seq(1, g.size());
+	 Vector y = a * x;				// the sum of the neighbors of each vertex.
+	 Vector indegree = a.colsum();
+	 \endcode
+	 */
+	class SparseMatrix {
+	public:
+		/// The nonzero entries of a row, in increasing order of column.
+		class Row {
+			const long* column_first;
+			const Real* value_first;
+			long count;
+		public:
+			Row(const long* column_first_, const Real* value_first_, const long count_) throw() : column_first(column_first_), value_first(value_first_), count(count_) {}
+
+			long size() const throw() { return count; }
+			bool empty() const throw() { return count == 0; }
+			/// The column of the k-th entry.
+			long column(const long k) const throw() { return column_first[k]; }
+			/// The value of the k-th entry.
+			Real value(const long k) const throw() { return value_first[k]; }
+			const long* columns() const throw() { return column_first; }
+			const Real* values() const throw() { return value_first; }
+		};
+
+	private:
+		long row_count;
+		long col_count;
+		::std::vector<long> offset_array;	// row_count + 1 entries.
+		::std::vector<long> column_array;
+		::std::vector<Real> value_array;
+
+		// Filling row by row, for Graph: reset(), then push() the entries of a row in order of column and end_row().
+		void reset(const long nrow, const long ncol);
+		void push(const long column, const Real value) { column_array.push_back(column); value_array.push_back(value); }
+		void end_row() { offset_array.push_back(static_cast<long>(column_array.size())); }
+
+		void assign_triplets(const long nrow, const long ncol, const ::std::vector<long>& rows, const ::std::vector<long>& cols, const ::std::vector<Real>& values);
+
+	public:
+		MEMORY_MANAGER_INTERFACE(SparseMatrix);
+
+		/// A 0 by 0 matrix.
+		SparseMatrix() throw();
+		/// An \p nrow by \p ncol matrix of zeros.
+		SparseMatrix(const long nrow, const long ncol);
+		/**
+		 \brief The nonzero entries of a dense matrix.
+
+		 - \b Complexity: O(nrow * ncol)
+		 */
+		explicit SparseMatrix(const Matrix& dense);
+
+		/**
+		 \brief A matrix with the entries (rows[k], cols[k]) = values[k].
+
+		 Entries at the same position are added. Entries which add up to zero
+		 are not stored. If the vectors have different lengths, or a position is
+		 outside the matrix or NaN, an igraph::Exception is thrown and the result
+		 is a matrix of zeros.
+
+		 - \b Complexity: O(nrow + k log k) for k entries.
+		 */
+		static ::tempobj::force_temporary_class<SparseMatrix>::type from_triplets(const long nrow, const long ncol, const Vector& rows, const Vector& cols, const Vector& values) MAY_THROW_EXCEPTION;
+
+		long nrow() const throw() { return row_count; }
+		long ncol() const throw() { return col_count; }
+		/// The number of stored entries.
+		long nonzeros() const throw() { return static_cast<long>(column_array.size()); }
+
+		/// The entry at (i, j), in O(log d) for d entries in row i.
+		Real operator() (const long i, const long j) const throw();
+		/// The nonzero entries of row i.
+		Row row(const long i) const throw() { return Row(columns() + offset_array[i], values() + offset_array[i], offset_array[i+1] - offset_array[i]); }
+
+		/// The raw arrays, for loops which walk over all entries.
+		const long* offsets() const throw() { return &offset_array[0]; }
+		const long* columns() const throw() { return column_array.empty() ? NULL : &column_array[0]; }
+		const Real* values() const throw() { return value_array.empty() ? NULL : &value_array[0]; }
+
+		/**
+		 \brief The transpose, which is also the compressed sparse column form of this matrix.
+
+		 - \b Complexity: O(nrow + ncol + nonzeros)
+		 */
+		::tempobj::force_temporary_class<SparseMatrix>::type transpose() const;
+		/// The dense form of the matrix.
+		::tempobj::force_temporary_class<Matrix>::type to_dense() const MAY_THROW_EXCEPTION;
+
+		/// The sum of each row, in O(nrow + nonzeros).
+		::tempobj::force_temporary_class<Vector>::type rowsum() const MAY_THROW_EXCEPTION;
+		/// The sum of each column, in O(ncol + nonzeros).
+		::tempobj::force_temporary_class<Vector>::type colsum() const MAY_THROW_EXCEPTION;
+		/// The sum of all entries.
+		Real sum() const throw();
+
+		SparseMatrix& operator*= (const Real k) throw();
+		SparseMatrix& operator/= (const Real k) throw();
+
+		/**
+		 \brief The product A x with a vector of ncol() elements.
+		 - \b Complexity: O(nrow + nonzeros)
+		 */
+		::tempobj::force_temporary_class<Vector>::type multiply(const Vector& x) const MAY_THROW_EXCEPTION;
+		/**
+		 \brief The product A^T x with a vector of nrow() elements, without computing the transpose.
+		 - \b Complexity: O(ncol + nonzeros)
+		 */
+		::tempobj::force_temporary_class<Vector>::type multiply_transposed(const Vector& x) const MAY_THROW_EXCEPTION;
+		/**
+		 \brief The product A M with a matrix of ncol() rows.
+		 - \b Complexity: O((nrow + nonzeros) * M.ncol())
+		 */
+		::tempobj::force_temporary_class<Matrix>::type multiply(const Matrix& m) const MAY_THROW_EXCEPTION;
+		/**
+		 \brief The product M A with a matrix of nrow() columns.
+		 - \b Complexity: O((ncol + nonzeros) * M.nrow())
+		 */
+		::tempobj::force_temporary_class<Matrix>::type left_multiply(const Matrix& m) const MAY_THROW_EXCEPTION;
+
+		bool operator== (const SparseMatrix& other) const throw();
+		bool operator!= (const SparseMatrix& other) const throw() { return !(*this == other); }
+
+		friend class Graph;
+		friend class XXINTRNL_SparseAccumulator;
+	};
+
+	MEMORY_MANAGER_INTERFACE_EX(SparseMatrix);
+	
+	/**
+	 \internal
+	 \brief Adds up the entries of one row in a dense array, for building a SparseMatrix row by row.
+	 
+	 Only the columns which were touched are visited when the row is written,
+	 so a row costs O(d log d) for d touched columns, not O(ncol).
+	 */
+	class XXINTRNL_SparseAccumulator {
+		::std::vector<Real> total;
+		::std::vector<char> used;
+		::std::vector<long> touched;
+	public:
+		explicit XXINTRNL_SparseAccumulator(const long ncol) : total(ncol, 0), used(ncol, 0) {}
+		
+		void add(const long column, const Real value) {
+			if (!used[column]) {
+				used[column] = 1;
+				touched.push_back(column);
+			}
+			total[column] += value;
+		}
+		/// Append the row to \p res, without the columns which add up to zero, and clear the accumulator.
+		void flush(SparseMatrix& res);
+	};
+
+	/// A x. See SparseMatrix::multiply().
+	static inline ::tempobj::force_temporary_class<Vector>::type operator* (const SparseMatrix& a, const Vector& x) MAY_THROW_EXCEPTION { return a.multiply(x); }
+	/// x^T A, as a vector. See SparseMatrix::multiply_transposed().
+	static inline ::tempobj::force_temporary_class<Vector>::type operator* (const Vector& x, const SparseMatrix& a) MAY_THROW_EXCEPTION { return a.multiply_transposed(x); }
+	/// A M. See SparseMatrix::multiply().
+	static inline ::tempobj::force_temporary_class<Matrix>::type operator* (const SparseMatrix& a, const Matrix& m) MAY_THROW_EXCEPTION { return a.multiply(m); }
+	/// M A. See SparseMatrix::left_multiply().
+	static inline ::tempobj::force_temporary_class<Matrix>::type operator* (const Matrix& m, const SparseMatrix& a) MAY_THROW_EXCEPTION { return a.left_multiply(m); }
+}
+
+#include <igraph/cpp/impl/sparsematrix.cpp>
+
+#endif
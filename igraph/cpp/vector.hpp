@@ -32,6 +32,8 @@
 #include <igraph/igraph.h>
 #include <igraph/cpp/common.hpp>
 #include <igraph/cpp/exception.hpp>
+#include <igraph/cpp/outputbuffer.hpp>
+#include <igraph/cpp/mappedfile.hpp>
 #include <cstdio>
 #if XXINTRNL_CXX0X
 #include <initializer_list>
@@ -40,6 +42,8 @@
 namespace igraph {
 	template <typename T>
 	class BasicMatrix;
+	template <typename C, typename E>
+	class LazyExpression;
 	
 	XXINTRNL_PREPARE_UNDERLYING_TYPES(BasicVector, vector);	
 	/**
@@ -170,6 +174,52 @@ namespace igraph {
 		 */
 		static typename ::tempobj::force_temporary_class<BasicVector<T> >::type view(const T* array, long count) throw();
 		
+		/**
+		 \brief Wrap a vector saved with save() as a read-only BasicVector.
+		 
+		 If the file was saved on a little-endian machine with the same element
+		 width, the result is a view into the mapped content, so no element is
+		 copied and the pages are only read from the disk when they are used.
+		 Otherwise the elements are converted into a new vector.
+		 
+		 In either case the result must not outlive \p file, and must not be
+		 modified or resized.
+		 
+		 \param[in] file The mapped content of a file written by save().
+		 
+		 - \b Complexity: O(1) for a view, O(n) otherwise.
+		 \throw Exception IGRAPH_PARSEERROR if the file is not a saved vector of type T.
+		 */
+		static typename ::tempobj::force_temporary_class<BasicVector<T> >::type view(const MappedFile& file) MAY_THROW_EXCEPTION;
+		
+		/**
+		 \brief Read a vector saved with save().
+		 \param[in] filename The name of the file to read.
+		 
+		 - \b Complexity: O(n)
+		 \throw Exception IGRAPH_EFILE if the file cannot be opened, IGRAPH_PARSEERROR if it is not a saved vector of type T.
+		 */
+		static typename ::tempobj::force_temporary_class<BasicVector<T> >::type load(const char* filename) MAY_THROW_EXCEPTION;
+		/// Read a vector saved with save(), starting at the current position of the stream.
+		static typename ::tempobj::force_temporary_class<BasicVector<T> >::type load(::std::FILE* filestream) MAY_THROW_EXCEPTION;
+		/// Read a vector saved with save() from mapped content, always copying the elements.
+		static typename ::tempobj::force_temporary_class<BasicVector<T> >::type load(const MappedFile& file) MAY_THROW_EXCEPTION;
+		
+		/**
+		 \brief Write the vector in a raw binary format.
+		 
+		 The file starts with a 32-byte header (the magic "IGVC", the format
+		 version, the element type and width, and the number of elements),
+		 followed by the elements in little-endian order. Use load() or view()
+		 to read it back.
+		 
+		 - \b Complexity: O(n)
+		 \throw Exception IGRAPH_EFILE if the file cannot be written.
+		 */
+		void save(const char* filename) const MAY_THROW_EXCEPTION;
+		/// Write the vector in a raw binary format to a stream. A short write raises IGRAPH_EFILE.
+		void save(::std::FILE* filestream) const MAY_THROW_EXCEPTION;
+		
 		/**
 		 \brief Fill the vector with zeros.
 		 Note that BasicVector(long count) already zeros out the whole vector,
@@ -377,6 +427,22 @@ namespace igraph {
 		 */
 		BasicVector<T>& operator/= (const BasicVector<T>& k) MAY_THROW_EXCEPTION;
 		
+		/**
+		 \brief Evaluate a LazyExpression into this vector in one pass.
+		 The vector is resized to the size of the expression.
+		 
+		 - \b Complexity: O(n)
+		 */
+		template <typename E> BasicVector<T>& operator= (const LazyExpression<BasicVector<T>, E>& expr) MAY_THROW_EXCEPTION;
+		/// Add a LazyExpression of the same size element-wise, in one pass.
+		template <typename E> BasicVector<T>& operator+= (const LazyExpression<BasicVector<T>, E>& expr) MAY_THROW_EXCEPTION;
+		/// Subtract a LazyExpression of the same size element-wise, in one pass.
+		template <typename E> BasicVector<T>& operator-= (const LazyExpression<BasicVector<T>, E>& expr) MAY_THROW_EXCEPTION;
+		/// Multiply by a LazyExpression of the same size element-wise, in one pass.
+		template <typename E> BasicVector<T>& operator*= (const LazyExpression<BasicVector<T>, E>& expr) MAY_THROW_EXCEPTION;
+		/// Divide by a LazyExpression of the same size element-wise, in one pass.
+		template <typename E> BasicVector<T>& operator/= (const LazyExpression<BasicVector<T>, E>& expr) MAY_THROW_EXCEPTION;
+		
 		/**
 		 \brief Return the smallest element of a vector
 		 - \b Complexity: O(n)
@@ -699,16 +765,18 @@ namespace igraph {
 		 
 		 - \b Complexity: O(n).
 		 */
-		void print(const char* separator = " ", std::FILE* f = stdout) const throw() {
+		void print(const char* separator = " ", std::FILE* f = stdout) const MAY_THROW_EXCEPTION {
+			OutputBuffer out (f);
 			bool is_first = true;
 			for (const_iterator cit = begin(); cit != end(); ++ cit) {
 				if (is_first)
 					is_first = false;
 				else
-					::std::fprintf(f, "%s", separator);
-				XXINTRNL_fprintf(f, *cit);
+					out.put(separator);
+				out.put_number(*cit);
 			}
-			::std::fprintf(f, "\n");
+			out.put('\n');
+			out.flush();
 		}
 		
 		/**
@@ -802,6 +870,7 @@ namespace igraph {
 		friend class Graph;
 		friend class GraphWriter;
 		friend class GraphReader;
+		friend class GraphBatch;
 		template<typename U>
 		friend class BasicMatrix;
 		friend class Community;
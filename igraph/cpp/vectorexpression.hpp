@@ -0,0 +1,220 @@
+/*
+
+vectorexpression.hpp ... Lazy element-wise arithmetic of vectors and matrices, evaluated in one pass.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_VECTOREXPRESSION_HPP
+#define IGRAPH_VECTOREXPRESSION_HPP
+
+#include <igraph/cpp/common.hpp>
+#include <igraph/cpp/vector.hpp>
+#include <igraph/cpp/matrix.hpp>
+
+namespace igraph {
+#pragma mark -
+#pragma mark Expression nodes
+	
+	// Every node has the shape of its operands: rows() and cols() are -1 for
+	// a constant, and XXINTRNL_ExprMismatch if two operands differ in shape.
+	// A vector is a column, with cols() == 1.
+	static const long XXINTRNL_ExprMismatch = -2;
+	
+	static inline long XXINTRNL_combine_extents(const long a, const long b) throw() {
+		if (a == -1)
+			return b;
+		if (b == -1)
+			return a;
+		return a == b ? a : XXINTRNL_ExprMismatch;
+	}
+	
+	/// \internal The elements of a vector or matrix, which must outlive the expression.
+	template <typename T>
+	struct XXINTRNL_ExprArray {
+		const T* data;
+		long nrow, ncol;
+		
+		T operator[] (const long i) const throw() { return data[i]; }
+		long rows() const throw() { return nrow; }
+		long cols() const throw() { return ncol; }
+	};
+	
+	/// \internal A scalar used with every element.
+	template <typename T>
+	struct XXINTRNL_ExprConstant {
+		T value;
+		
+		T operator[] (const long) const throw() { return value; }
+		long rows() const throw() { return -1; }
+		long cols() const throw() { return -1; }
+	};
+	
+	/// \internal Apply Op to the elements of L and R with the same index.
+	template <typename T, typename Op, typename L, typename R>
+	struct XXINTRNL_ExprBinary {
+		L left;
+		R right;
+		
+		T operator[] (const long i) const throw() { return Op::apply(left[i], right[i]); }
+		long rows() const throw() { return XXINTRNL_combine_extents(left.rows(), right.rows()); }
+		long cols() const throw() { return XXINTRNL_combine_extents(left.cols(), right.cols()); }
+	};
+	
+	/// \internal Negate every element of A.
+	template <typename T, typename A>
+	struct XXINTRNL_ExprNegate {
+		A operand;
+		
+		T operator[] (const long i) const throw() { return -operand[i]; }
+		long rows() const throw() { return operand.rows(); }
+		long cols() const throw() { return operand.cols(); }
+	};
+	
+	struct XXINTRNL_ExprPlus { template <typename T> static T apply(const T a, const T b) throw() { return a + b; } };
+	struct XXINTRNL_ExprMinus { template <typename T> static T apply(const T a, const T b) throw() { return a - b; } };
+	struct XXINTRNL_ExprTimes { template <typename T> static T apply(const T a, const T b) throw() { return a * b; } };
+	struct XXINTRNL_ExprDivide { template <typename T> static T apply(const T a, const T b) throw() { return a / b; } };
+	
+#pragma mark -
+#pragma mark LazyExpression
+	
+	/**
+	 \class LazyExpression
+	 \brief An element-wise expression of vectors or matrices, evaluated when it is assigned.
+	 
+	 The operators of BasicVector and BasicMatrix return a new container for
+	 each operation, so <tt>v = a * 0.85 + b - c</tt> allocates and walks
+	 memory three times. Wrapping the first operand with lazy() makes the
+	 operators build a LazyExpression instead, which does no work until it is
+	 assigned. The assignment computes each element of the result in one pass
+	 over the operands, writing into the storage of the destination.
+	 
+	 \code
+	 Vector v = Vector::n();
+	 for (int i = 0; i < iterations; ++ i)
+	     v = lazy(a) * 0.85 + b - c;		// no allocation after the first iteration.
+	 v += lazy(a) * b;				// also fused.
+	 \endcode
+	 
+	 The destination may also be an operand, since each element only depends
+	 on the elements of the operands with the same index. An expression
+	 refers to its operands without copying them, so it must not outlive
+	 them.
+	 
+	 The operands must have the same size, and matrices the same shape. If
+	 they do not, assigning the expression throws an igraph::Exception.
+	 
+	 \p C is BasicVector<T> or BasicMatrix<T>. Vectors and matrices cannot be
+	 mixed in one expression.
+	 */
+	template <typename C, typename E>
+	class LazyExpression {
+	public:
+		typedef typename C::value_type value_type;
+		typedef C container_type;
+		
+		E node;
+		
+		/// The element at \p i, computed from the operands.
+		value_type operator[] (const long i) const throw() { return node[i]; }
+		/// The number of rows of the result, or a negative number if the operands have different shapes.
+		long nrow() const throw() { return node.rows(); }
+		/// The number of columns of the result (1 for vectors), or a negative number if the operands have different shapes.
+		long ncol() const throw() { return node.cols(); }
+		/// Whether the operands have the same shape.
+		bool is_valid() const throw() { return node.rows() >= 0 && node.cols() >= 0; }
+		
+		/**
+		 \brief Evaluate the expression into a new vector or matrix.
+		 - \b Complexity: O(n), with one allocation.
+		 */
+		typename ::tempobj::force_temporary_class<C>::type evaluate() const MAY_THROW_EXCEPTION;
+		operator typename ::tempobj::force_temporary_class<C>::type () const MAY_THROW_EXCEPTION { return evaluate(); }
+	};
+	
+	/// \internal Make a LazyExpression from a node.
+	template <typename C, typename E>
+	static inline LazyExpression<C, E> XXINTRNL_make_lazy(const E& node) throw() {
+		LazyExpression<C, E> res = {node};
+		return res;
+	}
+	
+	/// Start a LazyExpression with a vector. The vector must outlive the expression.
+	template <typename T>
+	static inline LazyExpression<BasicVector<T>, XXINTRNL_ExprArray<T> > lazy(const BasicVector<T>& v) throw() {
+		XXINTRNL_ExprArray<T> node = {v.begin(), v.size(), 1};
+		return XXINTRNL_make_lazy<BasicVector<T> >(node);
+	}
+	
+	/// Start a LazyExpression with a matrix. The matrix must outlive the expression.
+	template <typename T>
+	static inline LazyExpression<BasicMatrix<T>, XXINTRNL_ExprArray<T> > lazy(const BasicMatrix<T>& m) throw() {
+		XXINTRNL_ExprArray<T> node = {m.size() == 0 ? NULL : &m(0, 0), m.nrow(), m.ncol()};
+		return XXINTRNL_make_lazy<BasicMatrix<T> >(node);
+	}
+	
+	/// A LazyExpression is already lazy.
+	template <typename C, typename E>
+	static inline const LazyExpression<C, E>& lazy(const LazyExpression<C, E>& expr) throw() { return expr; }
+	
+	template <typename C, typename E>
+	static inline LazyExpression<C, XXINTRNL_ExprNegate<typename C::value_type, E> > operator- (const LazyExpression<C, E>& expr) throw() {
+		XXINTRNL_ExprNegate<typename C::value_type, E> node = {expr.node};
+		return XXINTRNL_make_lazy<C>(node);
+	}
+	
+	// Each operator takes a LazyExpression on either side, and a LazyExpression,
+	// a container of the same type or a scalar on the other side. The operators
+	// with a container on both sides are the immediate ones of BasicVector and
+	// BasicMatrix, which are left unchanged.
+#define XXINTRNL_LAZY_OPERATOR(op, Op) \
+	template <typename C, typename E1, typename E2> \
+	static inline LazyExpression<C, XXINTRNL_ExprBinary<typename C::value_type, Op, E1, E2> > operator op (const LazyExpression<C, E1>& a, const LazyExpression<C, E2>& b) throw() { \
+		XXINTRNL_ExprBinary<typename C::value_type, Op, E1, E2> node = {a.node, b.node}; \
+		return XXINTRNL_make_lazy<C>(node); \
+	} \
+	template <typename C, typename E> \
+	static inline LazyExpression<C, XXINTRNL_ExprBinary<typename C::value_type, Op, E, XXINTRNL_ExprArray<typename C::value_type> > > operator op (const LazyExpression<C, E>& a, const C& b) throw() { \
+		return a op lazy(b); \
+	} \
+	template <typename C, typename E> \
+	static inline LazyExpression<C, XXINTRNL_ExprBinary<typename C::value_type, Op, XXINTRNL_ExprArray<typename C::value_type>, E> > operator op (const C& a, const LazyExpression<C, E>& b) throw() { \
+		return lazy(a) op b; \
+	} \
+	template <typename C, typename E> \
+	static inline LazyExpression<C, XXINTRNL_ExprBinary<typename C::value_type, Op, E, XXINTRNL_ExprConstant<typename C::value_type> > > operator op (const LazyExpression<C, E>& a, const typename C::value_type b) throw() { \
+		XXINTRNL_ExprBinary<typename C::value_type, Op, E, XXINTRNL_ExprConstant<typename C::value_type> > node = {a.node, {b}}; \
+		return XXINTRNL_make_lazy<C>(node); \
+	} \
+	template <typename C, typename E> \
+	static inline LazyExpression<C, XXINTRNL_ExprBinary<typename C::value_type, Op, XXINTRNL_ExprConstant<typename C::value_type>, E> > operator op (const typename C::value_type a, const LazyExpression<C, E>& b) throw() { \
+		XXINTRNL_ExprBinary<typename C::value_type, Op, XXINTRNL_ExprConstant<typename C::value_type>, E> node = {{a}, b.node}; \
+		return XXINTRNL_make_lazy<C>(node); \
+	}
+	
+	XXINTRNL_LAZY_OPERATOR(+, XXINTRNL_ExprPlus)
+	XXINTRNL_LAZY_OPERATOR(-, XXINTRNL_ExprMinus)
+	XXINTRNL_LAZY_OPERATOR(*, XXINTRNL_ExprTimes)
+	XXINTRNL_LAZY_OPERATOR(/, XXINTRNL_ExprDivide)
+	
+#undef XXINTRNL_LAZY_OPERATOR
+}
+
+#include <igraph/cpp/impl/vectorexpression.cpp>
+
+#endif
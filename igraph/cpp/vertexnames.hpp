@@ -0,0 +1,95 @@
+/*
+
+vertexnames.hpp ... Interned table of vertex names.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef IGRAPH_VERTEXNAMES_HPP
+#define IGRAPH_VERTEXNAMES_HPP
+
+#include <igraph/cpp/common.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace igraph {
+	/**
+	 \class VertexNames
+	 \brief A two-way mapping between vertex names and dense vertex IDs.
+
+	 Names are copied into large arena blocks, so interning a name never
+	 allocates a string on its own, and the pointers returned by operator[]
+	 stay valid until the table is cleared or destroyed. Lookup uses an
+	 open-addressing hash table with linear probing.
+
+	 \code
+	 VertexNames names;
+	 names.intern("alice");	// 0
+	 names.intern("bob");	// 1
+	 names.intern("alice");	// 0
+	 printf("%s\n", names[1]);	// bob
+	 \endcode
+	 */
+	class VertexNames {
+	private:
+		struct Slot {
+			::std::size_t hash;
+			long id;	// -1 if empty.
+		};
+
+		::std::vector<char*> blocks;
+		char* block_cursor;
+		char* block_limit;
+		::std::vector<const char*> names;
+		::std::vector< ::std::size_t> lengths;
+		::std::vector<Slot> slots;
+
+		VertexNames(const VertexNames&);
+		VertexNames& operator=(const VertexNames&);
+
+		static ::std::size_t hash(const char* str, const ::std::size_t length) throw();
+		const char* store(const char* str, const ::std::size_t length);
+		void rehash(const ::std::size_t new_slot_count);
+		long find(const char* str, const ::std::size_t length, const ::std::size_t h) const throw();
+
+	public:
+		VertexNames();
+		~VertexNames() throw();
+
+		/// Return the ID of the name, adding it to the table if it is new.
+		Vertex intern(const char* str, const ::std::size_t length);
+		Vertex intern(const char* str) { return intern(str, ::std::strlen(str)); }
+
+		/// Return the ID of the name, or -1 if it is not in the table.
+		Vertex find(const char* str, const ::std::size_t length) const throw() { return find(str, length, hash(str, length)); }
+		Vertex find(const char* str) const throw() { return find(str, ::std::strlen(str)); }
+
+		/// The NUL-terminated name of a vertex.
+		const char* operator[](const Vertex vid) const throw() { return names[static_cast< ::std::size_t>(vid)]; }
+		/// Length of the name of a vertex.
+		::std::size_t length_of(const Vertex vid) const throw() { return lengths[static_cast< ::std::size_t>(vid)]; }
+
+		/// Number of names, which is also the next ID to be assigned.
+		long size() const throw() { return names.size(); }
+		bool empty() const throw() { return names.empty(); }
+
+		void clear() throw();
+	};
+}
+
+#endif
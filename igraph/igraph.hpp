@@ -29,11 +29,25 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <igraph/cpp/vector.hpp>
 #include <igraph/cpp/referencevector.hpp>
 #include <igraph/cpp/matrix.hpp>
+#include <igraph/cpp/vectorexpression.hpp>
+#include <igraph/cpp/sparsematrix.hpp>
+#include <igraph/cpp/idvector.hpp>
+
+#include <igraph/cpp/mappedfile.hpp>
+#include <igraph/cpp/vertexnames.hpp>
 
 #include <igraph/cpp/graph.hpp>
 #include <igraph/cpp/graphio.hpp>
+#include <igraph/cpp/edgestream.hpp>
+#include <igraph/cpp/graphbatch.hpp>
+#include <igraph/cpp/sharedgraph.hpp>
+#include <igraph/cpp/graphview.hpp>
 
 #include <igraph/cpp/adjlist.hpp>
+#include <igraph/cpp/csrgraph.hpp>
+#include <igraph/cpp/compressedgraph.hpp>
+#include <igraph/cpp/neighborview.hpp>
+#include <igraph/cpp/edgeindex.hpp>
 
 #include <igraph/cpp/vertexselector.hpp>
 #include <igraph/cpp/vertexiterator.hpp>
@@ -47,10 +61,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <igraph/cpp/impl/vertexselector.cpp>
 #include <igraph/cpp/impl/edgeselector.cpp>
 
+#include <igraph/cpp/impl/idvector.cpp>
+#include <igraph/cpp/impl/mappedfile.cpp>
+#include <igraph/cpp/impl/vertexnames.cpp>
+
 #include <igraph/cpp/impl/graph.cpp>
 #include <igraph/cpp/impl/graphio.cpp>
+#include <igraph/cpp/impl/edgestream.cpp>
+#include <igraph/cpp/impl/graphbatch.cpp>
+#include <igraph/cpp/impl/sharedgraph.cpp>
+#include <igraph/cpp/impl/graphview.cpp>
 
 #include <igraph/cpp/impl/adjlist.cpp>
+#include <igraph/cpp/impl/csrgraph.cpp>
+#include <igraph/cpp/impl/compressedgraph.cpp>
+#include <igraph/cpp/impl/edgeindex.cpp>
 
 #include <igraph/cpp/impl/iterators.cpp>
 
@@ -0,0 +1,99 @@
+/*
+
+compressed.cpp ... Size and decoding speed of CompressedGraph.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+// Build: g++ -std=gnu++0x -O2 -I../../ -o compressed compressed.cpp -ligraph
+// Usage: ./compressed [vertices] [edges per vertex]
+//        ./compressed file.edges
+//
+// Reports the bytes per edge of igraph's representation, of CsrGraph and of
+// CompressedGraph, before and after reordering the vertices for locality,
+// and how fast the compressed lists are decoded, swept by BFS and clustered.
+
+#include <igraph/igraph.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+using namespace igraph;
+
+static double seconds_since(clock_t start) {
+	return static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void report(const char* name, const CompressedGraph& cg) {
+	long n = cg.size(), m = cg.edges();
+	printf("%-12s %8.2f bytes per edge\n", name, cg.bytes_per_edge());
+
+	// decode every list twice: by iterating, and all at once into an IdVector.
+	clock_t start = clock();
+	long entries = 0, checksum = 0;
+	for (long v = 0; v < n; ++ v) {
+		CompressedGraph::Range nei = cg.neighbors(v);
+		for (CompressedGraph::iterator it = nei.begin(); it != nei.end(); ++ it, ++ entries)
+			checksum += *it;
+	}
+	double iterate_time = seconds_since(start);
+
+	start = clock();
+	IdVector32 ids;
+	for (long v = 0; v < n; ++ v) {
+		cg.neighbors(v, ids);
+		checksum -= ids.empty() ? 0 : ids[ids.size() - 1];
+	}
+	double bulk_time = seconds_since(start);
+
+	printf("             decode %8.1f M neighbors/s iterating, %8.1f M/s in bulk   (%ld)\n",
+		   entries / iterate_time / 1e6, entries / bulk_time / 1e6, checksum);
+
+	start = clock();
+	IdVector32 distance;
+	cg.bfs_distances(0, distance);
+	double bfs_time = seconds_since(start);
+	start = clock();
+	long components = cg.cluster_count();
+	printf("             bfs %8.3f s   components %8.3f s   (%ld components, %ld edges)\n", bfs_time, seconds_since(start), components, m);
+}
+
+int main (int argc, char* argv[]) {
+	Graph g = Graph::empty(0);
+	if (argc > 1 && atol(argv[1]) == 0) {
+		EdgeStream stream (argv[1]);
+		g = GraphBuilder().append(stream).build();
+	} else {
+		Integer n = argc > 1 ? atol(argv[1]) : 1000000;
+		Integer m = argc > 2 ? atol(argv[2]) : 8;
+		g = Graph::barabasi_game(n, m);
+	}
+	long n = g.size(), m = g.edges();
+	printf("%ld vertices, %ld edges\n", n, m);
+	printf("%-12s %8.2f bytes per edge\n", "igraph", (4.0 * m + 2.0 * (n + 1)) * sizeof(Real) / m);
+	printf("%-12s %8.2f bytes per edge\n", "CsrGraph", (4.0 * m + (n + 1)) * sizeof(long) / m);
+
+	clock_t start = clock();
+	CompressedGraph cg (g);
+	printf("compressing took %.3f s\n", seconds_since(start));
+	report("compressed", cg);
+
+	g.reorder_for_locality(Graph::LocalityOrdering_ReverseCuthillMcKee);
+	report("RCM order", CompressedGraph(g));
+
+	return 0;
+}
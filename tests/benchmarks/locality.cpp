@@ -0,0 +1,117 @@
+/*
+
+locality.cpp ... Speed of graph traversals before and after reordering the vertices.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+// Build: g++ -std=gnu++0x -O2 -I../../ -o locality locality.cpp -ligraph
+// Usage: ./locality [grid side] [rewiring probability] [betweenness cutoff]
+//
+// The vertices of a rewired 2D lattice are shuffled first, so that their IDs
+// carry no locality, and the graph is then reordered by every method.
+
+#include <igraph/igraph.hpp>
+#include <gsl/cpp/rng_minimal.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+using namespace std;
+using namespace igraph;
+
+static double seconds_since(clock_t start) {
+	return static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/// Breadth-first search from every 64th vertex over the CSR snapshot, returning the sum of distances.
+static long bfs_sweep(const CsrGraph& csr) {
+	long n = csr.size(), total = 0;
+	vector<long> distance (n), queue (n);
+	for (long source = 0; source < n; source += 64) {
+		fill(distance.begin(), distance.end(), -1);
+		long head = 0, tail = 0;
+		distance[source] = 0;
+		queue[tail++] = source;
+		while (head < tail) {
+			long v = queue[head++];
+			CsrGraph::Range nei = csr.out_neighbors(v);
+			for (const long* p = nei.begin(); p != nei.end(); ++ p)
+				if (distance[*p] < 0) {
+					distance[*p] = distance[v] + 1;
+					total += distance[*p];
+					queue[tail++] = *p;
+				}
+		}
+	}
+	return total;
+}
+
+static void run(const char* name, const Graph& g, Integer cutoff) {
+	clock_t start = clock();
+	CsrGraph csr = g.freeze();
+	long checksum = bfs_sweep(csr);
+	double bfs_time = seconds_since(start);
+
+	start = clock();
+	g.betweenness_estimate(VertexSelector::all(), Undirected, cutoff);
+	double betweenness_time = seconds_since(start);
+
+	start = clock();
+	ArpackOptions options;
+	g.pagerank(VertexSelector::all(), Undirected, 0.85, options);
+	double pagerank_time = seconds_since(start);
+
+	printf("%-20s bfs %8.3f s   betweenness %8.3f s   pagerank %8.3f s   (%ld)\n", name, bfs_time, betweenness_time, pagerank_time, checksum);
+}
+
+int main (int argc, char* argv[]) {
+	Integer side = argc > 1 ? atol(argv[1]) : 500;
+	Real p = argc > 2 ? atof(argv[2]) : 0.01;
+	Integer cutoff = argc > 3 ? atol(argv[3]) : 4;
+
+	Graph g = Graph::lattice_2d(side, side).rewire_edges_simple(p);
+	long n = g.size();
+
+	// A random permutation, so that the original IDs carry no locality.
+	gsl::Random rangen = gsl::Random::default_generator();
+	VertexVector shuffle = VertexVector::n();
+	for (long i = 0; i < n; ++ i)
+		shuffle.push_back(i);
+	for (long i = n - 1; i > 0; -- i) {
+		long j = rangen.uniform_int(i + 1);
+		Vertex t = shuffle[i];
+		shuffle[i] = shuffle[j];
+		shuffle[j] = t;
+	}
+	Graph shuffled = g.permute_vertices(shuffle);
+	printf("%ld vertices, %ld edges\n", n, g.edges());
+
+	run("shuffled", shuffled, cutoff);
+
+	const char* names[] = {"reverse Cuthill-McKee", "degree descending", "Gorder"};
+	Graph::LocalityOrdering methods[] = {Graph::LocalityOrdering_ReverseCuthillMcKee, Graph::LocalityOrdering_DegreeDescending, Graph::LocalityOrdering_Gorder};
+	for (int i = 0; i < 3; ++ i) {
+		clock_t start = clock();
+		Graph reordered = shuffled;
+		reordered.reorder_for_locality(methods[i]);
+		printf("%-20s ordering took %.3f s\n", names[i], seconds_since(start));
+		run(names[i], reordered, cutoff);
+	}
+
+	return 0;
+}
@@ -0,0 +1,77 @@
+/*
+
+ncol_reader.cpp ... Throughput of the NCOL reader against the integer edge list reader.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+// Build: g++ -std=gnu++0x -O2 -pthread -I../../ -o ncol_reader ncol_reader.cpp -ligraph
+// Usage: ./ncol_reader [vertex count] [average degree]
+
+#include <igraph/igraph.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+using namespace igraph;
+
+static void report(const char* name, clock_t start, long bytes) {
+	double seconds = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+	printf("%-28s %8.3f s %10.1f MiB/s\n", name, seconds, seconds > 0 ? bytes / 1048576.0 / seconds : 0);
+}
+
+int main (int argc, char* argv[]) {
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+	double degree = argc > 2 ? atof(argv[2]) : 10;
+
+	Graph g = Graph::erdos_renyi_game(n, degree / n);
+	Vector edges = g.get_edgelist();
+	printf("%ld vertices, %ld edges\n", g.size(), g.edges());
+
+	FILE* numeric = tmpfile();
+	FILE* symbolic = tmpfile();
+	for (long i = 0; i < edges.size(); i += 2) {
+		fprintf(numeric, "%ld %ld\n", static_cast<long>(edges[i]), static_cast<long>(edges[i+1]));
+		fprintf(symbolic, "user_%ld user_%ld %g\n", static_cast<long>(edges[i]), static_cast<long>(edges[i+1]), 0.5);
+	}
+	long numeric_bytes = ftell(numeric);
+	long symbolic_bytes = ftell(symbolic);
+
+	rewind(numeric);
+	clock_t start = clock();
+	Graph g1 = Graph::reader(numeric).edgelist(Undirected, GraphReader::EdgelistReadEngine_mmap);
+	report("edgelist (mmap)", start, numeric_bytes);
+
+	rewind(symbolic);
+	start = clock();
+	igraph_t g2;
+	igraph_read_graph_ncol(&g2, symbolic, NULL, true, true, false);
+	report("ncol (igraph)", start, symbolic_bytes);
+	igraph_destroy(&g2);
+
+	rewind(symbolic);
+	start = clock();
+	VertexNames names;
+	Vector weights;
+	Graph g3 = Graph::reader(symbolic).ncol(names, weights);
+	report("ncol (interned)", start, symbolic_bytes);
+	printf("%ld names, %ld edges\n", names.size(), g3.edges());
+
+	fclose(numeric);
+	fclose(symbolic);
+	return 0;
+}
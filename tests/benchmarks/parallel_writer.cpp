@@ -0,0 +1,76 @@
+/*
+
+parallel_writer.cpp ... Wall-clock time of the text writers against the thread count.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+// Build: g++ -std=gnu++0x -O2 -pthread -I../../ -o parallel_writer parallel_writer.cpp -ligraph
+// Usage: ./parallel_writer [vertex count] [average degree] [max thread count]
+
+#include <igraph/igraph.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/time.h>
+using namespace std;
+using namespace igraph;
+
+static double now() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+static void report(const char* name, unsigned threads, double start, FILE* f) {
+	double seconds = now() - start;
+	double megabytes = ftell(f) / 1048576.0;
+	printf("%-10s %2u threads %8.3f s %10.1f MiB/s\n", name, threads, seconds, seconds > 0 ? megabytes / seconds : 0);
+}
+
+int main (int argc, char* argv[]) {
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+	double degree = argc > 2 ? atof(argv[2]) : 10;
+	unsigned max_threads = argc > 3 ? atoi(argv[3]) : 8;
+
+	Graph g = Graph::erdos_renyi_game(n, degree / n);
+	printf("%ld vertices, %ld edges\n", g.size(), g.edges());
+
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		FILE* f = tmpfile();
+		double start = now();
+		g.writer(f).edgelist(NULL, NULL, threads);
+		fflush(f);
+		report("edgelist", threads, start, f);
+		fclose(f);
+
+		f = tmpfile();
+		start = now();
+		g.writer(f).adjlist(", ", ", ", "\n", threads);
+		fflush(f);
+		report("adjlist", threads, start, f);
+		fclose(f);
+
+		f = tmpfile();
+		start = now();
+		g.writer(f).ncol(NULL, NULL, threads);
+		fflush(f);
+		report("ncol", threads, start, f);
+		fclose(f);
+	}
+
+	return 0;
+}
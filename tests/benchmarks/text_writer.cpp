@@ -0,0 +1,111 @@
+/*
+
+text_writer.cpp ... Throughput of the buffered text writers against fprintf.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+// Build: g++ -std=gnu++0x -O2 -pthread -I../../ -o text_writer text_writer.cpp -ligraph
+// Usage: ./text_writer [vertex count] [average degree]
+
+#include <igraph/igraph.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+using namespace igraph;
+
+static void report(const char* name, clock_t start, FILE* f) {
+	double seconds = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+	double megabytes = ftell(f) / 1048576.0;
+	printf("%-28s %8.3f s %10.1f MiB/s\n", name, seconds, seconds > 0 ? megabytes / seconds : 0);
+}
+
+int main (int argc, char* argv[]) {
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+	double degree = argc > 2 ? atof(argv[2]) : 10;
+	
+	Graph g = Graph::erdos_renyi_game(n, degree / n);
+	Vector edges = g.get_edgelist();
+	Vector scores;
+	scores.reserve(n);
+	for (long i = 0; i < n; ++ i)
+		scores.push_back(static_cast<Real>(rand()) / RAND_MAX);
+	printf("%ld vertices, %ld edges\n", g.size(), g.edges());
+	
+	// edge list, as GraphWriter::edgelist(" ", "\n") did before.
+	FILE* f = tmpfile();
+	clock_t start = clock();
+	for (long i = 0; i < edges.size(); i += 2)
+		fprintf(f, "%lg%s%lg%s", edges[i], " ", edges[i+1], "\n");
+	fflush(f);
+	report("edgelist (fprintf)", start, f);
+	fclose(f);
+	
+	f = tmpfile();
+	start = clock();
+	g.writer(f).edgelist(" ", "\n");
+	fflush(f);
+	report("edgelist (OutputBuffer)", start, f);
+	fclose(f);
+	
+	f = tmpfile();
+	start = clock();
+	g.writer(f).adjlist();
+	fflush(f);
+	report("adjlist (OutputBuffer)", start, f);
+	fclose(f);
+	
+	// Vector::print on integral and fractional values.
+	f = tmpfile();
+	start = clock();
+	for (long i = 0; i < edges.size(); ++ i) {
+		if (i != 0)
+			fprintf(f, " ");
+		XXINTRNL_fprintf(f, edges[i]);
+	}
+	fflush(f);
+	report("Vector ids (fprintf)", start, f);
+	fclose(f);
+	
+	f = tmpfile();
+	start = clock();
+	edges.print(" ", f);
+	fflush(f);
+	report("Vector ids (OutputBuffer)", start, f);
+	fclose(f);
+	
+	f = tmpfile();
+	start = clock();
+	for (long i = 0; i < scores.size(); ++ i) {
+		if (i != 0)
+			fprintf(f, " ");
+		XXINTRNL_fprintf(f, scores[i]);
+	}
+	fflush(f);
+	report("Vector reals (fprintf)", start, f);
+	fclose(f);
+	
+	f = tmpfile();
+	start = clock();
+	scores.print(" ", f);
+	fflush(f);
+	report("Vector reals (OutputBuffer)", start, f);
+	fclose(f);
+	
+	return 0;
+}
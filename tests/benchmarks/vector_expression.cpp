@@ -0,0 +1,64 @@
+/*
+
+vector_expression.cpp ... Speed of fused lazy vector arithmetic against the immediate operators.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+
+// Build: g++ -std=gnu++0x -O2 -I../../ -o vector_expression vector_expression.cpp -ligraph
+// Usage: ./vector_expression [size] [iterations]
+//
+// Evaluates v = a * 0.85 + b - c repeatedly, as in the post-processing of
+// PageRank scores, with the immediate operators and with lazy().
+
+#include <igraph/igraph.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+using namespace igraph;
+
+static double seconds_since(clock_t start) {
+	return static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main (int argc, char* argv[]) {
+	long n = argc > 1 ? atol(argv[1]) : 1000000;
+	long iterations = argc > 2 ? atol(argv[2]) : 100;
+	
+	Vector a (n), b (n), c (n);
+	for (long i = 0; i < n; ++ i) {
+		a[i] = rand() % 1000;
+		b[i] = rand() % 1000;
+		c[i] = rand() % 1000;
+	}
+	
+	Vector v = Vector::n();
+	clock_t start = clock();
+	for (long i = 0; i < iterations; ++ i)
+		v = a * 0.85 + b - c;
+	printf("immediate  %8.3f s   (%lg)\n", seconds_since(start), v.sum());
+	
+	Vector w = Vector::n();
+	start = clock();
+	for (long i = 0; i < iterations; ++ i)
+		w = lazy(a) * 0.85 + b - c;
+	printf("lazy       %8.3f s   (%lg)\n", seconds_since(start), w.sum());
+	
+	return v == w ? 0 : 1;
+}
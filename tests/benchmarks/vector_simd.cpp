@@ -0,0 +1,112 @@
+/*
+
+vector_simd.cpp ... Speed of the vectorized BasicVector kernels against the igraph loops.
+
+Copyright (C) 2009  KennyTM~
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+// Build: g++ -std=gnu++0x -O2 -I../../ -o vector_simd vector_simd.cpp -ligraph
+// Usage: ./vector_simd [largest size]
+//
+// For sizes from 1K to 100M elements (two vectors of 100M doubles take
+// 1.6 GB), prints the nanoseconds per element of each BasicVector operation
+// and of the igraph function it used to forward to. Each operation is
+// repeated until about 10^8 elements have been processed.
+
+#include <igraph/igraph.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+using namespace igraph;
+
+static double sink = 0;
+
+static long repeats_for(long n) {
+	return n >= 100000000 ? 1 : 100000000 / n;
+}
+
+#define TIME(label, statement) { \
+	long repeats = repeats_for(n); \
+	clock_t start = clock(); \
+	for (long r = 0; r < repeats; ++ r) { statement; } \
+	printf(" %9.3f", 1e9 * (clock() - start) / CLOCKS_PER_SEC / (static_cast<double>(repeats) * n)); \
+}
+
+template <typename T>
+static void fill_random(BasicVector<T>& v) {
+	for (long i = 0; i < v.size(); ++ i)
+		v[i] = static_cast<T>(rand() % 1000 + 1);
+}
+
+static void run_real(long n) {
+	Vector a (n), b (n);
+	fill_random(a);
+	fill_random(b);
+	// igraph's own copies of the same data.
+	igraph_vector_t ra, rb, *raw_a = &ra, *raw_b = &rb;
+	igraph_vector_init_copy(raw_a, a.begin(), n);
+	igraph_vector_init_copy(raw_b, b.begin(), n);
+	Real min, max;
+	long which_min, which_max;
+
+	printf("Real %10ld", n);
+	TIME("+= k", a += 1.0);              TIME("igraph", igraph_vector_add_constant(raw_a, 1.0));
+	TIME("*= k", a *= 1.0);              TIME("igraph", igraph_vector_scale(raw_a, 1.0));
+	TIME("+= v", a += b);                TIME("igraph", igraph_vector_add(raw_a, raw_b));
+	TIME("*= v", a *= b; a /= b);        TIME("igraph", igraph_vector_mul(raw_a, raw_b); igraph_vector_div(raw_a, raw_b));
+	TIME("sum", sink += a.sum());        TIME("igraph", sink += igraph_vector_sum(raw_a));
+	TIME("prod", sink += b.prod());      TIME("igraph", sink += igraph_vector_prod(raw_b));
+	TIME("minmax", a.minmax(min, max));  TIME("igraph", igraph_vector_minmax(raw_a, &min, &max));
+	TIME("which", a.which_minmax(which_min, which_max)); TIME("igraph", igraph_vector_which_minmax(raw_a, &which_min, &which_max));
+	TIME("maxdiff", sink += a.maxdifference(b));         TIME("igraph", sink += igraph_vector_maxdifference(raw_a, raw_b));
+	TIME("interval", sink += a.isininterval(0, 1e300));  TIME("igraph", sink += igraph_vector_isininterval(raw_a, 0, 1e300));
+	printf("\n");
+	igraph_vector_destroy(raw_a);
+	igraph_vector_destroy(raw_b);
+}
+
+static void run_long(long n) {
+	BasicVector<long> a (n), b (n);
+	fill_random(a);
+	fill_random(b);
+	igraph_vector_long_t ra, rb, *raw_a = &ra, *raw_b = &rb;
+	igraph_vector_long_init_copy(raw_a, a.begin(), n);
+	igraph_vector_long_init_copy(raw_b, b.begin(), n);
+	long min, max;
+
+	printf("long %10ld", n);
+	TIME("+= k", a += 1);                TIME("igraph", igraph_vector_long_add_constant(raw_a, 1));
+	TIME("+= v", a += b; a -= b);        TIME("igraph", igraph_vector_long_add(raw_a, raw_b); igraph_vector_long_sub(raw_a, raw_b));
+	TIME("sum", sink += a.sum());        TIME("igraph", sink += igraph_vector_long_sum(raw_a));
+	TIME("minmax", a.minmax(min, max));  TIME("igraph", igraph_vector_long_minmax(raw_a, &min, &max));
+	printf("\n");
+	igraph_vector_long_destroy(raw_a);
+	igraph_vector_long_destroy(raw_b);
+}
+
+int main (int argc, char* argv[]) {
+	long largest = argc > 1 ? atol(argv[1]) : 100000000;
+	printf("ns per element, BasicVector then igraph\n");
+	printf("Real   size     += k    igraph     *= k    igraph     += v    igraph  *=,/= v    igraph      sum    igraph     prod    igraph   minmax    igraph    which    igraph  maxdiff    igraph interval    igraph\n");
+	for (long n = 1000; n <= largest; n *= 10)
+		run_real(n);
+	printf("long   size     += k    igraph  +=,-= v    igraph      sum    igraph   minmax    igraph\n");
+	for (long n = 1000; n <= largest; n *= 10)
+		run_long(n);
+	return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,534 @@
+#undef NDEBUG
+
+#include <cassert>
+#include <cstdio>
+#include <cmath>
+#include <igraph/igraph.hpp>
+
+using namespace std;
+using namespace igraph;
+
+/// The graph shared by the tests below: multi-edges 0-1 and 2-3, a self-loop at 1, and an isolated vertex 5.
+static Graph fixture(const Directedness directedness = Undirected) {
+	return Graph::create(VertexVector("0 1 1 1 1 0 2 3 3 2 0 1 4 0"), 6, directedness);
+}
+
+/// Check that the snapshot lists the same neighbors and edges as the graph.
+static void check_snapshot(const Graph& g) {
+	CsrGraph csr = g.freeze();
+	assert(csr.size() == g.size());
+	assert(csr.edges() == g.edges());
+	assert(csr.is_directed() == g.is_directed());
+	
+	NeighboringMode out_mode = g.is_directed() ? OutNeighbors : AllNeighbors;
+	NeighboringMode in_mode = g.is_directed() ? InNeighbors : AllNeighbors;
+	for (long v = 0; v < g.size(); ++ v) {
+		VertexVector out = g.neighbors(v, out_mode), in = g.neighbors(v, in_mode);
+		CsrGraph::Range out_csr = csr.out_neighbors(v), in_csr = csr.in_neighbors(v);
+		assert(out_csr.size() == out.size() && csr.out_degree(v) == out.size());
+		assert(in_csr.size() == in.size() && csr.in_degree(v) == in.size());
+		for (long i = 0; i < out.size(); ++ i)
+			assert(out_csr[i] == out[i]);
+		for (long i = 0; i < in.size(); ++ i)
+			assert(in_csr[i] == in[i]);
+		
+		NeighborView out_view = g.neighbor_view(v, out_mode), in_view = g.neighbor_view(v, in_mode);
+		IncidentEdgeView out_edge_view = g.incident_edge_view(v, out_mode);
+		assert(out_view.size() == out.size() && in_view.size() == in.size() && out_edge_view.size() == out.size());
+		long i = 0;
+		for (NeighborView::iterator it = out_view.begin(); it != out_view.end(); ++ it, ++ i)
+			assert(*it == out[i] && out_view[i] == out[i]);
+		assert(i == out.size());
+		i = 0;
+		for (NeighborView::iterator it = in_view.begin(); it != in_view.end(); ++ it, ++ i)
+			assert(*it == in[i]);
+		assert(i == in.size());
+		i = 0;
+		for (IncidentEdgeView::iterator it = out_edge_view.begin(); it != out_edge_view.end(); ++ it, ++ i)
+			assert(*it == csr.out_edges(v)[i]);
+		assert(g.degree_of(v, out_mode) == out.size() && g.degree_of(v, in_mode) == in.size());
+		assert(g.degree_of(v, AllNeighbors, NoSelfLoops) == g.degree(VertexSelector::single(v), AllNeighbors, NoSelfLoops)[0]);
+		
+		CsrGraph::Range out_edges = csr.out_edges(v);
+		for (long i = 0; i < out_edges.size(); ++ i) {
+			Vertex from, to;
+			g.edge(out_edges[i], from, to);
+			assert(from == v ? to == out_csr[i] : (!g.is_directed() && to == v && from == out_csr[i]));
+		}
+	}
+	
+	assert(csr.graph().get_edgelist() == g.get_edgelist());
+}
+
+static void check_flat_adjlist(const Graph& g, NeighboringMode mode) {
+	FlatAdjacencyList flat (g, mode);
+	AdjacencyList lst (g, mode);
+	assert(flat.size() == lst.size());
+	for (long v = 0; v < g.size(); ++ v)
+		assert(flat[v] == lst[v] && flat.degree(v) == lst[v].size());
+	
+	FlatAdjacencyList flat_complement = FlatAdjacencyList::complementer(g, mode);
+	AdjacencyList complement = AdjacencyList::complementer(g, mode);
+	for (long v = 0; v < g.size(); ++ v)
+		assert(flat_complement[v] == complement[v]);
+	
+	flat.simplify();
+	lst.simplify();
+	for (long v = 0; v < g.size(); ++ v)
+		assert(flat[v] == lst[v]);
+}
+
+static void check_id_vectors(const Graph& g) {
+	IdVector32 ids;
+	NeighboringMode modes[] = {OutNeighbors, InNeighbors, AllNeighbors};
+	for (int m = 0; m < 3; ++ m)
+		for (long v = 0; v < g.size(); ++ v) {
+			g.neighbors(v, ids, modes[m]);
+			assert(IdVector32(g.neighbors(v, modes[m])) == ids);
+			g.adjacent(v, ids, modes[m]);
+			assert(IdVector32(g.adjacent(v, modes[m])) == ids);
+			g.subcomponent(v, ids, modes[m]);
+			assert(IdVector32(g.subcomponent(v, modes[m])) == ids);
+		}
+	
+	IdVector64 edges;
+	g.get_edgelist(edges);
+	assert(edges.as_vector() == g.get_edgelist());
+	g.get_edgelist(edges, Graph::EdgelistSequenceOrdering_ByColumns);
+	assert(edges.as_vector() == g.get_edgelist(Graph::EdgelistSequenceOrdering_ByColumns));
+	
+	g.get_edgelist(edges);
+	Graph h = Graph::create(edges, g.size(), g.is_directed() ? Directed : Undirected);
+	assert(h.size() == g.size() && h.get_edgelist() == g.get_edgelist());
+}
+
+static void check_compressed(const Graph& g) {
+	NeighboringMode modes[] = {OutNeighbors, InNeighbors, AllNeighbors};
+	IdVector32 ids;
+	for (int m = 0; m < 3; ++ m) {
+		CompressedGraph cg (g, modes[m]);
+		assert(cg.size() == g.size() && cg.edges() == g.edges());
+		for (long v = 0; v < g.size(); ++ v) {
+			IdVector32 expected (g.neighbors(v, cg.lists()));
+			cg.neighbors(v, ids);
+			assert(ids == expected && cg.degree(v) == expected.size());
+			long i = 0;
+			CompressedGraph::Range nei = cg.neighbors(v);
+			for (CompressedGraph::iterator it = nei.begin(); it != nei.end(); ++ it, ++ i)
+				assert(*it == expected[i]);
+			assert(i == nei.size());
+		}
+		
+		IdVector32 membership, csize;
+		Vector expected_membership, expected_csize;
+		g.cluster(expected_membership, expected_csize);
+		assert(cg.cluster(membership, csize) == expected_csize.size());
+		assert(membership == IdVector32(expected_membership) && csize == IdVector32(expected_csize));
+		
+		IdVector64 distance;
+		cg.bfs_distances(0, distance);
+		assert(distance == IdVector64(GraphView(g).bfs_distances(0, cg.lists())));
+	}
+}
+
+static void check_streamed(const Graph& g, const long batch_size, const long chunk_size) {
+	IdVector32 edges;
+	g.get_edgelist(edges);
+	FILE* f = tmpfile();
+	// back to front, so the first chunks cover more vertices than the later ones.
+	for (long i = edges.size() / 2 - 1; i >= 0; -- i)
+		fprintf(f, "%ld %ld\n", static_cast<long>(edges[2*i]), static_cast<long>(edges[2*i+1]));
+	NeighboringMode modes[] = {OutNeighbors, InNeighbors, AllNeighbors};
+	IdVector32 a, b;
+	for (int m = 0; m < 3; ++ m) {
+		rewind(f);
+		EdgeStream stream (f, batch_size);
+		CompressedGraph streamed (stream, g.is_directed(), modes[m], chunk_size);
+		CompressedGraph direct (g, modes[m]);
+		assert(streamed.size() == g.size() && streamed.edges() == g.edges() && streamed.lists() == direct.lists());
+		for (long v = 0; v < g.size(); ++ v) {
+			streamed.neighbors(v, a);
+			direct.neighbors(v, b);
+			assert(a == b && streamed.degree(v) == direct.degree(v));
+		}
+	}
+	fclose(f);
+}
+
+static void check_sparse(const Graph& g) {
+	Graph::GetAdjacency types[] = {Graph::GetAdjacency_Upper, Graph::GetAdjacency_Lower, Graph::GetAdjacency_Both};
+	for (int t = 0; t < 3; ++ t)
+		assert(g.get_adjacency_sparse(types[t]).to_dense() == g.get_adjacency(types[t]));
+	assert(g.laplacian_sparse().to_dense() == g.laplacian());
+	assert(g.laplacian_sparse(true).to_dense() == g.laplacian(true));
+	
+	VertexSelector all = VertexSelector::all();
+	assert(g.bibcoupling_sparse(all).to_dense() == g.bibcoupling(all));
+	assert(g.cocitation_sparse(all).to_dense() == g.cocitation(all));
+	
+	NeighboringMode modes[] = {OutNeighbors, InNeighbors, AllNeighbors};
+	SelfLoops loops[] = {NoSelfLoops, ContainSelfLoops};
+	for (int m = 0; m < 3; ++ m)
+		for (int l = 0; l < 2; ++ l) {
+			assert(g.similarity_jaccard_sparse(all, modes[m], loops[l]).to_dense() == g.similarity_jaccard(all, modes[m], loops[l]));
+			assert(g.similarity_dice_sparse(all, modes[m], loops[l]).to_dense() == g.similarity_dice(all, modes[m], loops[l]));
+		}
+	
+	// a NaN vertex ID passes igraph's range check, but not the sparse versions'.
+	VertexVector with_nan ("0 1");
+	with_nan[1] = NAN;
+	VertexSelector bad = VertexSelector::vector(with_nan, ::tempobj::OwnershipTransferCopy);
+	bool rejected = false;
+	try {
+		g.bibcoupling_sparse(bad);
+	} catch (const igraph::Exception&) {
+		rejected = true;
+	}
+	assert(rejected);
+	rejected = false;
+	try {
+		g.similarity_jaccard_sparse(bad, AllNeighbors, NoSelfLoops);
+	} catch (const igraph::Exception&) {
+		rejected = true;
+	}
+	assert(rejected);
+}
+
+int main () {
+	check_snapshot(Graph::ring(7));
+	check_snapshot(Graph::ring(7, Directed));
+	check_snapshot(Graph::star(6));
+	check_snapshot(Graph::full(5, Directed));
+	check_snapshot(Graph::empty(3));
+	check_snapshot(Graph::create(VertexVector("0 1 1 1 1 0 2 3 3 2 0 1"), 5));
+	check_snapshot(Graph::create(VertexVector("0 1 1 1 1 0 2 3 3 2 0 1"), 5, Directed));
+	
+	{
+		Graph g = Graph::ring(5);
+		CsrGraph csr = g.freeze();
+		g.add_edge(0, 2);
+		assert(csr.edges() == 5 && csr.out_degree(0) == 2);
+		assert(csr.graph().get_edgelist() == Graph::ring(5).get_edgelist());
+	}
+	
+	{
+		// edges of the ring: 0:(0,1) 1:(1,2) 2:(2,3) 3:(3,4) 4:(4,5) 5:(5,0)
+		Graph g = Graph::ring(6, Directed);
+		GraphBatch batch = g.begin_batch();
+		batch.delete_edge(1).delete_edge(4, 5).delete_edge(1);
+		batch.add_edge(0, 3).add_edges(VertexVector("5 2 1 1"));
+		assert(batch.pending_deletions() == 2 && batch.pending_additions() == 3);
+		assert(g.edges() == 6);
+		
+		Edge first_added = batch.commit();
+		assert(first_added == 4 && g.edges() == 7);
+		assert(batch.pending_deletions() == 0 && batch.pending_additions() == 0);
+		assert(g.get_edgelist() == Vector("0 1 2 3 3 4 5 0 0 3 5 2 1 1"));
+		
+		batch.delete_edge(first_added).commit();
+		assert(g.get_edgelist() == Vector("0 1 2 3 3 4 5 0 5 2 1 1"));
+	}
+	
+	{
+		// parallel edges are deleted one at a time, in either endpoint order for undirected graphs.
+		Graph g = Graph::create(VertexVector("0 1 1 0 1 2 0 1"), 3);
+		GraphBatch batch = g.begin_batch();
+		batch.delete_edge(0, 1).delete_edge(1, 0);
+		assert(batch.pending_deletions() == 2);
+		batch.commit();
+		assert(g.edges() == 2 && g.get_eid(1, 2) == 0 && g.get_eid(0, 1) == 1);
+		
+		batch.add_edge(2, 2).discard().commit();
+		assert(g.edges() == 2);
+	}
+	
+	{
+		// a change behind the batch makes its IDs stale.
+		Graph g = Graph::ring(4);
+		GraphBatch batch = g.begin_batch();
+		batch.delete_edge(0);
+		g.add_edge(1, 3);
+		bool rejected = false;
+		try {
+			batch.commit();
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected && g.edges() == 5 && batch.pending_deletions() == 1);
+		
+		// so does a change which keeps the vertex and edge counts.
+		batch.discard().delete_edge(0);
+		g.delete_edge(4).add_edge(0, 2);
+		rejected = false;
+		try {
+			batch.commit();
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected && g.edges() == 5 && batch.pending_deletions() == 1);
+		
+		// a bad pair rejects the whole call.
+		batch.discard();
+		rejected = false;
+		try {
+			batch.add_edges(VertexVector("0 1 2 9"));
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected && batch.pending_additions() == 0);
+	}
+	
+	{
+		Graph g = Graph::ring(40).connect_neighborhood(3);
+		Vector degrees = g.degree();
+		g.rewire_edges_simple(0.5);
+		assert(g.size() == 40 && g.edges() == 120 && g.is_simple());
+		assert(g.degree().sum() == degrees.sum());
+		
+		Graph h = Graph::ring(40, Directed).connect_neighborhood(3);
+		h.rewire_edges_simple(1);
+		assert(h.edges() == 120 && h.is_simple() && h.degree(OutNeighbors) == Vector((long)40).fill(3));
+		
+		// only the targets move, so every out-degree is kept.
+		Graph k = Graph::ring(40, Directed).connect_neighborhood(2);
+		k.add_edge(0, 20).add_edge(0, 21).add_edge(5, 30);
+		Vector out_degrees = k.degree(OutNeighbors);
+		k.rewire_edges_simple(0.7);
+		assert(k.edges() == 83 && k.is_simple() && k.degree(OutNeighbors) == out_degrees);
+	}
+	
+	{
+		Graph g = Graph::create(VertexVector("0 1 2 1 1 2 3 3"), 5);
+		EdgeIndex index (g);
+		assert(index.get_eid(0, 1) == 0 && index.get_eid(1, 0) == 0);
+		assert(index.get_eid(1, 2) == 1 && index.get_eid(3, 3) == 3);
+		assert(index.get_eid(0, 2) == -1 && index.get_eid(4, 0) == -1 && index.get_eid(7, 0) == -1);
+		assert(index.lookup(VertexVector("2 1 0 3 3 3 4")) == EdgeVector("1 -1 3"));
+		
+		assert(!index.is_stale());
+		g.add_edge(0, 4);
+		assert(index.is_stale());
+		index.refresh();
+		assert(!index.is_stale() && index.get_eid(4, 0) == 4);
+		
+		Graph h = Graph::ring(4, Directed);
+		EdgeIndex directed_index (h);
+		assert(directed_index.are_connected(1, 2) && !directed_index.are_connected(2, 1));
+		assert(directed_index.get_eid(2, 1) == 1 && directed_index.get_eid(2, 1, Directed) == -1);
+		assert(directed_index.lookup(VertexVector("3 0 0 3"), Directed) == EdgeVector("3 -1"));
+	}
+	
+	{
+		// a path 0-2-4-1-3, with a self-loop at 4.
+		Graph g = Graph::create(VertexVector("0 2 2 4 4 1 1 3 4 4"), 5);
+		Graph::LocalityOrdering methods[] = {Graph::LocalityOrdering_ReverseCuthillMcKee, Graph::LocalityOrdering_DegreeDescending, Graph::LocalityOrdering_Gorder};
+		for (int i = 0; i < 3; ++ i) {
+			VertexVector permutation = g.locality_ordering(methods[i]);
+			assert(permutation.size() == 5 && permutation.sort() == VertexVector("0 1 2 3 4"));
+		}
+		
+		VertexVector rcm = g.locality_ordering(Graph::LocalityOrdering_ReverseCuthillMcKee);
+		for (long eid = 0; eid < 4; ++ eid) {
+			Vertex from, to;
+			g.edge(eid, from, to);
+			assert(rcm[from] - rcm[to] == 1 || rcm[to] - rcm[from] == 1);
+		}
+		assert(g.locality_ordering(Graph::LocalityOrdering_DegreeDescending)[4] == 0);
+		
+		Graph h = g;
+		VertexVector old_ids = h.reorder_for_locality(Graph::LocalityOrdering_Gorder);
+		assert(h.edges() == 5);
+		for (long eid = 0; eid < 5; ++ eid) {
+			Vertex from, to, old_from, old_to;
+			h.edge(eid, from, to);
+			g.edge(eid, old_from, old_to);
+			assert((old_ids[from] == old_from && old_ids[to] == old_to) || (old_ids[from] == old_to && old_ids[to] == old_from));
+		}
+	}
+	
+	{
+		Graph graphs[] = {fixture(), fixture(Directed), Graph::star(5)};
+		for (int i = 0; i < 3; ++ i) {
+			check_flat_adjlist(graphs[i], OutNeighbors);
+			check_flat_adjlist(graphs[i], InNeighbors);
+			check_flat_adjlist(graphs[i], AllNeighbors);
+		}
+		for (int i = 0; i < 3; ++ i)
+			check_id_vectors(graphs[i]);
+		
+		IdVector32 ids (VertexVector("-1 0 2147483647"));
+		IdVector32 copied = ids;
+		assert(copied == ids && copied.size() == 3 && copied[2] == 2147483647);
+		assert(IdVector64(VertexVector("2147483648 -2147483649")).as_vector() == VertexVector("2147483648 -2147483649"));
+		// IDs which do not fit in 32 bits are rejected, not truncated.
+		const char* too_large[] = {"0 2147483648", "-2147483649", "nan"};
+		for (int i = 0; i < 3; ++ i) {
+			bool rejected = false;
+			try {
+				IdVector32 narrowed (VertexVector(too_large[i]));
+			} catch (const igraph::Exception&) {
+				rejected = true;
+			}
+			assert(rejected);
+		}
+		
+		// every undirected edge is in the rows of both its endpoints.
+		Graph rebuilt = Graph::adjlist(FlatAdjacencyList(graphs[0]), Undirected, Graph::ToUndirectedMode_Each);
+		assert(rebuilt.size() == 6 && rebuilt.edges() == 7);
+		assert(rebuilt.degree() == graphs[0].degree());
+		assert(rebuilt.neighbors(1, AllNeighbors) == graphs[0].neighbors(1, AllNeighbors));
+		
+		rebuilt = Graph::adjlist(FlatAdjacencyList(graphs[1]), Directed);
+		assert(rebuilt.is_directed() && rebuilt.edges() == 7);
+		for (long v = 0; v < 6; ++ v)
+			assert(rebuilt.neighbors(v, OutNeighbors) == graphs[1].neighbors(v, OutNeighbors));
+		
+		// directed rows split each edge between its ends; undirected rows list it at both.
+		FlatAdjacencyList out (graphs[1], OutNeighbors), in (graphs[1], InNeighbors), all (graphs[1], AllNeighbors);
+		assert(out.neighbor_count() == 7 && in.neighbor_count() == 7 && all.neighbor_count() == 14);
+		assert(out.degree(4) == 1 && in.degree(4) == 0 && out.degree(0) == 2 && in.degree(0) == 2);
+		FlatAdjacencyList undirected_out (graphs[0], OutNeighbors), undirected_in (graphs[0], InNeighbors);
+		assert(undirected_out.neighbor_count() == 14 && undirected_in.neighbor_count() == 14);
+		for (long v = 0; v < 6; ++ v)
+			assert(undirected_out[v] == undirected_in[v]);
+		assert(out.degree(5) == 0 && in.degree(5) == 0 && undirected_out.degree(5) == 0 && out.begin(5) == out.end(5));
+		
+		// simplifying drops the loop at 1 and the repeated neighbors in place.
+		all.simplify();
+		for (long v = 0; v < 6; ++ v)
+			for (const Vertex* p = all.begin(v); p != all.end(v); ++ p)
+				assert(*p != v && (p == all.begin(v) || p[-1] < *p));
+		assert(all.degree(1) == 1 && all.degree(2) == 1);
+		
+		FlatAdjacencyList nothing (Graph::empty(0));
+		assert(nothing.size() == 0 && nothing.neighbor_count() == 0);
+	}
+	
+	{
+		SharedGraph base (Graph::star(5));
+		SharedGraph copy = base;
+		assert(base.use_count() == 2 && &*copy == &*base);
+		assert(copy->edges() == 4);
+		
+		copy.mutate().add_edge(1, 2);
+		assert(base.unique() && copy.unique());
+		assert(base->edges() == 4 && copy->edges() == 5);
+		
+		Graph& g = copy.mutate();
+		assert(&g == &*copy);
+		
+		SharedGraph from_copy (g);
+		assert(from_copy.unique() && from_copy->get_edgelist() == g.get_edgelist());
+	}
+	
+	{
+		Graph g = fixture();
+		GraphView whole (g);
+		assert(whole.vertex_count() == 6 && whole.edge_count() == 7);
+		assert(whole.degree() == g.degree() && whole.degree(OutNeighbors, NoSelfLoops) == g.degree(OutNeighbors, NoSelfLoops));
+		Vector membership, csize, view_membership, view_csize;
+		g.cluster(membership, csize);
+		whole.cluster(view_membership, view_csize);
+		assert(view_membership == membership && view_csize == csize);
+		
+		BoolVector vertices (5);
+		vertices.fill(true);
+		vertices[0] = false;
+		Graph star = Graph::star(5);
+		GraphView leaves = GraphView(star).set_vertex_mask(vertices);
+		assert(leaves.vertex_count() == 4 && leaves.edge_count() == 0);
+		assert(leaves.cluster_count() == 4 && !leaves.is_connected());
+		assert(leaves.bfs_distances(1) == Vector("-1 0 -1 -1 -1"));
+		assert(leaves.degree_of(1) == 0 && leaves.neighbors(0).size() == 0);
+		
+		Graph ring = Graph::ring(5, Directed);
+		BoolVector edges (5);
+		edges.fill(true);
+		edges[0] = false;
+		GraphView cut (ring);
+		assert(cut.cluster_count(Graph::StronglyConnected) == 1);
+		cut.set_edge_mask(edges);
+		assert(cut.cluster_count(Graph::StronglyConnected) == 5 && cut.is_connected());
+		assert(cut.bfs_distances(0) == Vector("0 -1 -1 -1 -1"));
+		assert(cut.bfs_distances(0, AllNeighbors) == Vector("0 4 3 2 1"));
+		assert(cut.adjacent(0, AllNeighbors) == EdgeVector("4"));
+		
+		// edges of the fixture: 0:(0,1) 1:(1,1) 2:(1,0) 3:(2,3) 4:(3,2) 5:(0,1) 6:(4,0).
+		// hiding a vertex hides its edges too.
+		BoolVector no_zero (6);
+		no_zero.fill(true);
+		no_zero[0] = false;
+		GraphView without_zero = GraphView(g).set_vertex_mask(no_zero);
+		assert(without_zero.vertex_count() == 5 && without_zero.edge_count() == 3);
+		assert(!without_zero.has_edge(0) && without_zero.has_edge(1) && !without_zero.has_edge(6));
+		assert(without_zero.degree() == Vector("0 2 2 2 0 0"));
+		without_zero.cluster(view_membership, view_csize);
+		assert(view_membership == Vector("-1 0 1 1 2 3") && view_csize == Vector("1 2 1 1"));
+		
+		// an edge can be hidden while both its ends stay.
+		BoolVector no_pair (7);
+		no_pair.fill(true);
+		no_pair[3] = false;
+		GraphView one_pair = GraphView(g).set_edge_mask(no_pair);
+		assert(one_pair.has_vertex(2) && one_pair.has_vertex(3) && !one_pair.has_edge(3));
+		assert(one_pair.neighbors(2, AllNeighbors) == VertexVector("3") && one_pair.adjacent(2, AllNeighbors) == EdgeVector("4"));
+		assert(one_pair.cluster_count() == 3);
+		no_pair[4] = false;
+		one_pair.set_edge_mask(no_pair);
+		assert(one_pair.vertex_count() == 6 && one_pair.edge_count() == 5);
+		assert(one_pair.degree_of(2, AllNeighbors) == 0 && one_pair.cluster_count() == 4);
+		assert(one_pair.bfs_distances(2, AllNeighbors) == Vector("-1 -1 0 -1 -1 -1"));
+		
+		// two directed cycles 0-1-2 and 2-3-4 through vertex 2; hiding 3->4 breaks the second.
+		Graph cycles = Graph::create(VertexVector("0 1 1 2 2 0 2 3 3 4 4 2"), 5, Directed);
+		BoolVector no_34 (6);
+		no_34.fill(true);
+		no_34[4] = false;
+		GraphView broken = GraphView(cycles);
+		assert(broken.cluster_count(Graph::StronglyConnected) == 1);
+		broken.set_edge_mask(no_34);
+		assert(broken.cluster_count(Graph::StronglyConnected) == 3 && broken.is_connected());
+		assert(!broken.is_connected(Graph::StronglyConnected));
+		broken.cluster(view_membership, view_csize, Graph::StronglyConnected);
+		assert(view_membership[0] == view_membership[1] && view_membership[1] == view_membership[2]);
+		assert(view_membership[3] != view_membership[0] && view_membership[4] != view_membership[0] && view_membership[3] != view_membership[4]);
+		assert(view_csize.sort() == Vector("1 1 3"));
+		assert(broken.bfs_distances(0) == Vector("0 1 2 3 -1"));
+	}
+	
+	{
+		Graph graphs[] = {fixture(), fixture(Directed), Graph::star(5), Graph::ring(300)};
+		for (int i = 0; i < 4; ++ i)
+			check_compressed(graphs[i]);
+		for (int i = 0; i < 4; ++ i)
+			check_sparse(graphs[i]);
+		
+		// two edges per batch and per chunk, so that the chunks are merged.
+		FILE* f = tmpfile();
+		fputs("0 1\n1 1\n1 0\n2 3\n3 2\n0 1\n4 0\n", f);
+		rewind(f);
+		EdgeStream stream (f, 2);
+		CompressedGraph streamed (stream, Directed, AllNeighbors, 2);
+		CompressedGraph direct (graphs[1], AllNeighbors);
+		assert(streamed.size() == 5 && streamed.edges() == 7);
+		IdVector32 a, b;
+		for (long v = 0; v < 5; ++ v) {
+			streamed.neighbors(v, a);
+			direct.neighbors(v, b);
+			assert(a == b);
+		}
+		fclose(f);
+		
+		// many chunks of uneven vertex ranges, a chunk larger than the batch, and one chunk for everything.
+		Graph ring = Graph::ring(300, Directed);
+		check_streamed(ring, 7, 10);
+		check_streamed(ring, 16, 50);
+		check_streamed(ring, 64, 1 << 20);
+		check_streamed(graphs[3], 3, 5);
+		check_streamed(graphs[2], 1, 1);
+	}
+	
+	printf("graph.hpp is correct.\n");
+	
+	return 0;
+}
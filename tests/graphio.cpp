@@ -0,0 +1,293 @@
+#undef NDEBUG
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <igraph/igraph.hpp>
+
+using namespace std;
+using namespace igraph;
+
+static FILE* make_file(const char* content) {
+	FILE* f = tmpfile();
+	fputs(content, f);
+	rewind(f);
+	return f;
+}
+
+static string file_content(FILE* f) {
+	string content;
+	rewind(f);
+	char block[4096];
+	size_t count;
+	while ((count = fread(block, 1, sizeof(block), f)) != 0)
+		content.append(block, count);
+	fclose(f);
+	return content;
+}
+
+static void check_parallel_writer(const Graph& g, unsigned threads) {
+	FILE* f1 = tmpfile();
+	FILE* f2 = tmpfile();
+	g.writer(f1).edgelist(NULL, NULL, 1);
+	g.writer(f2).edgelist(NULL, NULL, threads);
+	string single = file_content(f1);
+	assert(single == file_content(f2));
+	
+	// the default output is igraph's, even on one thread.
+	f1 = tmpfile();
+	igraph_write_graph_edgelist(g.get(), f1);
+	assert(file_content(f1) == single);
+	f1 = tmpfile();
+	igraph_write_graph_ncol(g.get(), f1, NULL, NULL);
+	assert(file_content(f1) == single);
+	
+	f1 = tmpfile();
+	f2 = tmpfile();
+	g.writer(f1).adjlist(": ", ", ", "\n", 1);
+	g.writer(f2).adjlist(": ", ", ", "\n", threads);
+	assert(file_content(f1) == file_content(f2));
+	
+	f1 = tmpfile();
+	f2 = tmpfile();
+	g.writer(f1).ncol(NULL, NULL, 1);
+	g.writer(f2).ncol(NULL, NULL, threads);
+	assert(file_content(f1) == file_content(f2));
+}
+
+static void check_edgelist_engines(const char* content, Directedness directedness) {
+	FILE* f1 = make_file(content);
+	FILE* f2 = make_file(content);
+	Graph g1 = Graph::reader(f1).edgelist(directedness, GraphReader::EdgelistReadEngine_igraphhpp);
+	Graph g2 = Graph::reader(f2).edgelist(directedness, GraphReader::EdgelistReadEngine_mmap);
+	assert(g1.vcount() == g2.vcount());
+	assert(g1.is_directed() == g2.is_directed());
+	assert(g1.get_edgelist() == g2.get_edgelist());
+	fclose(f1);
+	fclose(f2);
+	
+	for (unsigned threads = 1; threads <= 5; ++ threads) {
+		FILE* f3 = make_file(content);
+		Graph g3 = Graph::reader(f3).edgelist(directedness, GraphReader::EdgelistReadEngine_parallel, threads);
+		assert(g1.vcount() == g3.vcount());
+		assert(g1.get_edgelist() == g3.get_edgelist());
+		fclose(f3);
+	}
+}
+
+int main () {
+// edgelist read engines
+	check_edgelist_engines("0 1\n1 2\n2 3\n3 0\n", Undirected);
+	check_edgelist_engines("0\t1\r\n1 2\r\n\r\n5 4", Directed);
+	check_edgelist_engines("0 1, 1 2; 2 3 ; 7", Directed);
+	check_edgelist_engines("", Undirected);
+	check_edgelist_engines("10 11\n12\n13 14 15\n\n\n16 17\n18 19\n20\n21 22 23 24\n25\n", Directed);
+	
+	FILE* f = make_file("0 1\n1 2\n2 0\n9 3\n");
+	Graph g = Graph::reader(f).edgelist(Directed, GraphReader::EdgelistReadEngine_mmap);
+	assert(g.vcount() == 10);
+	assert(g.ecount() == 4);
+	assert(g.get_edgelist() == Vector("0 1 1 2 2 0 9 3"));
+	fclose(f);
+	
+// adjacency list
+	f = make_file("0 1 2\n1 0\n2 0 2\n0 3\n4\n");
+	Graph adj = Graph::reader(f).adjlist(Directed);
+	assert(adj.vcount() == 5);
+	assert(adj.get_edgelist() == Vector("0 1 0 2 0 3 1 0 2 0 2 2"));
+	fclose(f);
+	
+	f = make_file("0 1 2\n1 0\n2 0 2\n0 3\n4\n");
+	adj = Graph::reader(f).adjlist(Undirected, EdgeMultiplicity_Multiple);
+	assert(adj.vcount() == 5);
+	assert(adj.get_edgelist() == Graph::create(VertexVector("0 1 0 2 0 3"), 5).get_edgelist());
+	fclose(f);
+	
+	// self-loops come after the other neighbors; listed at both ends they count once.
+	f = make_file("0 0 1\n");
+	adj = Graph::reader(f).adjlist(Directed);
+	assert(adj.get_edgelist() == Vector("0 1 0 0"));
+	fclose(f);
+	
+	f = make_file("1 1 1 1 0\n0 1\n");
+	adj = Graph::reader(f).adjlist(Undirected, EdgeMultiplicity_Multiple);
+	assert(adj.get_edgelist() == Graph::create(VertexVector("0 1 1 1"), 2).get_edgelist());
+	fclose(f);
+	
+	f = make_file("2 0; 0 1, 2;1 0");
+	adj = Graph::reader(f).adjlist(Directed, EdgeMultiplicity_Simple, ";");
+	assert(adj.get_edgelist() == Vector("0 1 0 2 1 0 2 0"));
+	fclose(f);
+	
+// parallel writers
+	Graph big_ring = Graph::ring(200000, Directed);
+	big_ring.add_edge(5, 5).add_edge(199999, 3);
+	check_parallel_writer(big_ring, 3);
+	check_parallel_writer(big_ring, 0);
+	check_parallel_writer(Graph::star(7), 4);
+	check_parallel_writer(Graph::empty(0), 4);
+	
+// binary format
+	Graph ring = Graph::ring(7, Directed);
+	ring.add_edge(3, 3);
+	for (int width = 0; width < 2; ++ width) {
+		FILE* bf = tmpfile();
+		ring.writer(bf).binary(width ? GraphWriter::BinaryIndexWidth_32 : GraphWriter::BinaryIndexWidth_Native);
+		rewind(bf);
+		Graph loaded = Graph::reader(bf).binary();
+		assert(loaded.vcount() == 7);
+		assert(loaded.is_directed() == Directed);
+		assert(loaded.get_edgelist() == ring.get_edgelist());
+		fclose(bf);
+	}
+	
+	{
+		// a header claiming fewer vertices than the edges use.
+		FILE* bf = tmpfile();
+		ring.writer(bf).binary();
+		fseek(bf, 8, SEEK_SET);
+		fputc(3, bf);
+		rewind(bf);
+		bool rejected = false;
+		try {
+			Graph::reader(bf).binary();
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected);
+		fclose(bf);
+	}
+	
+	assert(identify_file_format("graphio_test.igb") == GraphFormat_binary);
+	assert(Graph::star(5).write("graphio_test.igb"));
+	Graph star = Graph::read("graphio_test.igb");
+	assert(star.vcount() == 5 && star.ecount() == 4 && star.is_directed() == Undirected);
+	assert(star.get_edgelist() == Graph::star(5).get_edgelist());
+	remove("graphio_test.igb");
+	
+// compressed files
+	assert(identify_file_compression("graphio_test.edges.gz") == FileCompression_gzip);
+	assert(identify_file_compression("graphio_test.igb.zst") == FileCompression_zstd);
+	assert(identify_file_compression("graphio_test.edges") == FileCompression_none);
+	assert(identify_file_format("graphio_test.edges.gz") == GraphFormat_edgelist);
+	assert(identify_file_format("graphio_test.igb.zst") == GraphFormat_binary);
+	
+#if IGRAPH_CPP_WITH_ZLIB && IGRAPH_CPP_WITH_ZSTD
+	ring.writer("graphio_test.edges.gz").edgelist(" ", "\n");	// in edge ID order.
+	Graph unzipped = Graph::reader("graphio_test.edges.gz").edgelist(Directed, GraphReader::EdgelistReadEngine_mmap);
+	assert(unzipped.get_edgelist() == ring.get_edgelist());
+	remove("graphio_test.edges.gz");
+	
+	assert(Graph::star(5).write("graphio_test.igb.zst"));
+	star = Graph::read("graphio_test.igb.zst");
+	assert(star.get_edgelist() == Graph::star(5).get_edgelist());
+	remove("graphio_test.igb.zst");
+	
+	{
+		GraphWriter writer = big_ring.writer("graphio_test.edges.gz");
+		writer.edgelist(" ", "\n");
+		assert(writer.close());
+		// cut the compressed file in half.
+		string compressed = file_content(fopen("graphio_test.edges.gz", "rb"));
+		FILE* cut = fopen("graphio_test.edges.gz", "wb");
+		fwrite(compressed.data(), 1, compressed.size() / 2, cut);
+		fclose(cut);
+		bool rejected = false;
+		try {
+			Graph::reader("graphio_test.edges.gz").edgelist(Directed, GraphReader::EdgelistReadEngine_mmap);
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected);
+		rejected = false;
+		try {
+			EdgeStream cut_stream ("graphio_test.edges.gz");
+			VertexVector cut_batch;
+			while (cut_stream.next(cut_batch)) { }
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected);
+		remove("graphio_test.edges.gz");
+	}
+	
+	{
+		// more than one compression block, through igraph's own reader and writer.
+		big_ring.writer("graphio_test.edges.zst").edgelist();
+		Graph unpacked = Graph::reader("graphio_test.edges.zst").edgelist(Directed, GraphReader::EdgelistReadEngine_igraph);
+		assert(unpacked.get_edgelist() == big_ring.get_edgelist());
+		remove("graphio_test.edges.zst");
+	}
+#else
+	{
+		bool rejected = false;
+		try {
+			ring.writer("graphio_test.edges.gz");
+		} catch (const igraph::Exception&) {
+			rejected = true;	// IGRAPH_UNIMPLEMENTED without zlib.
+		}
+		assert(rejected);
+	}
+#endif
+	
+// streaming
+	const char* stream_content = "0 1\n1 2\n22 3\n4 4\n5 -6\n3 22\n7";
+	FILE* sf = make_file(stream_content);
+	EdgeStream stream (sf, 2, 3);	// tiny buffer: numbers cross the block boundary.
+	VertexVector batch, all_edges;
+	while (stream.next(batch)) {
+		assert(batch.size() <= 4 && batch.size() % 2 == 0);
+		all_edges.append(batch);
+	}
+	assert(all_edges == VertexVector("0 1 1 2 22 3 4 4 5 -6 3 22"));
+	fclose(sf);
+	
+	sf = make_file(stream_content);
+	EdgeStream stream2 (sf, 3);
+	Graph built = GraphBuilder(Directed).append(stream2).build();
+	assert(built.vcount() == 23 && built.is_directed() == Directed);
+	assert(built.get_edgelist() == Vector("0 1 1 2 22 3 4 4 3 22"));
+	assert(built.degree_of(22, AllNeighbors) == 2);
+	fclose(sf);
+	
+	GraphBuilder builder (Undirected, 30);
+	builder.drop_self_loops().keep_vertex_range(1, 22, true).append(all_edges);
+	assert(builder.ecount() == 3);
+	Graph filtered = builder.build();
+	assert(filtered.vcount() == 30);
+	assert(filtered.get_edgelist() == Graph::create(VertexVector("0 1 21 2 2 21"), 30).get_edgelist());
+	
+// ncol
+	FILE* nf = make_file("alice bob 2.5\nbob carol\n\n  carol\talice 0.5 \r\n \ndave dave 1e1");
+	VertexNames names;
+	names.intern("zoe");
+	Vector weights;
+	Graph named = Graph::reader(nf).ncol(names, weights, Directed);
+	assert(names.size() == 5);
+	assert(named.vcount() == 5 && named.is_directed() == Directed);
+	assert(named.get_edgelist() == Vector("1 2 2 3 3 1 4 4"));
+	assert(weights == Vector("2.5 0 0.5 10"));
+	assert(strcmp(names[3], "carol") == 0);
+	assert(names.find("dave") == 4);
+	fclose(nf);
+	
+	// as igraph, reject a lone name, a fourth field and a weight which is not a number.
+	const char* bad_ncol[] = {"alice bob\nlonely\n", "alice bob 1 extra\n", "alice bob heavy\n", "alice bob 2.5kg\n"};
+	for (unsigned i = 0; i < sizeof(bad_ncol) / sizeof(*bad_ncol); ++ i) {
+		FILE* bf = make_file(bad_ncol[i]);
+		VertexNames bad_names;
+		bool rejected = false;
+		try {
+			Graph::reader(bf).ncol(bad_names);
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected);
+		fclose(bf);
+	}
+	
+	printf("graphio.hpp is correct.\n");
+	
+	return 0;
+}
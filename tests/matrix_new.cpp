@@ -1,5 +1,7 @@
 #include <igraph/igraph.hpp>
 #include <cassert>
+#include <cstdio>
+#include <cmath>
 
 using namespace std;
 using namespace igraph;
@@ -11,6 +13,9 @@ int main () {
 	assert(m == Matrix("1 2 5; 4 6 8"));
 	assert(m == Matrix("1 2 5| 4 6 8|", "|"));
 	assert(m != Matrix("1 2; 5 4 6 8"));
+	assert(Matrix("1 2;; 3;") == Matrix("1 2; 0 0; 3 0"));
+	assert(Matrix("row 1: 1e1 2e1 | row 2: 3e1", "| row") == Matrix("1 10 20; 2 30"));
+	assert(Matrix("").nrow() == 0);
 	m.print();
 	m.print(" # ");
 	m.print(" # ", " @ ");
@@ -89,6 +94,17 @@ int main () {
 	
 // +=, -=, etc.
 	assert(Matrix("6, 7, 2; 44, -4, 6") + 2 * Matrix("2, 2, 5; -1, 4, 3") - 4 - (m+1)/2 == Matrix("2.5, 4.5, 4; 27, 2.5, 5"));
+	{
+		Matrix a ("1 2 3; 4 5 6"), b ("6 5 4; 3 2 1");
+		Matrix x = lazy(a) * 2 - b + 1;
+		assert(x == Matrix("-3 0 3; 6 9 12"));
+		x += lazy(a) * b;
+		assert(x == Matrix("3 10 15; 18 19 18"));
+		x = lazy(x) / 2 - a;
+		assert(x.nrow() == 2 && x.ncol() == 3);
+		assert(x == Matrix("0.5 3 4.5; 5 4.5 3"));
+		assert(!(lazy(a) + Matrix("1 2; 3 4; 5 6")).is_valid());
+	}
 	m.mul_elements(m);
 	assert(m == Matrix("36 16 49; 441 36 25"));
 	m.div_elements(Matrix("1 2 4; -8 -4 -2"));
@@ -160,6 +176,75 @@ int main () {
 	m.resize(8, 9);
 	assert(m.nrow() == 8 && m.ncol() == 9);
 	
+	{
+		Matrix saved ("1 -2.5 3; 4 5 6e50");
+		saved.save("matrix_test.igm");
+		assert(Matrix::load("matrix_test.igm") == saved);
+		MappedFile content ("matrix_test.igm");
+		Matrix mapped = Matrix::view(content);
+		assert(mapped.nrow() == 2 && mapped.ncol() == 3);
+		assert(mapped == saved);
+		remove("matrix_test.igm");
+	}
+	
+	{
+		Matrix dense ("0 2 0; 1 0 3");
+		SparseMatrix a (dense);
+		assert(a.nrow() == 2 && a.ncol() == 3 && a.nonzeros() == 3);
+		assert(a(0, 1) == 2 && a(1, 2) == 3 && a(0, 0) == 0);
+		assert(a.row(1).size() == 2 && a.row(1).column(1) == 2 && a.row(1).value(0) == 1);
+		assert(a.to_dense() == dense);
+		assert(a == SparseMatrix::from_triplets(2, 3, Vector("1 0 1 0 0"), Vector("2 1 0 2 2"), Vector("3 2 1 5 -5")));
+		
+		SparseMatrix t = a.transpose();
+		assert(t.nrow() == 3 && t.ncol() == 2 && t.to_dense() == Matrix("0 1; 2 0; 0 3"));
+		assert(t.transpose() == a);
+		assert(a.rowsum() == Vector("2 4") && a.colsum() == Vector("1 2 3") && a.sum() == 6);
+		
+		assert(a * Vector("1 10 100") == Vector("20 301"));
+		assert(Vector("1 10") * a == Vector("10 2 30"));
+		assert(a * Matrix("1 0; 0 1; 1 1") == Matrix("0 2; 4 3"));
+		assert(Matrix("1 1; 0 2") * a == Matrix("1 2 3; 2 0 6"));
+		a *= 2;
+		assert(a.to_dense() == Matrix("0 4 0; 2 0 6"));
+		assert(SparseMatrix(4, 4).nonzeros() == 0 && SparseMatrix(4, 4).to_dense() == Matrix(4, 4));
+		
+		SparseMatrix copied = a;
+		copied *= 0.5;
+		assert(copied.to_dense() == dense && a.to_dense() == Matrix("0 4 0; 2 0 6"));
+		copied = t;
+		assert(copied == t && copied.nrow() == 3);
+	}
+	
+	{
+		// NaN positions are rejected before they are converted to indices.
+		Vector rows ("0 1"), cols ("1 0"), values ("1 1");
+		rows[1] = NAN;
+		bool rejected = false;
+		try {
+			SparseMatrix::from_triplets(2, 2, rows, cols, values);
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected);
+		
+		// NaN values are not zero, so they are stored, and they survive being added up.
+		values[0] = NAN;
+		SparseMatrix nan_entry = SparseMatrix::from_triplets(2, 2, Vector("0 1"), cols, values);
+		assert(nan_entry.nonzeros() == 2 && nan_entry(0, 1) != nan_entry(0, 1) && nan_entry(1, 0) == 1);
+		Matrix dense_nan ("0 1; 0 0");
+		dense_nan(0, 1) = NAN;
+		assert(SparseMatrix(dense_nan).nonzeros() == 1);
+		
+		// a NaN of x only reaches the rows with an entry in its column.
+		Vector x ("1 1");
+		x[1] = NAN;
+		Vector y = SparseMatrix::from_triplets(2, 2, Vector("0"), Vector("0"), Vector("3")) * x;
+		assert(y[0] == 3 && y[1] == 0);
+		y = nan_entry * Vector("1 1");
+		assert(y[0] != y[0] && y[1] == 1);
+	}
+	
 	printf("matrix.hpp is correct.\n");
 	
 	return 0;
@@ -5,6 +5,8 @@
 #include <vector>
 #include <numeric>
 #include <algorithm>
+#include <cstdio>
+#include <cmath>
 
 using namespace std;
 using namespace igraph;
@@ -19,6 +21,10 @@ int main () {
 	assert(v == v);
 	assert(v == Vector(" 4., 5., 6., 9., 8., 7."));
 	assert(v != Vector(" 3., 4., 5."));
+	assert(Vector("1 birds 2 geese 3 cats 4 dogs") == Vector("1 2 3 4"));
+	assert(Vector("x=-1.5e2, y=+3e-1, z=7e") == Vector("-150 0.3 7"));
+	assert(BasicVector<long>("1.5 -2abc0x3") == BasicVector<long>("1 5 -2 0 3"));
+	assert(Vector("").size() == 0 && Vector("no numbers").size() == 0);
 	assert(v.size() == 6);
 	assert(v.sum() == 4 + 5 + 6 + 9 + 8 + 7);
 	assert(v.prod() == 4 * 5 * 6 * 9 * 8 * 7);
@@ -51,6 +57,35 @@ int main () {
 	}
 	assert(v == Vector("10., 12., 14., 16., 18., 12."));
 	
+	{
+		Vector a ("1 2 3"), b ("10 20 30"), c ("4 4 4");
+		Vector x = lazy(a) * 2 + b - c;
+		assert(x == Vector("8 20 32"));
+		x = 1 - lazy(a) / 2 * -lazy(c);
+		assert(x == Vector("3 5 7"));
+		x = lazy(a) + lazy(b) * lazy(c) + 0.5;
+		assert(x == Vector("41.5 82.5 123.5"));
+		x = a + (lazy(b) - a);
+		assert(x == b);
+		a = lazy(a) * a + a;	// the destination is an operand.
+		assert(a == Vector("2 6 12"));
+		x += lazy(c) * 2;
+		assert(x == Vector("18 28 38"));
+		x -= -lazy(c);
+		x /= lazy(c);
+		assert(x == Vector("5.5 8 10.5"));
+		x *= lazy(c) - 2;
+		assert(x == Vector("11 16 21"));
+		assert(x.size() == 3 && (lazy(x) + c).nrow() == 3);
+		assert(!(lazy(x) + Vector("1 2")).is_valid());
+		Vector y = Vector::n();
+		y = lazy(x) + 1;
+		assert(y == Vector("12 17 22"));
+		BasicVector<long> l ("1 2 3");
+		l = lazy(l) * 3 - 1;
+		assert(l == BasicVector<long>("2 5 8"));
+	}
+	
 	Real temp[] = {2, 3, 5, 7, 11};
 	{
 		Vector w = Vector::view(temp, 5);
@@ -232,6 +267,104 @@ int main () {
 		assert(v.size() == 0);
 	}
 	
+	{
+		// the vectorized minmax around the vector widths, against igraph, with a NaN or -0.0 at each position.
+		const long lengths[] = {7, 8, 15, 16, 17, 33};
+		const Real specials[] = {NAN, -0.0};
+		for (int k = 0; k < 6; ++ k)
+			for (int s = 0; s < 2; ++ s)
+				for (long pos = -1; pos < lengths[k]; ++ pos) {
+					long n = lengths[k];
+					vector<Real> data (n);
+					for (long i = 0; i < n; ++ i)
+						data[i] = (i * 7) % 11;
+					if (pos >= 0)
+						data[pos] = specials[s];
+					Vector x = Vector::view(&data[0], n);
+					igraph_vector_t raw;
+					igraph_vector_view(&raw, &data[0], n);
+					
+					long which_min, which_max, raw_which_min, raw_which_max;
+					x.which_minmax(which_min, which_max);
+					igraph_vector_which_minmax(&raw, &raw_which_min, &raw_which_max);
+					assert(which_min == raw_which_min && which_max == raw_which_max);
+					
+					Real x_min, x_max, raw_min, raw_max;
+					x.minmax(x_min, x_max);
+					igraph_vector_minmax(&raw, &raw_min, &raw_max);
+					assert(x_min == raw_min || (x_min != x_min && raw_min != raw_min));
+					assert(x_max == raw_max || (x_max != x_max && raw_max != raw_max));
+					
+					assert(x.isininterval(0, 10) == static_cast<bool>(igraph_vector_isininterval(&raw, 0, 10)));
+					assert(x.isininterval(1, 10) == static_cast<bool>(igraph_vector_isininterval(&raw, 1, 10)));
+					vector<Real> other (n);
+					for (long i = 0; i < n; ++ i)
+						other[i] = (i * 5) % 13;
+					igraph_vector_t raw_other;
+					igraph_vector_view(&raw_other, &other[0], n);
+					assert(x.maxdifference(Vector::view(&other[0], n)) == igraph_vector_maxdifference(&raw, &raw_other));
+				}
+		
+		// a NaN after a large difference in the same lane, for every vector width.
+		Vector p (16), q (16);
+		p[0] = 100;
+		p[8] = NAN;
+		assert(p.maxdifference(q) == 100 && q.maxdifference(p) == 100);
+		p[0] = NAN;
+		assert(p.isininterval(0, 100) && !p.isininterval(1, 100));
+	}
+	
+	{
+		Vector saved ("1.5 -2 1e100 0 42");
+		saved.save("vector_test.igv");
+		assert(Vector::load("vector_test.igv") == saved);
+		MappedFile content ("vector_test.igv");
+		Vector mapped = Vector::view(content);
+		assert(mapped == saved);
+		
+		BasicVector<long> longs = BasicVector<long>("-7 0 123456789");
+		longs.save("vector_test.igv");
+		assert(BasicVector<long>::load("vector_test.igv") == longs);
+		bool rejected = false;
+		try {
+			Vector::load("vector_test.igv");
+		} catch (const igraph::Exception&) {
+			rejected = true;
+		}
+		assert(rejected);
+		remove("vector_test.igv");
+		
+		bool missing = false;
+		try {
+			MappedFile absent ("vector_test.igv");
+		} catch (const igraph::Exception&) {
+			missing = true;
+		}
+		assert(missing);
+	}
+	
+	{
+		// the output is larger than stdio's buffer, so the failed write is seen at once.
+		FILE* full = fopen("/dev/full", "w");
+		if (full != NULL) {
+			bool failed = false;
+			try {
+				Vector((long)200000).print(" ", full);
+			} catch (const igraph::Exception&) {
+				failed = true;
+			}
+			assert(failed);
+			failed = false;
+			try {
+				Vector((long)200000).save(full);
+			} catch (const igraph::Exception&) {
+				failed = true;
+			}
+			assert(failed);
+			fclose(full);
+		}
+	}
+	
 	printf("vector.hpp is correct.\n");
 
 	return 0;